@@ -14,8 +14,7 @@ PlayerbotAIBase::PlayerbotAIBase(bool isBotAI)
 
 void PlayerbotAIBase::UpdateAI(uint32 elapsed, bool minimal)
 {
-    if (totalPmo)
-        totalPmo->finish();
+    totalPmo.finish();
 
     totalPmo = sPerformanceMonitor->start(PERF_MON_TOTAL, "PlayerbotAIBase::FullTick");
 
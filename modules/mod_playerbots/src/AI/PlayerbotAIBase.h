@@ -7,6 +7,7 @@
 #define _PLAYERBOT_PLAYERBOTAIBASE_H
 
 #include "Define.h"
+#include "PerformanceMonitor.h"
 
 class PlayerbotAIBase
 {
@@ -24,10 +25,16 @@ public:
 
 protected:
     uint32 nextAICheckDelay;
-    class PerformanceMonitorOperation* totalPmo = nullptr;
+    PerformanceMonitorOperation totalPmo;
+    bool lastUpdateIdle = false; // the last AI update executed no action
 
 private:
+    friend class PlayerbotScheduler;
+
     bool _isBotAI;
+    uint32 _deferredUpdateDiff = 0; // time of updates deferred by the scheduler
+    uint64 _lastUpdateNs = 0;       // cost of the last budgeted update
+    uint32 _idleUpdates = 0;
 };
 
 #endif
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it
+ * and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#include "PlayerbotScheduler.h"
+
+#include "Map.h"
+#include "PlayerbotAI.h"
+#include "PlayerbotAIConfig.h"
+#include "Playerbots.h"
+#include "World.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+
+// a map not updated for this many world ticks lost its bots or was unloaded
+static uint32 const MapStatsExpireTicks = 6000;
+static uint32 const MapStatsPruneInterval = 60 * IN_MILLISECONDS;
+
+void PlayerbotScheduler::UpdateBot(PlayerbotAI* botAI, Player* bot, uint32 diff)
+{
+    uint32 elapsed = diff + botAI->_deferredUpdateDiff;
+
+    // bots that only count down their delay cost nothing worth budgeting
+    if (!sPlayerbotAIConfig->mapUpdateBudget || botAI->nextAICheckDelay > elapsed)
+    {
+        botAI->_deferredUpdateDiff = 0;
+        botAI->UpdateAI(elapsed);
+        return;
+    }
+
+    PlayerbotMapStats& stats = GetMapStats(bot->GetMap());
+    uint32 tick = World::m_worldLoopCounter;
+    if (stats.tick != tick)
+    {
+        if (stats.tickNs > stats.maxTickNs.load(std::memory_order_relaxed))
+            stats.maxTickNs.store(stats.tickNs, std::memory_order_relaxed);
+
+        stats.tick = tick;
+        stats.tickNs = 0;
+        stats.reservedNs = stats.deferredNs;
+        stats.deferredNs = 0;
+    }
+
+    // bots are visited in the same order every tick, without a reservation the ones in front would always
+    // spend the budget and the same bots at the back would wait every time
+    bool waiting = botAI->_deferredUpdateDiff != 0;
+    if (waiting)
+        stats.reservedNs -= std::min(stats.reservedNs, botAI->_lastUpdateNs);
+
+    uint64 budgetNs = uint64(sPlayerbotAIConfig->mapUpdateBudget) * 1000;
+    uint64 limitNs = waiting ? budgetNs : budgetNs - std::min(budgetNs, stats.reservedNs);
+    if (stats.tickNs >= limitNs && botAI->_deferredUpdateDiff < sPlayerbotAIConfig->maxDeferredUpdate)
+    {
+        botAI->_deferredUpdateDiff = elapsed;
+        stats.deferredNs += botAI->_lastUpdateNs;
+        stats.deferred.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    botAI->_deferredUpdateDiff = 0;
+    botAI->lastUpdateIdle = false;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    botAI->UpdateAI(elapsed);
+    uint64 elapsedNs = uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+    botAI->_lastUpdateNs = elapsedNs;
+    stats.tickNs += elapsedNs;
+    stats.totalNs.fetch_add(elapsedNs, std::memory_order_relaxed);
+    stats.updates.fetch_add(1, std::memory_order_relaxed);
+
+    // a bot attacked while it waits out the delay only reacts once the delay is over, up to MaxIdleUpdateDelay later
+    if (botAI->lastUpdateIdle && sPlayerbotAIConfig->idleUpdateDelay && !bot->IsInCombat() && !botAI->HasRealPlayerMaster())
+    {
+        botAI->_idleUpdates = std::min(botAI->_idleUpdates + 1, sPlayerbotAIConfig->maxIdleUpdateDelay / sPlayerbotAIConfig->idleUpdateDelay + 1);
+        botAI->YieldThread(std::min(botAI->_idleUpdates * sPlayerbotAIConfig->idleUpdateDelay, sPlayerbotAIConfig->maxIdleUpdateDelay));
+        stats.idleDelayed.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+        botAI->_idleUpdates = 0;
+}
+
+PlayerbotMapStats& PlayerbotScheduler::GetMapStats(Map* map)
+{
+    uint64 key = (uint64(map->GetId()) << 32) | map->GetInstanceId();
+
+    {
+        std::shared_lock<std::shared_mutex> lock(_lock);
+        auto itr = _maps.find(key);
+        if (itr != _maps.end())
+            return *itr->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(_lock);
+    std::unique_ptr<PlayerbotMapStats>& stats = _maps[key];
+    if (!stats)
+    {
+        stats = std::make_unique<PlayerbotMapStats>();
+        stats->mapId = map->GetId();
+        stats->instanceId = map->GetInstanceId();
+        stats->tick = World::m_worldLoopCounter;
+    }
+
+    return *stats;
+}
+
+void PlayerbotScheduler::Update(uint32 diff)
+{
+    _pruneTimer += diff;
+    if (_pruneTimer < MapStatsPruneInterval)
+        return;
+
+    _pruneTimer = 0;
+
+    // maps are not updated while the world thread runs
+    uint32 tick = World::m_worldLoopCounter;
+    std::unique_lock<std::shared_mutex> lock(_lock);
+    for (auto itr = _maps.begin(); itr != _maps.end();)
+    {
+        if (tick - itr->second->tick > MapStatsExpireTicks)
+            itr = _maps.erase(itr);
+        else
+            ++itr;
+    }
+}
+
+std::vector<PlayerbotMapUsage> PlayerbotScheduler::GetMapUsage() const
+{
+    std::vector<PlayerbotMapUsage> usage;
+
+    std::shared_lock<std::shared_mutex> lock(_lock);
+    usage.reserve(_maps.size());
+    for (auto const& itr : _maps)
+    {
+        PlayerbotMapStats const& stats = *itr.second;
+        usage.push_back({stats.mapId, stats.instanceId, stats.totalNs.load(std::memory_order_relaxed),
+                         stats.maxTickNs.load(std::memory_order_relaxed), stats.updates.load(std::memory_order_relaxed),
+                         stats.deferred.load(std::memory_order_relaxed), stats.idleDelayed.load(std::memory_order_relaxed)});
+    }
+
+    std::sort(usage.begin(), usage.end(),
+              [](PlayerbotMapUsage const& left, PlayerbotMapUsage const& right) { return left.totalNs > right.totalNs; });
+
+    return usage;
+}
+
+void PlayerbotScheduler::Reset()
+{
+    std::shared_lock<std::shared_mutex> lock(_lock);
+    for (auto const& itr : _maps)
+    {
+        itr.second->totalNs = 0;
+        itr.second->maxTickNs = 0;
+        itr.second->updates = 0;
+        itr.second->deferred = 0;
+        itr.second->idleDelayed = 0;
+    }
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU GPL v2 license, you may redistribute it
+ * and/or modify it under version 2 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_PLAYERBOTSCHEDULER_H
+#define _PLAYERBOT_PLAYERBOTSCHEDULER_H
+
+#include "Define.h"
+
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+class Map;
+class Player;
+class PlayerbotAI;
+
+struct PlayerbotMapStats
+{
+    uint32 mapId = 0;
+    uint32 instanceId = 0;
+
+    // owned by the thread updating the map
+    uint32 tick = 0;
+    uint64 tickNs = 0;
+    uint64 reservedNs = 0;  // budget held back this tick for the bots deferred by the last one
+    uint64 deferredNs = 0;  // estimated cost of the bots deferred this tick
+
+    std::atomic<uint64> totalNs{0};
+    std::atomic<uint64> maxTickNs{0};
+    std::atomic<uint64> updates{0};
+    std::atomic<uint64> deferred{0};
+    std::atomic<uint64> idleDelayed{0};
+};
+
+struct PlayerbotMapUsage
+{
+    uint32 mapId;
+    uint32 instanceId;
+    uint64 totalNs;
+    uint64 maxTickNs;
+    uint64 updates;
+    uint64 deferred;
+    uint64 idleDelayed;
+};
+
+// Bounds the bot AI time of every map update, bots over the budget of their map wait for a later update
+// of the map, at most AiPlayerbot.MaxDeferredUpdate ms. Deferred bots go first in the next update, so the
+// budget rotates over the bots of a map. Unattended bots that find nothing to do back off.
+class PlayerbotScheduler
+{
+public:
+    static PlayerbotScheduler* instance()
+    {
+        static PlayerbotScheduler instance;
+        return &instance;
+    }
+
+    // called from the player update of the bot, on the thread of its map
+    void UpdateBot(PlayerbotAI* botAI, Player* bot, uint32 diff);
+    // world thread, drops the stats of maps that are no longer updated
+    void Update(uint32 diff);
+
+    std::vector<PlayerbotMapUsage> GetMapUsage() const;
+    void Reset();
+
+private:
+    PlayerbotScheduler() : _pruneTimer(0) {}
+
+    PlayerbotMapStats& GetMapStats(Map* map);
+
+    mutable std::shared_mutex _lock;
+    std::unordered_map<uint64, std::unique_ptr<PlayerbotMapStats>> _maps;
+    uint32 _pruneTimer;
+};
+
+#define sPlayerbotScheduler PlayerbotScheduler::instance()
+
+#endif
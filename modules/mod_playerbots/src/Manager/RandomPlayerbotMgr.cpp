@@ -85,8 +85,7 @@ void RandomPlayerbotMgr::ScheduleTeleport(uint32 bot, uint32 time)
 
 void RandomPlayerbotMgr::UpdateAIInternal(uint32 elapsed, bool /*minimal*/)
 {
-    if (totalPmo)
-        totalPmo->finish();
+    totalPmo.finish();
 
     totalPmo = sPerformanceMonitor->start(PERF_MON_TOTAL, "RandomPlayerbotMgr::FullTick");
 
@@ -122,7 +121,7 @@ void RandomPlayerbotMgr::UpdateAIInternal(uint32 elapsed, bool /*minimal*/)
     uint32 updateIntervalTurboBoost = _isBotInitializing ? 1 : sPlayerbotAIConfig->randomBotUpdateInterval;
     SetNextCheckDelay(updateIntervalTurboBoost * (onlineBotFocus + 25) * 10);
 
-    PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(
+    PerformanceMonitorOperation pmo = sPerformanceMonitor->start(
             PERF_MON_TOTAL,
             onlineBotCount < maxAllowedBotCount ? "RandomPlayerbotMgr::Login" : "RandomPlayerbotMgr::UpdateAIInternal");
 
@@ -176,8 +175,7 @@ void RandomPlayerbotMgr::UpdateAIInternal(uint32 elapsed, bool /*minimal*/)
         }
     }
 
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 }
 
 uint32 RandomPlayerbotMgr::AddRandomBots()
@@ -449,25 +447,23 @@ bool RandomPlayerbotMgr::ProcessBot(Player* player)
         uint32 randomize = GetEventValue(bot, "randomize");
         if (!randomize)
         {
-            PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "Randomize");
+            PerformanceMonitorOperation pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "Randomize");
             Randomize(player);
             TC_LOG_DEBUG("playerbots", "Bot #%u %s:%u <%s>: randomized", bot.GetCounter(), player->GetTeamId() == TEAM_ALLIANCE ? "A" : "H", player->GetLevel(), player->GetName().c_str());
-            if (pmo)
-                pmo->finish();
+            pmo.finish();
             return true;
         }
 
         uint32 teleport = GetEventValue(bot, "teleport");
         if (!teleport)
         {
-            PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "RandomTeleportByLocations");
+            PerformanceMonitorOperation pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "RandomTeleportByLocations");
             TC_LOG_DEBUG("playerbots", "Bot #%u <%s>: teleport for level and refresh", bot.GetCounter(), player->GetName().c_str());
             Refresh(player);
             RandomTeleportForLevel(player);
             uint32 time = urand(sPlayerbotAIConfig->minRandomBotTeleportInterval, sPlayerbotAIConfig->maxRandomBotTeleportInterval);
             ScheduleTeleport(bot, time);
-            if (pmo)
-                pmo->finish();
+            pmo.finish();
             return true;
         }
     }
@@ -599,7 +595,7 @@ void RandomPlayerbotMgr::Refresh(Player* bot)
         return;
 
     TC_LOG_INFO("playerbots", "Refreshing bot #%u <%s>", bot->GetGUID().GetCounter(), bot->GetName().c_str());
-    PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "Refresh");
+    PerformanceMonitorOperation pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "Refresh");
 
     botAI->Reset();
     bot->DurabilityRepairAll(false, 1.0f, false);
@@ -620,8 +616,7 @@ void RandomPlayerbotMgr::Refresh(Player* bot)
     //if (bot->GetGroup())
         //bot->RemoveFromGroup();
 
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 }
 
 bool RandomPlayerbotMgr::IsRandomBot(Player* bot)
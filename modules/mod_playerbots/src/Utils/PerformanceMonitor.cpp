@@ -1,298 +1,570 @@
 #include "PerformanceMonitor.h"
 
+#include <fstream>
+
 #include "Playerbots.h"
 
-PerformanceMonitorOperation* PerformanceMonitor::start(PerformanceMetric metric, std::string const name,
-                                                       PerformanceStack* stack)
+// node ids of a thread are counted in chunks allocated on first use, a thread never sees more than
+// PerfMonChunkSize * PerfMonMaxChunks distinct operations
+static uint32 const PerfMonChunkSize = 256;
+static uint32 const PerfMonMaxChunks = 1024;
+// bounds the memory of a trace
+static size_t const PerfMonMaxTraceEventsPerThread = 1000000;
+
+struct PerformanceMonitor::ThreadData
 {
-    if (!sPlayerbotAIConfig->perfMonEnabled)
-        return nullptr;
+    struct NameHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view name) const { return std::hash<std::string_view>()(name); }
+    };
 
-    std::string stackName = name;
+    std::array<std::atomic<Counters*>, PerfMonMaxChunks> chunks = {};
 
-    if (stack)
+    // only used by the owning thread
+    std::unordered_map<std::string, uint32, NameHash, std::equal_to<>> nameCache;
+    std::unordered_map<uint64, uint32> nodeCache;
+
+    std::mutex traceLock;
+    std::vector<TraceEvent> trace;
+
+    ~ThreadData()
     {
-        if (!stack->empty())
+        for (std::atomic<Counters*>& chunk : chunks)
+            delete[] chunk.load();
+    }
+
+    Counters* GetCounters(uint32 node)
+    {
+        uint32 chunkIndex = node / PerfMonChunkSize;
+        if (chunkIndex >= PerfMonMaxChunks)
+            return nullptr;
+
+        Counters* chunk = chunks[chunkIndex].load(std::memory_order_relaxed);
+        if (!chunk)
         {
-            std::ostringstream out;
-            out << stackName << " [";
+            chunk = new Counters[PerfMonChunkSize];
+            chunks[chunkIndex].store(chunk, std::memory_order_release);
+        }
 
-            for (std::vector<std::string>::reverse_iterator i = stack->rbegin(); i != stack->rend(); ++i)
-                out << *i << (std::next(i) == stack->rend() ? "" : "|");
+        return &chunk[node % PerfMonChunkSize];
+    }
+};
 
-            out << "]";
+void PerformanceData::Add(PerformanceData const& other)
+{
+    if (!other.count)
+        return;
 
-            stackName = out.str().c_str();
-        }
+    if (!minTime || (other.minTime && other.minTime < minTime))
+        minTime = other.minTime;
 
-        stack->push_back(name);
+    maxTime = std::max(maxTime, other.maxTime);
+    totalTime += other.totalTime;
+    count += other.count;
+    for (uint32 i = 0; i < PERF_MON_HISTOGRAM_BUCKETS; ++i)
+        histogram[i] += other.histogram[i];
+}
+
+uint64 PerformanceData::GetPercentile(float fraction) const
+{
+    uint64 target = uint64(count * fraction);
+    uint64 seen = 0;
+    for (uint32 i = 0; i < PERF_MON_HISTOGRAM_BUCKETS; ++i)
+    {
+        seen += histogram[i];
+        if (seen > target)
+            return uint64(1) << i;
     }
 
-    std::lock_guard<std::mutex> guard(lock);
-    PerformanceData* pd = data[metric][stackName];
-    if (!pd)
+    return maxTime;
+}
+
+PerformanceMonitor::PerformanceMonitor() : tracing(false), traceEndNs(0) {}
+
+PerformanceMonitor::~PerformanceMonitor() {}
+
+bool PerformanceMonitor::IsEnabled() const { return sPlayerbotAIConfig->perfMonEnabled; }
+
+PerformanceMonitor::ThreadData* PerformanceMonitor::GetThreadData() { return &threads.Local(); }
+
+uint32 PerformanceMonitor::GetNameId(ThreadData* data, std::string_view name)
+{
+    auto itr = data->nameCache.find(name);
+    if (itr != data->nameCache.end())
+        return itr->second;
+
+    uint32 id;
     {
-        pd = new PerformanceData();
-        pd->minTime = 0;
-        pd->maxTime = 0;
-        pd->totalTime = 0;
-        pd->count = 0;
-        data[metric][stackName] = pd;
+        std::unique_lock<std::shared_mutex> guard(nodesLock);
+        auto nameItr = nameIds.find(std::string(name));
+        if (nameItr != nameIds.end())
+            id = nameItr->second;
+        else
+        {
+            id = uint32(names.size());
+            names.emplace_back(name);
+            nameIds.emplace(names.back(), id);
+        }
     }
 
-    return new PerformanceMonitorOperation(pd, name, stack);
+    data->nameCache.emplace(std::string(name), id);
+    return id;
 }
 
-void PerformanceMonitor::PrintStats(bool perTick, bool fullStack)
+uint32 PerformanceMonitor::GetNode(PerformanceMetric metric, uint32 parent, std::string_view name)
 {
-    if (data.empty())
+    ThreadData* data = GetThreadData();
+    uint32 nameId = GetNameId(data, name);
+    uint64 key = (uint64(parent) << 32) | (uint64(nameId) << 3) | uint32(metric);
+
+    auto itr = data->nodeCache.find(key);
+    if (itr != data->nodeCache.end())
+        return itr->second;
+
+    uint32 node;
+    {
+        std::unique_lock<std::shared_mutex> guard(nodesLock);
+        auto nodeItr = nodeIds.find(key);
+        if (nodeItr != nodeIds.end())
+            node = nodeItr->second;
+        else
+        {
+            nodes.push_back({metric, parent, nameId});
+            node = uint32(nodes.size());
+            nodeIds.emplace(key, node);
+        }
+    }
+
+    data->nodeCache.emplace(key, node);
+    return node;
+}
+
+PerformanceMonitorOperation PerformanceMonitor::start(PerformanceMetric metric, std::string_view name,
+                                                      PerformanceStack* stack)
+{
+    if (!IsEnabled())
+        return PerformanceMonitorOperation();
+
+    uint32 parent = stack && !stack->empty() ? stack->back() : 0;
+    uint32 node = GetNode(metric, parent, name);
+    if (stack)
+        stack->push_back(node);
+
+    return PerformanceMonitorOperation(node, stack);
+}
+
+void PerformanceMonitor::Record(uint32 node, std::chrono::steady_clock::time_point started,
+                                std::chrono::steady_clock::time_point finished)
+{
+    ThreadData* data = GetThreadData();
+    Counters* counters = data->GetCounters(node);
+    if (!counters)
         return;
 
-    if (!perTick)
+    int64 elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(finished - started).count();
+    uint64 elapsed = uint64(elapsedNs / 1000);
+
+    // the owning thread is the only writer, loads and stores need no read-modify-write
+    uint64 minTime = counters->minTime.load(std::memory_order_relaxed);
+    if (elapsed && (!minTime || minTime > elapsed))
+        counters->minTime.store(elapsed, std::memory_order_relaxed);
+
+    if (counters->maxTime.load(std::memory_order_relaxed) < elapsed)
+        counters->maxTime.store(elapsed, std::memory_order_relaxed);
+
+    counters->totalTime.store(counters->totalTime.load(std::memory_order_relaxed) + elapsed, std::memory_order_relaxed);
+    counters->count.store(counters->count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    uint32 bucket = 0;
+    while (bucket + 1 < PERF_MON_HISTOGRAM_BUCKETS && (uint64(1) << bucket) <= elapsed)
+        ++bucket;
+
+    std::atomic<uint64>& histogram = counters->histogram[bucket];
+    histogram.store(histogram.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    if (tracing.load(std::memory_order_relaxed))
     {
-        float updateAITotalTime = 0;
-        for (auto& map : data[PERF_MON_TOTAL])
-            if (map.first.find("PlayerbotAI::UpdateAIInternal") != std::string::npos)
-                updateAITotalTime += map.second->totalTime;
-
-        TC_LOG_INFO(
-            "playerbots",
-            "--------------------------------------[TOTAL BOT]------------------------------------------------------");
-        TC_LOG_INFO("playerbots",
-                 "percentage     time  |     min ..     max (      avg  of      count) - type      : name");
-        TC_LOG_INFO(
-            "playerbots",
-            "-------------------------------------------------------------------------------------------------------");
-
-        for (std::map<PerformanceMetric, std::map<std::string, PerformanceData*>>::iterator i = data.begin();
-             i != data.end(); ++i)
+        int64 startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(started.time_since_epoch()).count();
+        if (startNs < traceEndNs.load(std::memory_order_relaxed))
         {
-            std::map<std::string, PerformanceData*> pdMap = i->second;
+            std::lock_guard<std::mutex> guard(data->traceLock);
+            if (data->trace.size() < PerfMonMaxTraceEventsPerThread)
+                data->trace.push_back({node, startNs, elapsedNs});
+        }
+    }
+}
 
-            std::string key;
-            switch (i->first)
-            {
-                case PERF_MON_TRIGGER:
-                    key = "Trigger";
-                    break;
-                case PERF_MON_VALUE:
-                    key = "Value";
-                    break;
-                case PERF_MON_ACTION:
-                    key = "Action";
-                    break;
-                case PERF_MON_RNDBOT:
-                    key = "RndBot";
-                    break;
-                case PERF_MON_TOTAL:
-                    key = "Total";
-                    break;
-                default:
-                    key = "?";
-                    break;
-            }
+std::map<uint32, PerformanceData> PerformanceMonitor::Collect()
+{
+    std::map<uint32, PerformanceData> result;
 
-            std::vector<std::string> names;
+    threads.ForEach([&result](ThreadData& data, uint32 /*index*/)
+    {
+        for (uint32 chunkIndex = 0; chunkIndex < PerfMonMaxChunks; ++chunkIndex)
+        {
+            Counters* chunk = data.chunks[chunkIndex].load(std::memory_order_acquire);
+            if (!chunk)
+                continue;
 
-            for (std::map<std::string, PerformanceData*>::iterator j = pdMap.begin(); j != pdMap.end(); ++j)
+            for (uint32 i = 0; i < PerfMonChunkSize; ++i)
             {
-                if (key == "Total" && j->first.find("PlayerbotAI::UpdateAIInternal") == std::string::npos)
+                Counters const& counters = chunk[i];
+                PerformanceData pd;
+                pd.count = counters.count.load(std::memory_order_relaxed);
+                if (!pd.count)
                     continue;
 
-                names.push_back(j->first);
+                pd.minTime = counters.minTime.load(std::memory_order_relaxed);
+                pd.maxTime = counters.maxTime.load(std::memory_order_relaxed);
+                pd.totalTime = counters.totalTime.load(std::memory_order_relaxed);
+                for (uint32 bucket = 0; bucket < PERF_MON_HISTOGRAM_BUCKETS; ++bucket)
+                    pd.histogram[bucket] = counters.histogram[bucket].load(std::memory_order_relaxed);
+
+                result[chunkIndex * PerfMonChunkSize + i].Add(pd);
             }
+        }
+    });
+
+    return result;
+}
+
+std::string PerformanceMonitor::GetNodeName(uint32 node, bool fullStack)
+{
+    std::shared_lock<std::shared_mutex> guard(nodesLock);
+    Node const* current = &nodes[node - 1];
+    std::string name = names[current->name];
+    if (!current->parent)
+        return name;
+
+    // innermost caller first, as the stacks were printed before
+    name += " [";
+    while (current->parent)
+    {
+        current = &nodes[current->parent - 1];
+        name += names[current->name];
+        if (!fullStack || !current->parent)
+            break;
+
+        name += "|";
+    }
+
+    name += "]";
+    return name;
+}
+
+static char const* GetMetricName(PerformanceMetric metric)
+{
+    switch (metric)
+    {
+        case PERF_MON_TRIGGER:
+            return "Trigger";
+        case PERF_MON_VALUE:
+            return "Value";
+        case PERF_MON_ACTION:
+            return "Action";
+        case PERF_MON_RNDBOT:
+            return "RndBot";
+        case PERF_MON_TOTAL:
+            return "Total";
+        default:
+            return "?";
+    }
+}
+
+void PerformanceMonitor::PrintStats(bool perTick, bool fullStack)
+{
+    std::map<uint32, PerformanceData> data = Collect();
+    if (data.empty())
+        return;
+
+    struct Entry
+    {
+        std::string name;
+        PerformanceData const* pd;
+    };
+
+    std::map<PerformanceMetric, std::vector<Entry>> metrics;
+    float totalTime = 0;
+    float fullTickCount = 0;
+    for (auto const& itr : data)
+    {
+        PerformanceMetric metric;
+        {
+            std::shared_lock<std::shared_mutex> guard(nodesLock);
+            metric = nodes[itr.first - 1].metric;
+        }
 
-            std::sort(names.begin(), names.end(),
-                      [pdMap](std::string const i, std::string const j)
-                      { return pdMap.at(i)->totalTime < pdMap.at(j)->totalTime; });
+        std::string name = GetNodeName(itr.first, fullStack);
+        if (metric == PERF_MON_TOTAL)
+        {
+            if (!perTick && name.find("PlayerbotAI::UpdateAIInternal") != std::string::npos)
+                totalTime += itr.second.totalTime;
 
-            uint64 typeTotalTime = 0;
-            uint64 typeMinTime = 0xffffffffu;
-            uint64 typeMaxTime = 0;
-            uint32 typeCount = 0;
-            for (auto& name : names)
+            if (perTick && name == "PlayerbotAIBase::FullTick")
             {
-                PerformanceData* pd = pdMap[name];
-                typeTotalTime += pd->totalTime;
-                typeCount += pd->count;
-                if (typeMinTime > pd->minTime)
-                    typeMinTime = pd->minTime;
-                if (typeMaxTime < pd->maxTime)
-                    typeMaxTime = pd->maxTime;
-                float perc = (float)pd->totalTime / updateAITotalTime * 100.0f;
-                float time = (float)pd->totalTime / 1000000.0f;
-                float minTime = (float)pd->minTime / 1000.0f;
-                float maxTime = (float)pd->maxTime / 1000.0f;
-                float avg = (float)pd->totalTime / (float)pd->count / 1000.0f;
-                std::string disName = name;
-                if (!fullStack && disName.find("|") != std::string::npos)
-                    disName = disName.substr(0, disName.find("|")) + "]";
-
-                if (perc >= 0.1f || avg >= 0.25f || pd->maxTime > 1000)
-                {
-                    TC_LOG_INFO("playerbots",
-                                "%7.3f%% %10.3fs | %7.1f .. %7.1f (%10.3f of %10d) - %-6s : %s", perc, time,
-                             minTime, maxTime, avg, pd->count, key.c_str(), disName.c_str());
-                }
+                totalTime = itr.second.totalTime;
+                fullTickCount = itr.second.count;
             }
-            float tPerc = (float)typeTotalTime / (float)updateAITotalTime * 100.0f;
-            float tTime = (float)typeTotalTime / 1000000.0f;
-            float tMinTime = (float)typeMinTime / 1000.0f;
-            float tMaxTime = (float)typeMaxTime / 1000.0f;
-            float tAvg = (float)typeTotalTime / (float)typeCount / 1000.0f;
-            TC_LOG_INFO("playerbots", "%7.3f%% %10.3fs | %7.1f .. %7.1f (%10.3f of %10d) - %-6s : %s", tPerc,
-                     tTime, tMinTime, tMaxTime, tAvg, typeCount, key.c_str(), "Total");
-            TC_LOG_INFO("playerbots", " ");
+
+            if (!perTick && name.find("PlayerbotAI::UpdateAIInternal") == std::string::npos)
+                continue;
         }
+
+        metrics[metric].push_back({name, &itr.second});
     }
-    else
+
+    if (perTick && !fullTickCount)
+        return;
+
+    TC_LOG_INFO("playerbots", perTick ?
+        "---------------------------------------[PER TICK]---------------------------------------------------------------------" :
+        "--------------------------------------[TOTAL BOT]---------------------------------------------------------------------");
+    TC_LOG_INFO("playerbots",
+        "percentage     time  |     min ..     max (      avg  of      count) |   p50 ..    p99 - type      : name");
+    TC_LOG_INFO("playerbots",
+        "----------------------------------------------------------------------------------------------------------------------");
+
+    for (auto& itr : metrics)
     {
-        float fullTickCount = data[PERF_MON_TOTAL]["PlayerbotAIBase::FullTick"]->count;
-        float fullTickTotalTime = data[PERF_MON_TOTAL]["PlayerbotAIBase::FullTick"]->totalTime;
-
-        TC_LOG_INFO(
-            "playerbots",
-            "---------------------------------------[PER TICK]------------------------------------------------------");
-        TC_LOG_INFO("playerbots",
-                 "percentage     time  |     min ..     max (      avg  of      count) - type      : name");
-        TC_LOG_INFO(
-            "playerbots",
-            "-------------------------------------------------------------------------------------------------------");
-
-        for (std::map<PerformanceMetric, std::map<std::string, PerformanceData*>>::iterator i = data.begin();
-             i != data.end(); ++i)
+        char const* key = GetMetricName(itr.first);
+        std::vector<Entry>& entries = itr.second;
+        std::sort(entries.begin(), entries.end(),
+                  [](Entry const& left, Entry const& right) { return left.pd->totalTime < right.pd->totalTime; });
+
+        PerformanceData typeData;
+        for (Entry const& entry : entries)
         {
-            std::map<std::string, PerformanceData*> pdMap = i->second;
+            PerformanceData const* pd = entry.pd;
+            typeData.Add(*pd);
+
+            float perc = (float)pd->totalTime / totalTime * 100.0f;
+            float minTime = (float)pd->minTime / 1000.0f;
+            float maxTime = (float)pd->maxTime / 1000.0f;
+            float avg = (float)pd->totalTime / (float)pd->count / 1000.0f;
+            float p50 = (float)pd->GetPercentile(0.5f) / 1000.0f;
+            float p99 = (float)pd->GetPercentile(0.99f) / 1000.0f;
+
+            if (perc < 0.1f && avg < 0.25f && pd->maxTime <= 1000)
+                continue;
+
+            if (perTick)
+                TC_LOG_INFO("playerbots", "%7.3f%% %9.3fms | %7.1f .. %7.1f (%10.3f of %10.2f) | %5.1f .. %6.1f - %-6s : %s",
+                            perc, (float)pd->totalTime / fullTickCount / 1000.0f, minTime, maxTime, avg,
+                            (float)pd->count / fullTickCount, p50, p99, key, entry.name.c_str());
+            else
+                TC_LOG_INFO("playerbots", "%7.3f%% %10.3fs | %7.1f .. %7.1f (%10.3f of %10u) | %5.1f .. %6.1f - %-6s : %s",
+                            perc, (float)pd->totalTime / 1000000.0f, minTime, maxTime, avg, uint32(pd->count), p50, p99,
+                            key, entry.name.c_str());
+        }
 
-            std::string key;
-            switch (i->first)
-            {
-                case PERF_MON_TRIGGER:
-                    key = "Trigger";
-                    break;
-                case PERF_MON_VALUE:
-                    key = "Value";
-                    break;
-                case PERF_MON_ACTION:
-                    key = "Action";
-                    break;
-                case PERF_MON_RNDBOT:
-                    key = "RndBot";
-                    break;
-                case PERF_MON_TOTAL:
-                    key = "Total";
-                    break;
-                default:
-                    key = "?";
-            }
+        if (!perTick || itr.first != PERF_MON_TOTAL)
+        {
+            float tPerc = (float)typeData.totalTime / totalTime * 100.0f;
+            float tMinTime = (float)typeData.minTime / 1000.0f;
+            float tMaxTime = (float)typeData.maxTime / 1000.0f;
+            float tAvg = (float)typeData.totalTime / (float)typeData.count / 1000.0f;
+            float tP50 = (float)typeData.GetPercentile(0.5f) / 1000.0f;
+            float tP99 = (float)typeData.GetPercentile(0.99f) / 1000.0f;
+
+            if (perTick)
+                TC_LOG_INFO("playerbots", "%7.3f%% %9.3fms | %7.1f .. %7.1f (%10.3f of %10.2f) | %5.1f .. %6.1f - %-6s : %s",
+                            tPerc, (float)typeData.totalTime / fullTickCount / 1000.0f, tMinTime, tMaxTime, tAvg,
+                            (float)typeData.count / fullTickCount, tP50, tP99, key, "Total");
+            else
+                TC_LOG_INFO("playerbots", "%7.3f%% %10.3fs | %7.1f .. %7.1f (%10.3f of %10u) | %5.1f .. %6.1f - %-6s : %s",
+                            tPerc, (float)typeData.totalTime / 1000000.0f, tMinTime, tMaxTime, tAvg,
+                            uint32(typeData.count), tP50, tP99, key, "Total");
+        }
 
-            std::vector<std::string> names;
+        TC_LOG_INFO("playerbots", " ");
+    }
+}
 
-            for (std::map<std::string, PerformanceData*>::iterator j = pdMap.begin(); j != pdMap.end(); ++j)
-            {
-                names.push_back(j->first);
-            }
+void PerformanceMonitor::PrintHistogram(std::string const& filter)
+{
+    std::map<uint32, PerformanceData> data = Collect();
+    for (auto const& itr : data)
+    {
+        std::string name = GetNodeName(itr.first, true);
+        if (name.find(filter) == std::string::npos)
+            continue;
 
-            std::sort(names.begin(), names.end(),
-                      [pdMap](std::string const i, std::string const j)
-                      { return pdMap.at(i)->totalTime < pdMap.at(j)->totalTime; });
+        PerformanceData const& pd = itr.second;
+        TC_LOG_INFO("playerbots", "%s: %u calls, %.3f ms avg", name.c_str(), uint32(pd.count),
+                    (float)pd.totalTime / (float)pd.count / 1000.0f);
 
-            uint64 typeTotalTime = 0;
-            uint64 typeMinTime = 0xffffffffu;
-            uint64 typeMaxTime = 0;
-            uint32 typeCount = 0;
-            for (auto& name : names)
-            {
-                PerformanceData* pd = pdMap[name];
-                typeTotalTime += pd->totalTime;
-                typeCount += pd->count;
-                if (typeMinTime > pd->minTime)
-                    typeMinTime = pd->minTime;
-                if (typeMaxTime < pd->maxTime)
-                    typeMaxTime = pd->maxTime;
-                float perc = (float)pd->totalTime / fullTickTotalTime * 100.0f;
-                float time = (float)pd->totalTime / fullTickCount / 1000.0f;
-                float minTime = (float)pd->minTime / 1000.0f;
-                float maxTime = (float)pd->maxTime / 1000.0f;
-                float avg = (float)pd->totalTime / (float)pd->count / 1000.0f;
-                float amount = (float)pd->count / fullTickCount;
-                std::string disName = name;
-                if (!fullStack && disName.find("|") != std::string::npos)
-                    disName = disName.substr(0, disName.find("|")) + "]";
-                if (perc >= 0.1f || avg >= 0.25f || pd->maxTime > 1000)
-                {
-                    TC_LOG_INFO("playerbots",
-                                "%7.3f%% %9.3fms | %7.1f .. %7.1f (%10.3f of %10.2f) - %-6s : %s", perc,
-                             time, minTime, maxTime, avg, amount, key.c_str(), disName.c_str());
-                }
-            }
-            if (i->first != PERF_MON_TOTAL)
-            {
-                float tPerc = (float)typeTotalTime / (float)fullTickTotalTime * 100.0f;
-                float tTime = (float)typeTotalTime / fullTickCount / 1000.0f;
-                float tMinTime = (float)typeMinTime / 1000.0f;
-                float tMaxTime = (float)typeMaxTime / 1000.0f;
-                float tAvg = (float)typeTotalTime / (float)typeCount / 1000.0f;
-                float tAmount = (float)typeCount / fullTickCount;
-                TC_LOG_INFO("playerbots", "%7.3f%% %9.3fms | %7.1f .. %7.1f (%10.3f of %10.2f) - %-6s : %s",
-                         tPerc, tTime, tMinTime, tMaxTime, tAvg, tAmount, key.c_str(), "Total");
-            }
-            TC_LOG_INFO("playerbots", " ");
+        for (uint32 i = 0; i < PERF_MON_HISTOGRAM_BUCKETS; ++i)
+        {
+            if (!pd.histogram[i])
+                continue;
+
+            TC_LOG_INFO("playerbots", "  < %8u us %10u %6.2f%% %s", 1u << i, uint32(pd.histogram[i]),
+                        (float)pd.histogram[i] / (float)pd.count * 100.0f,
+                        std::string(std::min<uint64>(50, pd.histogram[i] * 50 / pd.count), '#').c_str());
         }
     }
 }
 
 void PerformanceMonitor::Reset()
 {
-    for (std::map<PerformanceMetric, std::map<std::string, PerformanceData*>>::iterator i = data.begin();
-         i != data.end(); ++i)
+    // a call finishing meanwhile may survive the reset, its thread writes without synchronization
+    threads.ForEach([](ThreadData& data, uint32 /*index*/)
     {
-        std::map<std::string, PerformanceData*> pdMap = i->second;
-        for (std::map<std::string, PerformanceData*>::iterator j = pdMap.begin(); j != pdMap.end(); ++j)
+        for (std::atomic<Counters*>& chunkPtr : data.chunks)
         {
-            PerformanceData* pd = j->second;
-            std::lock_guard<std::mutex> guard(pd->lock);
-            pd->minTime = 0;
-            pd->maxTime = 0;
-            pd->totalTime = 0;
-            pd->count = 0;
+            Counters* chunk = chunkPtr.load(std::memory_order_acquire);
+            if (!chunk)
+                continue;
+
+            for (uint32 i = 0; i < PerfMonChunkSize; ++i)
+            {
+                chunk[i].minTime.store(0, std::memory_order_relaxed);
+                chunk[i].maxTime.store(0, std::memory_order_relaxed);
+                chunk[i].totalTime.store(0, std::memory_order_relaxed);
+                chunk[i].count.store(0, std::memory_order_relaxed);
+                for (std::atomic<uint64>& bucket : chunk[i].histogram)
+                    bucket.store(0, std::memory_order_relaxed);
+            }
         }
-    }
+    });
 }
 
-PerformanceMonitorOperation::PerformanceMonitorOperation(PerformanceData* data, std::string const name,
-                                                         PerformanceStack* stack)
-    : data(data), name(name), stack(stack)
+bool PerformanceMonitor::StartTrace(uint32 seconds, std::string const& fileName)
 {
-    started = (std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now()))
-                  .time_since_epoch();
+    if (tracing)
+        return false;
+
+    if (traceWriter.valid() && traceWriter.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return false;
+
+    threads.ForEach([](ThreadData& data, uint32 /*index*/)
+    {
+        std::lock_guard<std::mutex> traceGuard(data.traceLock);
+        data.trace.clear();
+    });
+
+    traceFile = fileName;
+    traceEndNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     (std::chrono::steady_clock::now() + std::chrono::seconds(seconds)).time_since_epoch()).count();
+    tracing = true;
+    return true;
 }
 
-void PerformanceMonitorOperation::finish()
+void PerformanceMonitor::Update()
 {
-    std::chrono::microseconds finished =
-        (std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now()))
-            .time_since_epoch();
-    uint64 elapsed = (finished - started).count();
+    if (!tracing.load(std::memory_order_relaxed))
+        return;
+
+    if (std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count() <
+        traceEndNs)
+        return;
+
+    tracing = false;
+
+    // only the buffers are moved out on the world thread, the names are interned and safe to read from the writer
+    std::vector<ThreadTrace> traces;
+    threads.ForEach([&traces](ThreadData& data, uint32 index)
+    {
+        std::lock_guard<std::mutex> traceGuard(data.traceLock);
+        if (!data.trace.empty())
+            traces.push_back({index, std::move(data.trace)});
+        data.trace = std::vector<TraceEvent>();
+    });
+
+    traceWriter = std::async(std::launch::async, [this, fileName = traceFile, traces = std::move(traces)]()
+                             { WriteTrace(fileName, traces); });
+}
+
+void PerformanceMonitor::WriteTrace(std::string const& fileName, std::vector<ThreadTrace> const& traces)
+{
+    std::ofstream file(fileName);
+    if (!file)
+    {
+        TC_LOG_ERROR("playerbots", "PerformanceMonitor: can not open trace file %s", fileName.c_str());
+        return;
+    }
+
+    std::unordered_map<uint32, std::string> nodeNames;
+    uint64 events = 0;
+    bool first = true;
+    file << "{\"traceEvents\":[";
 
-    std::lock_guard<std::mutex> guard(data->lock);
-    if (elapsed > 0)
+    for (ThreadTrace const& trace : traces)
     {
-        if (!data->minTime || data->minTime > elapsed)
-            data->minTime = elapsed;
+        for (TraceEvent const& event : trace.events)
+        {
+            std::string& name = nodeNames[event.node];
+            if (name.empty())
+            {
+                for (char c : GetNodeName(event.node, false))
+                    if (c != '"' && c != '\\')
+                        name += c;
+            }
+
+            PerformanceMetric metric;
+            {
+                std::shared_lock<std::shared_mutex> nodesGuard(nodesLock);
+                metric = nodes[event.node - 1].metric;
+            }
+
+            if (!first)
+                file << ",";
+            first = false;
 
-        if (!data->maxTime || data->maxTime < elapsed)
-            data->maxTime = elapsed;
+            file << "\n{\"name\":\"" << name << "\",\"cat\":\"" << GetMetricName(metric) << "\",\"ph\":\"X\",\"ts\":"
+                 << event.startNs / 1000 << "." << event.startNs / 100 % 10 << ",\"dur\":" << event.durationNs / 1000 << "."
+                 << event.durationNs / 100 % 10 << ",\"pid\":1,\"tid\":" << trace.index << "}";
+            ++events;
+        }
+    }
+
+    file << "\n]}\n";
+
+    TC_LOG_INFO("playerbots", "PerformanceMonitor: wrote " UI64FMTD " trace events to %s", events, fileName.c_str());
+}
 
-        data->totalTime += elapsed;
+PerformanceMonitorOperation::PerformanceMonitorOperation(uint32 node, PerformanceStack* stack)
+    : node(node), stack(stack), started(std::chrono::steady_clock::now())
+{
+}
+
+PerformanceMonitorOperation& PerformanceMonitorOperation::operator=(PerformanceMonitorOperation&& other) noexcept
+{
+    if (this != &other)
+    {
+        Cancel();
+        node = other.node;
+        stack = other.stack;
+        started = other.started;
+        other.node = 0;
+        other.stack = nullptr;
     }
 
-    ++data->count;
+    return *this;
+}
+
+void PerformanceMonitorOperation::finish()
+{
+    if (!node)
+        return;
+
+    sPerformanceMonitor->Record(node, started, std::chrono::steady_clock::now());
+    Cancel();
+}
+
+void PerformanceMonitorOperation::Cancel()
+{
+    if (!node)
+        return;
 
     if (stack)
     {
-        stack->erase(std::remove(stack->begin(), stack->end(), name), stack->end());
+        PerformanceStack::reverse_iterator itr = std::find(stack->rbegin(), stack->rend(), node);
+        if (itr != stack->rend())
+            stack->erase(std::next(itr).base());
     }
 
-    delete this;
+    node = 0;
+    stack = nullptr;
 }
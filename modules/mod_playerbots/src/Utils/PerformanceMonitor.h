@@ -1,24 +1,24 @@
 #ifndef _PLAYERBOT_PERFORMANCEMONITOR_H
 #define _PLAYERBOT_PERFORMANCEMONITOR_H
 
+#include <array>
+#include <atomic>
 #include <chrono>
-#include <ctime>
+#include <deque>
+#include <future>
 #include <map>
 #include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "Common.h"
+#include "PerThreadRegistry.h"
 
-typedef std::vector<std::string> PerformanceStack;
-
-struct PerformanceData
-{
-    uint64 minTime;
-    uint64 maxTime;
-    uint64 totalTime;
-    uint32 count;
-    std::mutex lock;
-};
+// ids of the operations in progress, innermost last
+typedef std::vector<uint32> PerformanceStack;
 
 enum PerformanceMetric
 {
@@ -29,39 +29,128 @@ enum PerformanceMetric
     PERF_MON_TOTAL
 };
 
+// buckets of the duration histogram, bucket n holds durations below 2^n us
+#define PERF_MON_HISTOGRAM_BUCKETS 24
+
+struct PerformanceData
+{
+    uint64 minTime = 0;
+    uint64 maxTime = 0;
+    uint64 totalTime = 0;
+    uint64 count = 0;
+    std::array<uint64, PERF_MON_HISTOGRAM_BUCKETS> histogram = {};
+
+    void Add(PerformanceData const& other);
+    // upper bound in us of the bucket holding the given fraction of the calls
+    uint64 GetPercentile(float fraction) const;
+};
+
 class PerformanceMonitorOperation
 {
 public:
-    PerformanceMonitorOperation(PerformanceData* data, std::string const name, PerformanceStack* stack);
+    PerformanceMonitorOperation() : node(0), stack(nullptr) {}
+    PerformanceMonitorOperation(uint32 node, PerformanceStack* stack);
+    PerformanceMonitorOperation(PerformanceMonitorOperation&& other) noexcept : node(0), stack(nullptr) { *this = std::move(other); }
+    PerformanceMonitorOperation& operator=(PerformanceMonitorOperation&& other) noexcept;
+    // an operation that is not finished is not recorded
+    ~PerformanceMonitorOperation() { Cancel(); }
+
+    PerformanceMonitorOperation(PerformanceMonitorOperation const&) = delete;
+    PerformanceMonitorOperation& operator=(PerformanceMonitorOperation const&) = delete;
+
+    explicit operator bool() const { return node != 0; }
+
     void finish();
 
 private:
-    PerformanceData* data;
-    std::string const name;
+    void Cancel();
+
+    uint32 node;
     PerformanceStack* stack;
-    std::chrono::microseconds started;
+    std::chrono::steady_clock::time_point started;
 };
 
+// Times bot triggers, values and actions. Counters are per thread and only written by their thread, the names are
+// interned once so a measured call costs a hash lookup in a thread local cache and no allocation or lock.
 class PerformanceMonitor
 {
+    struct Node
+    {
+        PerformanceMetric metric;
+        uint32 parent;
+        uint32 name;
+    };
+
+    struct Counters
+    {
+        std::atomic<uint64> minTime{0};
+        std::atomic<uint64> maxTime{0};
+        std::atomic<uint64> totalTime{0};
+        std::atomic<uint64> count{0};
+        std::array<std::atomic<uint64>, PERF_MON_HISTOGRAM_BUCKETS> histogram = {};
+    };
+
+    struct TraceEvent
+    {
+        uint32 node;
+        int64 startNs;
+        int64 durationNs;
+    };
+
+    struct ThreadData;
+
+    struct ThreadTrace
+    {
+        uint32 index;
+        std::vector<TraceEvent> events;
+    };
+
 public:
-    PerformanceMonitor(){};
-    virtual ~PerformanceMonitor(){};
     static PerformanceMonitor* instance()
     {
         static PerformanceMonitor instance;
         return &instance;
     }
 
-public:
-    PerformanceMonitorOperation* start(PerformanceMetric metric, std::string const name,
-                                       PerformanceStack* stack = nullptr);
+    bool IsEnabled() const;
+
+    PerformanceMonitorOperation start(PerformanceMetric metric, std::string_view name, PerformanceStack* stack = nullptr);
     void PrintStats(bool perTick = false, bool fullStack = false);
+    // bucket counts of the operations whose name contains the filter
+    void PrintHistogram(std::string const& filter);
     void Reset();
 
+    // records every finished operation for the given time, once it ended Update hands the events to a task writing the
+    // chrome trace file. Fails while a trace is recorded or still being written
+    bool StartTrace(uint32 seconds, std::string const& fileName);
+    void Update();
+
 private:
-    std::map<PerformanceMetric, std::map<std::string, PerformanceData*> > data;
-    std::mutex lock;
+    friend class PerformanceMonitorOperation;
+
+    PerformanceMonitor();
+    ~PerformanceMonitor();
+
+    ThreadData* GetThreadData();
+    uint32 GetNameId(ThreadData* data, std::string_view name);
+    uint32 GetNode(PerformanceMetric metric, uint32 parent, std::string_view name);
+    void Record(uint32 node, std::chrono::steady_clock::time_point started, std::chrono::steady_clock::time_point finished);
+    std::map<uint32, PerformanceData> Collect();
+    std::string GetNodeName(uint32 node, bool fullStack);
+    void WriteTrace(std::string const& fileName, std::vector<ThreadTrace> const& traces);
+
+    std::shared_mutex nodesLock;
+    std::deque<std::string> names;
+    std::unordered_map<std::string, uint32> nameIds;
+    std::deque<Node> nodes;  // by id - 1
+    std::unordered_map<uint64, uint32> nodeIds;
+
+    Trinity::PerThreadRegistry<ThreadData> threads;
+
+    std::atomic<bool> tracing;
+    std::atomic<int64> traceEndNs;
+    std::string traceFile;
+    std::future<void> traceWriter;  // destroyed first, the writer still reads the node names
 };
 
 #define sPerformanceMonitor PerformanceMonitor::instance()
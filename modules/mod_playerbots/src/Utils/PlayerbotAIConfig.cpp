@@ -84,6 +84,10 @@ bool PlayerbotAIConfig::Initialize()
     dispelAuraDuration = sConfigMgr->GetIntDefault("AiPlayerbot.DispelAuraDuration", 7000);
     reactDelay = sConfigMgr->GetIntDefault("AiPlayerbot.ReactDelay", 100);
     dynamicReactDelay = sConfigMgr->GetBoolDefault("AiPlayerbot.DynamicReactDelay", true);
+    mapUpdateBudget = sConfigMgr->GetIntDefault("AiPlayerbot.MapUpdateBudget", 10000);
+    maxDeferredUpdate = sConfigMgr->GetIntDefault("AiPlayerbot.MaxDeferredUpdate", 1000);
+    idleUpdateDelay = sConfigMgr->GetIntDefault("AiPlayerbot.IdleUpdateDelay", 200);
+    maxIdleUpdateDelay = sConfigMgr->GetIntDefault("AiPlayerbot.MaxIdleUpdateDelay", 5000);
     passiveDelay = sConfigMgr->GetIntDefault("AiPlayerbot.PassiveDelay", 10000);
     repeatDelay = sConfigMgr->GetIntDefault("AiPlayerbot.RepeatDelay", 2000);
     errorDelay = sConfigMgr->GetIntDefault("AiPlayerbot.ErrorDelay", 5000);
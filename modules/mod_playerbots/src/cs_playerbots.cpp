@@ -17,6 +17,7 @@
 #include "PlayerbotMgr.h"
 #include "PerformanceMonitor.h"
 #include "PlayerbotAIConfig.h"
+#include "PlayerbotScheduler.h"
 #include "RandomPlayerbotMgr.h"
 #include "ScriptMgr.h"
 
@@ -31,6 +32,7 @@ public:
         {
             { "npcbot",         SEC_ADMINISTRATOR,          true,           &HandlePlayerbotCommand},
             { "pmon",           SEC_GAMEMASTER,             true,           &HandlePerfMonCommand},
+            { "botsched",       SEC_GAMEMASTER,             true,           &HandleBotScheduleCommand},
         };
         return commandTable;
     }
@@ -60,6 +62,31 @@ public:
             return true;
         }
 
+        if (!strncmp(args, "hist ", 5))
+        {
+            sPerformanceMonitor->PrintHistogram(args + 5);
+            return true;
+        }
+
+        if (!strncmp(args, "trace", 5))
+        {
+            // .pmon trace [seconds] [file]
+            char* secondsStr = strtok((char*)args + 5, " ");
+            char* fileName = strtok(nullptr, " ");
+            uint32 seconds = secondsStr ? atoi(secondsStr) : 10;
+            if (!seconds)
+                seconds = 10;
+
+            if (!sPerformanceMonitor->StartTrace(seconds, fileName ? fileName : "playerbots_trace.json"))
+            {
+                handler->SendSysMessage("A trace is already running or being written.");
+                return true;
+            }
+
+            handler->PSendSysMessage("Tracing bot operations for %u seconds.", seconds);
+            return true;
+        }
+
         if (!strcmp(args, "toggle"))
         {
             sPlayerbotAIConfig->perfMonEnabled = !sPlayerbotAIConfig->perfMonEnabled;
@@ -73,6 +100,29 @@ public:
         sPerformanceMonitor->PrintStats();
         return true;
     }
+
+    // .botsched [reset] - bot AI time per map
+    static bool HandleBotScheduleCommand(ChatHandler* handler, char const* args)
+    {
+        if (!strcmp(args, "reset"))
+        {
+            sPlayerbotScheduler->Reset();
+            handler->SendSysMessage("Bot scheduler counters cleared.");
+            return true;
+        }
+
+        handler->PSendSysMessage("Bot AI per map, budget %u us per update:", sPlayerbotAIConfig->mapUpdateBudget);
+        for (PlayerbotMapUsage const& usage : sPlayerbotScheduler->GetMapUsage())
+        {
+            handler->PSendSysMessage("  map %u instance %u: " UI64FMTD " ms, " UI64FMTD " updates (" UI64FMTD " us avg), " UI64FMTD
+                                     " deferred, " UI64FMTD " idle delayed, worst update " UI64FMTD " us",
+                                     usage.mapId, usage.instanceId, usage.totalNs / 1000000, usage.updates,
+                                     usage.updates ? usage.totalNs / usage.updates / 1000 : 0, usage.deferred, usage.idleDelayed,
+                                     usage.maxTickNs / 1000);
+        }
+
+        return true;
+    }
 };
 
 void AddSC_playerbots_commandscript() { new playerbots_commandscript(); }
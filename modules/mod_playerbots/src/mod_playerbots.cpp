@@ -21,6 +21,8 @@
 #include "RandomPlayerbotMgr.h"
 #include "RandomItemManager.h"
 #include "RandomPlayerbotBracketMgr.h"
+#include "PerformanceMonitor.h"
+#include "PlayerbotScheduler.h"
 
 #include "Authentication/AuthCrypt.h"
 #include "CharacterHandler.h"
@@ -88,6 +90,8 @@ public:
     void OnUpdate(uint32 diff) override
     {
         sBracketMgr->Update(diff);
+        sPlayerbotScheduler->Update(diff);
+        sPerformanceMonitor->Update();
     }
 };
 
@@ -197,7 +201,7 @@ public:
     {
         if (PlayerbotAI* botAI = GET_PLAYERBOT_AI(player))
         {
-            botAI->UpdateAI(diff);
+            sPlayerbotScheduler->UpdateBot(botAI, player, diff);
         }
 
         if (PlayerbotMgr* playerbotMgr = GET_PLAYERBOT_MGR(player))
@@ -119,7 +119,53 @@ Action* AiObjectContext::GetAction(std::string const name)
     return action;
 }
 
-UntypedValue* AiObjectContext::GetUntypedValue(std::string const name)
+UntypedValue* AiObjectContext::GetUntypedValue(std::string const& name)
+{
+    uint32 id = NamedObjectIds::GetId(name);
+    if (id == NamedObjectIds::Invalid)
+        return ResolveValue(name);
+
+    return GetUntypedValue(id);
+}
+
+UntypedValue* AiObjectContext::GetUntypedValue(uint32 id)
+{
+    if (id < valueCache.size() && valueCache[id])
+        return valueCache[id];
+
+    UntypedValue* value = ResolveValue(NamedObjectIds::GetName(id));
+    // unknown names are not cached, contexts added later may know them
+    if (value)
+    {
+        if (id >= valueCache.size())
+            valueCache.resize(id + 1, nullptr);
+
+        valueCache[id] = value;
+    }
+
+    return value;
+}
+
+UntypedValue* AiObjectContext::GetUntypedValue(uint32 id, int32 param)
+{
+    uint64 key = (uint64(id) << 32) | uint32(param);
+    auto itr = qualifiedValueCache.find(key);
+    if (itr != qualifiedValueCache.end())
+        return itr->second;
+
+    std::string const& name = NamedObjectIds::GetName(id);
+    std::string qualified;
+    qualified.reserve(name.size() + 13);
+    qualified.append(name).append("::").append(std::to_string(param));
+
+    UntypedValue* value = ResolveValue(qualified);
+    if (value)
+        qualifiedValueCache[key] = value;
+
+    return value;
+}
+
+UntypedValue* AiObjectContext::ResolveValue(std::string const& name)
 {
     return valueContexts.GetContextObject(name, botAI);
 }
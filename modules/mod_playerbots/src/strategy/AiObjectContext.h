@@ -8,9 +8,13 @@
 
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include "Common.h"
 #include "NamedObjectContext.h"
+#include "PerformanceMonitor.h"
 #include "PlayerbotAIAware.h"
 #include "Strategy.h"
 #include "Trigger.h"
@@ -28,26 +32,50 @@ public:
     virtual std::set<std::string> GetSiblingStrategy(std::string const name);
     virtual Trigger* GetTrigger(std::string const name);
     virtual Action* GetAction(std::string const name);
-    virtual UntypedValue* GetUntypedValue(std::string const name);
+    virtual UntypedValue* GetUntypedValue(std::string const& name);
+    UntypedValue* GetUntypedValue(uint32 id);
+    UntypedValue* GetUntypedValue(uint32 id, int32 param);
 
     template <class T>
-    Value<T>* GetValue(std::string const name)
+    Value<T>* GetValue(std::string const& name)
     {
         return dynamic_cast<Value<T>*>(GetUntypedValue(name));
     }
 
+    // string literals of AI_VALUE and friends, resolved without hashing or allocating once seen by the bot
+    template <class T, size_t N>
+    Value<T>* GetValue(char const (&name)[N])
+    {
+        uint32 id = NamedObjectIds::GetLiteralId(name);
+        if (id == NamedObjectIds::Invalid)
+            return GetValue<T>(std::string(name));
+
+        return dynamic_cast<Value<T>*>(GetUntypedValue(id));
+    }
+
     template <class T>
-    Value<T>* GetValue(std::string const name, std::string const param)
+    Value<T>* GetValue(std::string const& name, std::string const& param)
     {
-        return GetValue<T>((std::string(name) + "::" + param));
+        std::string qualified;
+        qualified.reserve(name.size() + 2 + param.size());
+        qualified.append(name).append("::").append(param);
+        return GetValue<T>(qualified);
     }
 
     template <class T>
-    Value<T>* GetValue(std::string const name, int32 param)
+    Value<T>* GetValue(std::string const& name, int32 param)
+    {
+        return GetValue<T>(name, std::to_string(param));
+    }
+
+    template <class T, size_t N>
+    Value<T>* GetValue(char const (&name)[N], int32 param)
     {
-        std::ostringstream out;
-        out << param;
-        return GetValue<T>(name, out.str());
+        uint32 id = NamedObjectIds::GetLiteralId(name);
+        if (id == NamedObjectIds::Invalid)
+            return GetValue<T>(std::string(name), param);
+
+        return dynamic_cast<Value<T>*>(GetUntypedValue(id, param));
     }
 
     std::set<std::string> GetValues();
@@ -62,13 +90,20 @@ public:
     std::vector<std::string> Save();
     void Load(std::vector<std::string> data);
 
-    std::vector<std::string> performanceStack;
+    PerformanceStack performanceStack;
 
 protected:
     NamedObjectContextList<Strategy> strategyContexts;
     NamedObjectContextList<Action> actionContexts;
     NamedObjectContextList<Trigger> triggerContexts;
     NamedObjectContextList<UntypedValue> valueContexts;
+
+private:
+    UntypedValue* ResolveValue(std::string const& name);
+
+    // values never move or die before the context, indexed by NamedObjectIds
+    std::vector<UntypedValue*> valueCache;
+    std::unordered_map<uint64, UntypedValue*> qualifiedValueCache;
 };
 
 #endif
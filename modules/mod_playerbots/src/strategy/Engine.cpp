@@ -205,10 +205,12 @@ bool Engine::DoNextAction(Unit* unit, uint32 depth, bool minimal)
                     }
                 }
 
-                PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(PERF_MON_ACTION, action->getName(), &aiObjectContext->performanceStack);
+                PerformanceMonitorOperation pmo;
+                if (sPerformanceMonitor->IsEnabled())
+                    pmo = sPerformanceMonitor->start(PERF_MON_ACTION, action->getName(), &aiObjectContext->performanceStack);
+
                 actionExecuted = ListenAndExecute(action, event);
-                if (pmo)
-                    pmo->finish();
+                pmo.finish();
 
                 if (actionExecuted)
                 {
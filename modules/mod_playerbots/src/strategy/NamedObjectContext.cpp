@@ -7,6 +7,66 @@
 
 #include "Playerbots.h"
 
+#include <mutex>
+
+std::shared_mutex NamedObjectIds::_lock;
+std::deque<std::string> NamedObjectIds::_storage;
+std::unordered_map<std::string_view, uint32> NamedObjectIds::_ids;
+std::vector<std::string const*> NamedObjectIds::_names;
+
+uint32 NamedObjectIds::GetId(std::string_view name)
+{
+    if (name.find("::") != std::string_view::npos)
+        return Invalid;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(_lock);
+        auto itr = _ids.find(name);
+        if (itr != _ids.end())
+            return itr->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(_lock);
+    auto itr = _ids.find(name);
+    if (itr != _ids.end())
+        return itr->second;
+
+    std::string const& stored = _storage.emplace_back(name);
+    uint32 id = uint32(_names.size());
+    _names.push_back(&stored);
+    _ids.emplace(stored, id);
+    return id;
+}
+
+uint32 NamedObjectIds::GetLiteralId(std::string_view name)
+{
+    struct LiteralId
+    {
+        uint32 id;
+        std::string_view name;
+    };
+
+    // per thread, maps are updated concurrently and the lookup must stay lock free
+    thread_local std::unordered_map<char const*, LiteralId> literals;
+
+    auto itr = literals.find(name.data());
+    // compared with the interned name, a char array that is not a literal may hold another name by now
+    if (itr != literals.end() && itr->second.name == name)
+        return itr->second.id;
+
+    uint32 id = GetId(name);
+    if (id != Invalid)
+        literals[name.data()] = {id, GetName(id)};
+
+    return id;
+}
+
+std::string const& NamedObjectIds::GetName(uint32 id)
+{
+    std::shared_lock<std::shared_mutex> lock(_lock);
+    return *_names[id];
+}
+
 void Qualified::Qualify(int qual)
 {
     std::ostringstream out;
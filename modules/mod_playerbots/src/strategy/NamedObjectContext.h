@@ -6,8 +6,11 @@
 #ifndef _PLAYERBOT_NAMEDOBJECTCONEXT_H
 #define _PLAYERBOT_NAMEDOBJECTCONEXT_H
 
+#include <deque>
 #include <list>
 #include <set>
+#include <shared_mutex>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -37,6 +40,25 @@ protected:
     std::string qualifier;
 };
 
+// Dense ids of unqualified object names, shared by all bots. Ids are never released so per bot caches can index
+// arrays by them, names containing "::" are not interned as their qualifiers are unbounded.
+class NamedObjectIds
+{
+public:
+    static uint32 const Invalid = 0xFFFFFFFF;
+
+    static uint32 GetId(std::string_view name);
+    // the id of a string literal, remembered by its address so repeated lookups do not hash the name
+    static uint32 GetLiteralId(std::string_view name);
+    static std::string const& GetName(uint32 id);
+
+private:
+    static std::shared_mutex _lock;
+    static std::deque<std::string> _storage;
+    static std::unordered_map<std::string_view, uint32> _ids;
+    static std::vector<std::string const*> _names;
+};
+
 template <class T>
 class NamedObjectFactory
 {
@@ -92,12 +114,13 @@ public:
 
     virtual ~NamedObjectContext() { Clear(); }
 
-    T* create(std::string const name, PlayerbotAI* botAI)
+    T* create(std::string const& name, PlayerbotAI* botAI)
     {
-        if (created.find(name) == created.end())
-            return created[name] = NamedObjectFactory<T>::create(name, botAI);
+        typename std::unordered_map<std::string, T*>::iterator i = created.find(name);
+        if (i != created.end())
+            return i->second;
 
-        return created[name];
+        return created[name] = NamedObjectFactory<T>::create(name, botAI);
     }
 
     void Clear()
@@ -163,7 +186,7 @@ public:
 
     void Add(NamedObjectContext<T>* context) { contexts.push_back(context); }
 
-    T* GetContextObject(std::string const name, PlayerbotAI* botAI)
+    T* GetContextObject(std::string const& name, PlayerbotAI* botAI)
     {
         for (typename std::vector<NamedObjectContext<T>*>::iterator i = contexts.begin(); i != contexts.end(); i++)
         {
@@ -123,11 +123,13 @@ Unit* UnitCalculatedValue::Get()
 {
     if (checkInterval < 2)
     {
-        PerformanceMonitorOperation *pmo = sPerformanceMonitor->start(
-                PERF_MON_VALUE, this->getName(), this->context ? &this->context->performanceStack : nullptr);
+        PerformanceMonitorOperation pmo;
+        if (sPerformanceMonitor->IsEnabled())
+            pmo = sPerformanceMonitor->start(PERF_MON_VALUE, this->getName(),
+                                             this->context ? &this->context->performanceStack : nullptr);
+
         value = Calculate();
-        if (pmo)
-            pmo->finish();
+        pmo.finish();
     }
     else
     {
@@ -27,6 +27,14 @@ namespace MMAP
     constexpr char TILE_FILE_NAME_FORMAT[] = "%s/mmaps/%04i_%02i_%02i.mmtile";
 
     // ######################## MMapManager ########################
+    uint32 MMapManager::GetThreadQuerySlot()
+    {
+        // every thread that ever asks for a query gets its own slot, slots are never reused
+        static std::atomic<uint32> nextSlot(0);
+        thread_local uint32 const slot = nextSlot++;
+        return slot;
+    }
+
     MMapManager::~MMapManager()
     {
         for (std::pair<uint32 const, MMapData*>& loadedMMap : loadedMMaps)
@@ -182,7 +190,13 @@ namespace MMAP
         dtTileRef tileRef = 0;
 
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef)))
+        dtStatus addResult;
+        {
+            std::unique_lock<std::shared_mutex> lock(mmap->navMeshLock);
+            addResult = mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef);
+        }
+
+        if (dtStatusSucceed(addResult))
         {
             mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
             ++loadedTiles;
@@ -221,8 +235,14 @@ namespace MMAP
 
         dtTileRef tileRef = mmap->loadedTileRefs[packedGridPos];
 
+        dtStatus removeResult;
+        {
+            std::unique_lock<std::shared_mutex> lock(mmap->navMeshLock);
+            removeResult = mmap->navMesh->removeTile(tileRef, nullptr, nullptr);
+        }
+
         // unload, and mark as non loaded
-        if (dtStatusFailed(mmap->navMesh->removeTile(tileRef, nullptr, nullptr)))
+        if (dtStatusFailed(removeResult))
         {
             // this is technically a memory leak
             // if the grid is later reloaded, dtNavMesh::addTile will return error but no extra memory is used
@@ -253,6 +273,7 @@ namespace MMAP
 
         // unload all tiles from given map
         MMapData* mmap = itr->second;
+        std::unique_lock<std::shared_mutex> lock(mmap->navMeshLock);
         for (MMapTileSet::iterator i = mmap->loadedTileRefs.begin(); i != mmap->loadedTileRefs.end(); ++i)
         {
             uint32 x = (i->first >> 16);
@@ -266,6 +287,9 @@ namespace MMAP
             }
         }
 
+        lock.unlock();
+
+        navMeshQueriesCount -= uint32(mmap->navMeshQueries.size());
         delete mmap;
         itr->second = nullptr;
         TC_LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded %04i.mmap", mapId);
@@ -285,17 +309,31 @@ namespace MMAP
         }
 
         MMapData* mmap = itr->second;
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+        uint32 freedQueries = 0;
+        {
+            std::unique_lock<std::shared_mutex> lock(mmap->navMeshQueriesLock);
+            for (NavMeshQuerySet::iterator i = mmap->navMeshQueries.begin(); i != mmap->navMeshQueries.end();)
+            {
+                if (uint32(i->first >> 32) != instanceId)
+                {
+                    ++i;
+                    continue;
+                }
+
+                dtFreeNavMeshQuery(i->second);
+                i = mmap->navMeshQueries.erase(i);
+                ++freedQueries;
+            }
+        }
+
+        if (!freedQueries)
         {
             TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded dtNavMeshQuery mapId %04u instanceId %u", mapId, instanceId);
             return false;
         }
 
-        dtNavMeshQuery* query = mmap->navMeshQueries[instanceId];
-
-        dtFreeNavMeshQuery(query);
-        mmap->navMeshQueries.erase(instanceId);
-        TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Unloaded mapId %04u instanceId %u", mapId, instanceId);
+        navMeshQueriesCount -= freedQueries;
+        TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Unloaded mapId %04u instanceId %u (%u queries)", mapId, instanceId, freedQueries);
 
         return true;
     }
@@ -309,6 +347,15 @@ namespace MMAP
         return itr->second->navMesh;
     }
 
+    NavMeshReadGuard MMapManager::GetNavMeshReadGuard(uint32 mapId)
+    {
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+            return NavMeshReadGuard();
+
+        return NavMeshReadGuard(itr->second->navMeshLock);
+    }
+
     dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
     {
         MMapDataSet::const_iterator itr = GetMMapData(mapId);
@@ -316,22 +363,30 @@ namespace MMAP
             return nullptr;
 
         MMapData* mmap = itr->second;
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+        uint32 threadSlot = GetThreadQuerySlot();
+        uint64 queryId = packQueryID(instanceId, threadSlot);
         {
-            // allocate mesh query
-            dtNavMeshQuery* query = dtAllocNavMeshQuery();
-            ASSERT(query);
-            if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
-            {
-                dtFreeNavMeshQuery(query);
-                TC_LOG_ERROR("maps", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %04u instanceId %u", mapId, instanceId);
-                return nullptr;
-            }
+            std::shared_lock<std::shared_mutex> lock(mmap->navMeshQueriesLock);
+            NavMeshQuerySet::const_iterator queryItr = mmap->navMeshQueries.find(queryId);
+            if (queryItr != mmap->navMeshQueries.end())
+                return queryItr->second;
+        }
 
-            TC_LOG_DEBUG("maps", "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-            mmap->navMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(instanceId, query));
+        // allocate mesh query for this thread, only the calling thread can insert its own slot
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        ASSERT(query);
+        if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
+        {
+            dtFreeNavMeshQuery(query);
+            TC_LOG_ERROR("maps", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %04u instanceId %u", mapId, instanceId);
+            return nullptr;
         }
 
-        return mmap->navMeshQueries[instanceId];
+        TC_LOG_DEBUG("maps", "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u instanceId %u thread slot %u", mapId, instanceId, threadSlot);
+
+        std::unique_lock<std::shared_mutex> lock(mmap->navMeshQueriesLock);
+        mmap->navMeshQueries.insert(NavMeshQuerySet::value_type(queryId, query));
+        ++navMeshQueriesCount;
+        return query;
     }
 }
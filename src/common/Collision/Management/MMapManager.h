@@ -21,6 +21,9 @@
 #include "Define.h"
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -29,7 +32,8 @@
 namespace MMAP
 {
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
-    typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
+    typedef std::unordered_map<uint64, dtNavMeshQuery*> NavMeshQuerySet;
+    typedef std::shared_lock<std::shared_mutex> NavMeshReadGuard;
 
     // dummy struct to hold map's mmap data
     struct TC_COMMON_API MMapData
@@ -44,8 +48,13 @@ namespace MMAP
                 dtFreeNavMesh(navMesh);
         }
 
-        // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
-        NavMeshQuerySet navMeshQueries;     // instanceId to query
+        // dtNavMeshQuery keeps per-search state and is not thread safe, so every thread
+        // gets its own query object per instance; the dtNavMesh itself is shared
+        NavMeshQuerySet navMeshQueries;     // [instanceId, thread slot] to query
+        std::shared_mutex navMeshQueriesLock;
+
+        // held shared while searching the mesh, exclusively while tiles are added or removed
+        std::shared_mutex navMeshLock;
 
         dtNavMesh* navMesh;
         MMapTileSet loadedTileRefs;        // maps [map grid coords] to [dtTile]
@@ -59,7 +68,7 @@ namespace MMAP
     class TC_COMMON_API MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0), thread_safe_environment(true) { }
+            MMapManager() : loadedTiles(0), navMeshQueriesCount(0), thread_safe_environment(true) { }
             ~MMapManager();
 
             void InitializeThreadUnsafe(const std::vector<uint32>& mapIds);
@@ -68,19 +77,25 @@ namespace MMAP
             bool unloadMap(uint32 mapId);
             bool unloadMapInstance(uint32 mapId, uint32 instanceId);
 
-            // the returned [dtNavMeshQuery const*] is NOT threadsafe
+            // the returned [dtNavMeshQuery const*] belongs to the calling thread and must not be shared with other threads
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
+            // keeps tiles of the map from being added or removed while the guard is held
+            NavMeshReadGuard GetNavMeshReadGuard(uint32 mapId);
 
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return uint32(loadedMMaps.size()); }
+            uint32 getNavMeshQueriesCount() const { return navMeshQueriesCount; }
         private:
             bool loadMapData(uint32 mapId);
             uint32 packTileID(int32 x, int32 y);
+            static uint64 packQueryID(uint32 instanceId, uint32 threadSlot) { return uint64(instanceId) << 32 | threadSlot; }
+            static uint32 GetThreadQuerySlot();
 
             MMapDataSet::const_iterator GetMMapData(uint32 mapId) const;
             MMapDataSet loadedMMaps;
             uint32 loadedTiles;
+            std::atomic<uint32> navMeshQueriesCount;
             bool thread_safe_environment;
     };
 }
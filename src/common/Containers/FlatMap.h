@@ -0,0 +1,118 @@
+/*
+* This file is part of the Legends of Azeroth Pandaria Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef TRINITYCORE_FLAT_MAP_H
+#define TRINITYCORE_FLAT_MAP_H
+
+#include <algorithm>
+#include <functional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace Trinity::Containers
+{
+// sorted vector of key/value pairs, for small maps that are looked up far more often than they change
+// inserting or erasing invalidates iterators and references to other elements
+template <class Key, class Value, class Compare = std::less<Key>>
+class FlatMap
+{
+public:
+    using value_type = std::pair<Key, Value>;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    bool empty() const { return _storage.empty(); }
+    auto size() const { return _storage.size(); }
+
+    auto begin() { return _storage.begin(); }
+    auto begin() const { return _storage.begin(); }
+
+    auto end() { return _storage.end(); }
+    auto end() const { return _storage.end(); }
+
+    const_iterator find(Key const& key) const
+    {
+        auto itr = lower_bound(key);
+        if (itr != this->end() && Compare()(key, itr->first))
+            return this->end();
+
+        return itr;
+    }
+
+    iterator find(Key const& key)
+    {
+        auto itr = lower_bound(key);
+        if (itr != this->end() && Compare()(key, itr->first))
+            return this->end();
+
+        return itr;
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(Key const& key, Args&&... args)
+    {
+        auto itr = lower_bound(key);
+        if (itr != this->end() && !Compare()(key, itr->first))
+            return { itr, false };
+
+        return { _storage.emplace(itr, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...)), true };
+    }
+
+    std::pair<iterator, bool> insert(value_type const& value) { return try_emplace(value.first, value.second); }
+
+    Value& operator[](Key const& key) { return try_emplace(key).first->second; }
+
+    std::size_t erase(Key const& key)
+    {
+        auto itr = this->find(key);
+        if (itr == this->end())
+            return 0;
+
+        this->erase(itr);
+        return 1;
+    }
+    auto erase(const_iterator itr) { return _storage.erase(itr); }
+
+    template <class Pred>
+    std::size_t erase_if(Pred pred)
+    {
+        auto itr = std::remove_if(_storage.begin(), _storage.end(), pred);
+        std::size_t count = std::distance(itr, _storage.end());
+        _storage.erase(itr, _storage.end());
+        return count;
+    }
+
+    void clear() { _storage.clear(); }
+
+    void shrink_to_fit() { _storage.shrink_to_fit(); }
+
+private:
+    iterator lower_bound(Key const& key)
+    {
+        return std::lower_bound(_storage.begin(), _storage.end(), key, [](value_type const& element, Key const& k) { return Compare()(element.first, k); });
+    }
+
+    const_iterator lower_bound(Key const& key) const
+    {
+        return std::lower_bound(_storage.begin(), _storage.end(), key, [](value_type const& element, Key const& k) { return Compare()(element.first, k); });
+    }
+
+    std::vector<value_type> _storage;
+};
+}
+
+#endif // TRINITYCORE_FLAT_MAP_H
@@ -17,15 +17,6 @@
 
 #include "EventProcessor.h"
 
-bool RepeatableFunctionEvent::Execute(uint64, uint32)
-{
-    if (m_function())
-        return true;
-
-    m_events->Schedule(m_repeat, this);
-    return false;
-}
-
 EventProcessor::EventProcessor()
 {
     m_time = 0;
@@ -102,15 +93,24 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
 
 void EventProcessor::RescheduleEvent(BasicEvent* event, uint64 e_time)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end(); ++itr)
-    {
+    auto itr = FindEventNode(event);
+    if (itr == m_events.end())
+        return;
+
+    m_events.erase(itr);
+    event->m_execTime = e_time;
+    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, event));
+}
+
+EventList::iterator EventProcessor::FindEventNode(BasicEvent* event)
+{
+    // events are keyed by their execution time, only the entries sharing it have to be scanned
+    auto bounds = m_events.equal_range(event->m_execTime);
+    for (auto itr = bounds.first; itr != bounds.second; ++itr)
         if (itr->second == event)
-        {
-            m_events.erase(itr);
-            m_events.insert(std::pair<uint64, BasicEvent*>(e_time, event));
-            break;
-        }
-    }
+            return itr;
+
+    return m_events.end();
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
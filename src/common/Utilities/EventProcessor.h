@@ -19,9 +19,12 @@
 #define __EVENTPROCESSOR_H
 
 #include "Define.h"
+#include "NodePoolAllocator.h"
 
 #include <map>
 #include <functional>
+#include <type_traits>
+#include <utility>
 
 // Note. All times are in milliseconds here.
 
@@ -31,6 +34,10 @@ public:
     BasicEvent() { to_Abort = false; }
     virtual ~BasicEvent() { }                           // override destructor to perform some actions on event removal
 
+    // events are created and destroyed at a high rate by every unit, take them from the small object pool
+    static void* operator new(std::size_t size) { return Trinity::SmallObjectPool::Allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) { Trinity::SmallObjectPool::Deallocate(ptr, size); }
+
     // this method executes when the event is triggered
     // return false if event does not want to be deleted
     // e_time is execution time, p_time is update interval
@@ -78,35 +85,37 @@ private:
     group_type m_group;
 };
 
+// the callable is stored in the event itself, so scheduling a lambda costs the single pooled event allocation
+template<typename T>
 class FunctionEvent : public GroupedEvent
 {
 public:
-    typedef std::function<void()> function_type;
-
-    FunctionEvent(function_type const& function, group_type group = 0) : GroupedEvent(group), m_function(function) { }
+    template<typename F>
+    FunctionEvent(F&& function, group_type group = 0) : GroupedEvent(group), m_function(std::forward<F>(function)) { }
     bool Execute(uint64, uint32) override { m_function(); return true; }
 
 protected:
-    function_type m_function;
+    T m_function;
 };
 
 class EventProcessor;
 
+// the callable returns true once it is done, false to run again after the repeat delay
+template<typename T>
 class RepeatableFunctionEvent : public GroupedEvent
 {
 public:
-    typedef std::function<bool()> function_type;
-
-    RepeatableFunctionEvent(EventProcessor* events, function_type const& function, uint32 repeat, group_type group = 0) : GroupedEvent(group), m_events(events), m_function(function), m_repeat(repeat) { }
+    template<typename F>
+    RepeatableFunctionEvent(EventProcessor* events, F&& function, uint32 repeat, group_type group = 0) : GroupedEvent(group), m_events(events), m_function(std::forward<F>(function)), m_repeat(repeat) { }
     bool Execute(uint64, uint32) override;
 
 protected:
     EventProcessor* m_events;
-    function_type m_function;
+    T m_function;
     uint32 m_repeat;
 };
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+typedef std::multimap<uint64, BasicEvent*, std::less<uint64>, Trinity::NodePoolAllocator<std::pair<uint64 const, BasicEvent*>>> EventList;
 
 class EventProcessor
 {
@@ -123,6 +132,7 @@ class EventProcessor
         template<class EventFilter>
         void KillCustomEvents(EventFilter const& filter);
         void RescheduleEvent(BasicEvent* event, uint64 e_time);
+        EventList::iterator FindEventNode(BasicEvent* event);
 
         uint64 CalculateTime(uint64 t_offset) const;
 
@@ -135,10 +145,14 @@ class EventProcessor
         void AddLambdaEventAtOffset(T&& event, uint32 offset) { AddEventAtOffset(new LambdaBasicEvent<T>(std::move(event)), offset); }
 
         void Schedule(uint32 delay, BasicEvent* Event) { AddEvent(Event, CalculateTime(delay)); }
-        void Schedule(uint32 delay, FunctionEvent::function_type const& function) { Schedule(delay, new FunctionEvent(function)); }
-        void Schedule(uint32 delay, GroupedEvent::group_type group, FunctionEvent::function_type const& function) { Schedule(delay, new FunctionEvent(function, group)); }
-        void Repeated(uint32 delay, uint32 repeat, RepeatableFunctionEvent::function_type const& function) { Schedule(delay, new RepeatableFunctionEvent(this, function, repeat)); }
-        void Repeated(uint32 delay, uint32 repeat, GroupedEvent::group_type group, RepeatableFunctionEvent::function_type const& function) { Schedule(delay, new RepeatableFunctionEvent(this, function, repeat, group)); }
+        template<typename T, typename = std::enable_if_t<!std::is_convertible<T, BasicEvent*>::value>>
+        void Schedule(uint32 delay, T&& function) { Schedule(delay, new FunctionEvent<std::decay_t<T>>(std::forward<T>(function))); }
+        template<typename T>
+        void Schedule(uint32 delay, GroupedEvent::group_type group, T&& function) { Schedule(delay, new FunctionEvent<std::decay_t<T>>(std::forward<T>(function), group)); }
+        template<typename T>
+        void Repeated(uint32 delay, uint32 repeat, T&& function) { Schedule(delay, new RepeatableFunctionEvent<std::decay_t<T>>(this, std::forward<T>(function), repeat)); }
+        template<typename T>
+        void Repeated(uint32 delay, uint32 repeat, GroupedEvent::group_type group, T&& function) { Schedule(delay, new RepeatableFunctionEvent<std::decay_t<T>>(this, std::forward<T>(function), repeat, group)); }
 
         void KillEventsByGroup(GroupedEvent::group_type group) { KillCustomEvents([group](BasicEvent* event) { if (GroupedEvent* e = dynamic_cast<GroupedEvent*>(event)) return e->GetGroup() == group; return false; }); }
         void KillEventsByGroupMask(GroupedEvent::group_type groupMask) { KillCustomEvents([groupMask](BasicEvent* event) { if (GroupedEvent* e = dynamic_cast<GroupedEvent*>(event)) return (e->GetGroupMask() & groupMask) != 0; return false; }); }
@@ -149,6 +163,16 @@ class EventProcessor
         bool m_aborting;
 };
 
+template<typename T>
+bool RepeatableFunctionEvent<T>::Execute(uint64, uint32)
+{
+    if (m_function())
+        return true;
+
+    m_events->Schedule(m_repeat, this);
+    return false;
+}
+
 template<class EventFilter>
 BasicEvent* EventProcessor::FindEvent(EventFilter const& filter)
 {
@@ -168,11 +192,10 @@ void EventProcessor::ProcessCustomEvents(EventFilter const& filter)
         BasicEvent* event = itr.second;
         if (filter(event))
         {
-            auto origItr = std::find_if(m_events.begin(), m_events.end(), [=](EventList::value_type const& p)
-            {
-                return p.second == event;
-            });
-            //ASSERT(origItr != m_events.end());
+            auto origItr = FindEventNode(event);
+            if (origItr == m_events.end())
+                continue;
+
             m_events.erase(origItr);
 
             if (!event->to_Abort)
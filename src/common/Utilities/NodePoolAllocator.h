@@ -0,0 +1,244 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NodePoolAllocator_h__
+#define NodePoolAllocator_h__
+
+#include "Define.h"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Trinity
+{
+    namespace Impl
+    {
+        // thread local free lists of fixed size nodes, carved from chunks that are kept for the lifetime of the process
+        // a node released on another thread than the one that allocated it joins that thread's free list, a list grown past
+        // two chunks worth of nodes hands a batch to a shared depot that threads running dry take from before carving a new chunk
+        // an exiting thread hands its whole list to the depot
+        template<std::size_t Size, std::size_t Align>
+        class NodePool
+        {
+            union Node
+            {
+                Node* Next;
+                alignas(Align) unsigned char Storage[Size];
+            };
+
+            static constexpr std::size_t NodesPerChunk = sizeof(Node) < 128 ? 4096 / sizeof(Node) : 32;
+            static constexpr std::size_t MaxCachedNodes = 2 * NodesPerChunk;
+
+            struct Batch
+            {
+                Node* Head;     // null terminated
+                std::size_t Count;
+            };
+
+            struct Depot
+            {
+                std::mutex Lock;
+                std::vector<Batch> Batches;
+            };
+
+            struct FreeList
+            {
+                Node* Head = nullptr;
+                std::size_t Count = 0;
+
+                FreeList() = default;
+                FreeList(FreeList const&) = delete;
+                FreeList& operator=(FreeList const&) = delete;
+
+                // nodes released afterwards by static destructors of the main thread stay here until the process exits
+                ~FreeList()
+                {
+                    if (!Head)
+                        return;
+
+                    Depot& depot = GetDepot();
+                    std::lock_guard<std::mutex> lock(depot.Lock);
+                    depot.Batches.push_back({ Head, Count });
+                    Head = nullptr;
+                    Count = 0;
+                }
+            };
+
+            static FreeList& GetFreeList()
+            {
+                thread_local FreeList list;
+                return list;
+            }
+
+            // never destroyed, nodes can still be released by static destructors that run after it would be
+            static Depot& GetDepot()
+            {
+                static Depot* depot = new Depot();
+                return *depot;
+            }
+
+            static void Refill(FreeList& list)
+            {
+                Depot& depot = GetDepot();
+                {
+                    std::lock_guard<std::mutex> lock(depot.Lock);
+                    if (!depot.Batches.empty())
+                    {
+                        list.Head = depot.Batches.back().Head;
+                        list.Count = depot.Batches.back().Count;
+                        depot.Batches.pop_back();
+                        return;
+                    }
+                }
+
+                Node* chunk = static_cast<Node*>(::operator new(sizeof(Node) * NodesPerChunk));
+                for (std::size_t i = 0; i < NodesPerChunk - 1; ++i)
+                    chunk[i].Next = &chunk[i + 1];
+                chunk[NodesPerChunk - 1].Next = nullptr;
+                list.Head = chunk;
+                list.Count = NodesPerChunk;
+            }
+
+            static void Release(FreeList& list)
+            {
+                Node* batch = list.Head;
+                Node* last = batch;
+                for (std::size_t i = 1; i < NodesPerChunk; ++i)
+                    last = last->Next;
+
+                list.Head = last->Next;
+                list.Count -= NodesPerChunk;
+                last->Next = nullptr;
+
+                Depot& depot = GetDepot();
+                std::lock_guard<std::mutex> lock(depot.Lock);
+                depot.Batches.push_back({ batch, NodesPerChunk });
+            }
+
+        public:
+            static void* Allocate()
+            {
+                FreeList& list = GetFreeList();
+                if (!list.Head)
+                    Refill(list);
+
+                Node* node = list.Head;
+                list.Head = node->Next;
+                --list.Count;
+                return node;
+            }
+
+            static void Deallocate(void* ptr)
+            {
+                FreeList& list = GetFreeList();
+                Node* node = static_cast<Node*>(ptr);
+                node->Next = list.Head;
+                list.Head = node;
+
+                if (++list.Count > MaxCachedNodes)
+                    Release(list);
+            }
+        };
+    }
+
+    /**
+     * @class NodePoolAllocator
+     *
+     * @brief Stateless allocator for node based containers (list, map, multimap) that are filled and drained at a high rate.
+     *        Single node allocations are served from a per thread pool instead of the heap, iterator semantics of the container are unchanged.
+     */
+    template<typename T>
+    class NodePoolAllocator
+    {
+    public:
+        typedef T value_type;
+
+        NodePoolAllocator() noexcept = default;
+        template<typename U>
+        NodePoolAllocator(NodePoolAllocator<U> const&) noexcept { }
+
+        T* allocate(std::size_t n)
+        {
+            if (n == 1)
+                return static_cast<T*>(Impl::NodePool<sizeof(T), alignof(T)>::Allocate());
+
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* ptr, std::size_t n) noexcept
+        {
+            if (n == 1)
+                Impl::NodePool<sizeof(T), alignof(T)>::Deallocate(ptr);
+            else
+                std::allocator<T>().deallocate(ptr, n);
+        }
+
+        template<typename U>
+        bool operator==(NodePoolAllocator<U> const&) const noexcept { return true; }
+        template<typename U>
+        bool operator!=(NodePoolAllocator<U> const&) const noexcept { return false; }
+    };
+
+    /**
+     * @class SmallObjectPool
+     *
+     * @brief Per thread pools for short lived polymorphic objects of varying size, requests are rounded up to 16 byte size classes.
+     *        Memory must be returned with the size it was requested with, use it from class level operator new and sized operator delete.
+     */
+    class SmallObjectPool
+    {
+        static constexpr std::size_t Granularity = 16;
+        static constexpr std::size_t MaxSize = 256;
+
+        typedef std::make_index_sequence<MaxSize / Granularity> SizeClasses;
+
+        template<std::size_t... Classes>
+        static void* Allocate(std::size_t sizeClass, std::index_sequence<Classes...>)
+        {
+            static constexpr void* (*allocators[])() = { &Impl::NodePool<(Classes + 1) * Granularity, Granularity>::Allocate... };
+            return allocators[sizeClass]();
+        }
+
+        template<std::size_t... Classes>
+        static void Deallocate(void* ptr, std::size_t sizeClass, std::index_sequence<Classes...>)
+        {
+            static constexpr void (*deallocators[])(void*) = { &Impl::NodePool<(Classes + 1) * Granularity, Granularity>::Deallocate... };
+            deallocators[sizeClass](ptr);
+        }
+
+    public:
+        static void* Allocate(std::size_t size)
+        {
+            if (!size || size > MaxSize)
+                return ::operator new(size);
+
+            return Allocate((size - 1) / Granularity, SizeClasses());
+        }
+
+        static void Deallocate(void* ptr, std::size_t size) noexcept
+        {
+            if (!size || size > MaxSize)
+                ::operator delete(ptr);
+            else
+                Deallocate(ptr, (size - 1) / Granularity, SizeClasses());
+        }
+    };
+}
+
+#endif // NodePoolAllocator_h__
@@ -0,0 +1,67 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PerThreadRegistry_h__
+#define PerThreadRegistry_h__
+
+#include "Define.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Trinity
+{
+    // one T per thread, created on the first Local() call of the thread and kept after the thread ends so readers still
+    // see what it recorded. Local() costs a thread local load once registered; T synchronizes its own writer and readers.
+    // the thread local cache is per T, so a T must belong to a single registry, which holds for the profiler singletons
+    template<class T>
+    class PerThreadRegistry
+    {
+        public:
+            PerThreadRegistry() = default;
+            PerThreadRegistry(PerThreadRegistry const&) = delete;
+            PerThreadRegistry& operator=(PerThreadRegistry const&) = delete;
+
+            T& Local()
+            {
+                thread_local T* local = nullptr;
+                if (!local)
+                {
+                    std::lock_guard<std::mutex> lock(_lock);
+                    _entries.emplace_back(new T());
+                    local = _entries.back().get();
+                }
+
+                return *local;
+            }
+
+            // visitor(T& data, uint32 index), index is the 1 based registration order and stays the thread's for good
+            template<class Visitor>
+            void ForEach(Visitor&& visitor) const
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                for (std::size_t i = 0; i < _entries.size(); ++i)
+                    visitor(*_entries[i], uint32(i + 1));
+            }
+
+        private:
+            mutable std::mutex _lock;
+            std::vector<std::unique_ptr<T>> _entries;
+    };
+}
+
+#endif // PerThreadRegistry_h__
@@ -72,6 +72,12 @@ TaskScheduler& TaskScheduler::InsertTask(TaskContainer task)
     return *this;
 }
 
+TaskSchedulerObserver*& TaskSchedulerObserver::Current()
+{
+    thread_local TaskSchedulerObserver* current = nullptr;
+    return current;
+}
+
 void TaskScheduler::Dispatch(success_t const& callback)
 {
     // If the validation failed abort the dispatching here.
@@ -99,7 +105,14 @@ void TaskScheduler::Dispatch(success_t const& callback)
         TaskContext context(_task_holder.Pop(), std::weak_ptr<TaskScheduler>(self_reference));
 
         // Invoke the context
-        context.Invoke();
+        if (TaskSchedulerObserver* observer = TaskSchedulerObserver::Current())
+        {
+            observer->OnTaskBegin();
+            context.Invoke();
+            observer->OnTaskEnd();
+        }
+        else
+            context.Invoke();
 
         // If the validation failed abort the dispatching here.
         if (!_predicate())
@@ -161,14 +174,6 @@ bool TaskScheduler::TaskQueue::IsEmpty() const
     return container.empty();
 }
 
-TaskContext& TaskContext::Dispatch(std::function<TaskScheduler&(TaskScheduler&)> const& apply)
-{
-    if (auto const owner = _owner.lock())
-        apply(*owner);
-
-    return *this;
-}
-
 bool TaskContext::IsExpired() const
 {
     return _owner.expired();
@@ -225,5 +230,5 @@ void TaskContext::AssertOnConsumed() const
 
 void TaskContext::Invoke()
 {
-    _task->_task(*this);
+    _task->Invoke(*this);
 }
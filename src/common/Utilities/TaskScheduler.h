@@ -25,14 +25,30 @@
 #include <memory>
 #include <utility>
 #include <set>
+#include <functional>
+#include <type_traits>
 
 #include "Util.h"
 #include "Duration.h"
+#include "NodePoolAllocator.h"
 #include "Random.h"
 
 
 class TaskContext;
 
+/// Receives the task invocations of the schedulers updated on the current thread.
+/// Used by profilers to attribute the time of the tasks to their owner.
+class TC_COMMON_API TaskSchedulerObserver
+{
+public:
+    virtual ~TaskSchedulerObserver() { }
+
+    virtual void OnTaskBegin() = 0;
+    virtual void OnTaskEnd() = 0;
+
+    static TaskSchedulerObserver*& Current();
+};
+
 /// The TaskScheduler class provides the ability to schedule std::function's in the near future.
 /// Use TaskScheduler::Update to update the scheduler.
 /// Popular methods are:
@@ -75,17 +91,18 @@ class TaskScheduler
         duration_t _duration;
         group_t _group;
         repeated_t _repeated;
-        task_handler_t _task;
 
     public:
         // All Argument construct
         Task(timepoint_t const& end, duration_t const& duration, group_t const& group,
-            repeated_t const repeated, task_handler_t const& task)
-                : _end(end), _duration(duration), _group(group), _repeated(repeated), _task(task) { }
+            repeated_t const repeated)
+                : _end(end), _duration(duration), _group(group), _repeated(repeated) { }
 
         // Minimal Argument construct
-        Task(timepoint_t const& end, duration_t const& duration, task_handler_t const& task)
-            : _end(end), _duration(duration), _group(std::numeric_limits<uint32>::max()), _repeated(0), _task(task) { }
+        Task(timepoint_t const& end, duration_t const& duration)
+            : _end(end), _duration(duration), _group(std::numeric_limits<uint32>::max()), _repeated(0) { }
+
+        virtual ~Task() { }
 
         // Copy construct
         Task(Task const&) = delete;
@@ -118,6 +135,27 @@ class TaskScheduler
         {
             return _group == group;
         }
+
+        // Calls the handler of the task
+        virtual void Invoke(TaskContext& context) = 0;
+    };
+
+    /// Task which keeps its handler inline, the handler shares the single pooled
+    /// allocation of the task instead of going through a std::function.
+    template<typename Handler>
+    class HandlerTask : public Task
+    {
+        Handler _handler;
+
+    public:
+        template<typename H, typename... Args>
+        HandlerTask(H&& handler, Args&&... args)
+            : Task(std::forward<Args>(args)...), _handler(std::forward<H>(handler)) { }
+
+        void Invoke(TaskContext& context) override
+        {
+            _handler(context);
+        }
     };
 
     typedef std::shared_ptr<Task> TaskContainer;
@@ -133,7 +171,7 @@ class TaskScheduler
 
     class TaskQueue
     {
-        std::multiset<TaskContainer, Compare> container;
+        std::multiset<TaskContainer, Compare, Trinity::NodePoolAllocator<TaskContainer>> container;
 
     public:
         // Pushes the task in the container
@@ -228,39 +266,39 @@ public:
 
     /// Schedule an event with a fixed rate.
     /// Never call this from within a task context! Use TaskContext::Schedule instead!
-    template<class _Rep, class _Period>
+    template<class _Rep, class _Period, typename Handler>
     TaskScheduler& Schedule(std::chrono::duration<_Rep, _Period> const& time,
-        task_handler_t const& task)
+        Handler&& task)
     {
-        return ScheduleAt(_now, time, task);
+        return ScheduleAt(_now, time, std::forward<Handler>(task));
     }
 
     /// Schedule an event with a fixed rate.
     /// Never call this from within a task context! Use TaskContext::Schedule instead!
-    template<class _Rep, class _Period>
+    template<class _Rep, class _Period, typename Handler>
     TaskScheduler& Schedule(std::chrono::duration<_Rep, _Period> const& time,
-        group_t const group, task_handler_t const& task)
+        group_t const group, Handler&& task)
     {
-        return ScheduleAt(_now, time, group, task);
+        return ScheduleAt(_now, time, group, std::forward<Handler>(task));
     }
 
     /// Schedule an event with a randomized rate between min and max rate.
     /// Never call this from within a task context! Use TaskContext::Schedule instead!
-    template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight>
+    template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight, typename Handler>
     TaskScheduler& Schedule(std::chrono::duration<_RepLeft, _PeriodLeft> const& min,
-        std::chrono::duration<_RepRight, _PeriodRight> const& max, task_handler_t const& task)
+        std::chrono::duration<_RepRight, _PeriodRight> const& max, Handler&& task)
     {
-        return Schedule(RandomDurationBetween(min, max), task);
+        return Schedule(RandomDurationBetween(min, max), std::forward<Handler>(task));
     }
 
     /// Schedule an event with a fixed rate.
     /// Never call this from within a task context! Use TaskContext::Schedule instead!
-    template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight>
+    template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight, typename Handler>
     TaskScheduler& Schedule(std::chrono::duration<_RepLeft, _PeriodLeft> const& min,
         std::chrono::duration<_RepRight, _PeriodRight> const& max, group_t const group,
-        task_handler_t const& task)
+        Handler&& task)
     {
-        return Schedule(RandomDurationBetween(min, max), group, task);
+        return Schedule(RandomDurationBetween(min, max), group, std::forward<Handler>(task));
     }
 
     /// Cancels all tasks.
@@ -373,22 +411,24 @@ private:
     /// Insert a new task to the enqueued tasks.
     TaskScheduler& InsertTask(TaskContainer task);
 
-    template<class _Rep, class _Period>
+    template<class _Rep, class _Period, typename Handler>
     TaskScheduler& ScheduleAt(timepoint_t const& end,
-        std::chrono::duration<_Rep, _Period> const& time, task_handler_t const& task)
+        std::chrono::duration<_Rep, _Period> const& time, Handler&& task)
     {
-        return InsertTask(TaskContainer(new Task(end + time, time, task)));
+        typedef HandlerTask<std::decay_t<Handler>> task_t;
+        return InsertTask(std::allocate_shared<task_t>(Trinity::NodePoolAllocator<task_t>(), std::forward<Handler>(task), end + time, time));
     }
 
     /// Schedule an event with a fixed rate.
     /// Never call this from within a task context! Use TaskContext::schedule instead!
-    template<class _Rep, class _Period>
+    template<class _Rep, class _Period, typename Handler>
     TaskScheduler& ScheduleAt(timepoint_t const& end,
         std::chrono::duration<_Rep, _Period> const& time,
-        group_t const group, task_handler_t const& task)
+        group_t const group, Handler&& task)
     {
         static repeated_t const DEFAULT_REPEATED = 0;
-        return InsertTask(TaskContainer(new Task(end + time, time, group, DEFAULT_REPEATED, task)));
+        typedef HandlerTask<std::decay_t<Handler>> task_t;
+        return InsertTask(std::allocate_shared<task_t>(Trinity::NodePoolAllocator<task_t>(), std::forward<Handler>(task), end + time, time, group, DEFAULT_REPEATED));
     }
 
     // Returns a random duration between min and max
@@ -422,16 +462,23 @@ class TaskContext
     std::shared_ptr<bool> _consumed;
 
     /// Dispatches an action safe on the TaskScheduler
-    TaskContext& Dispatch(std::function<TaskScheduler&(TaskScheduler&)> const& apply);
+    template<typename Apply>
+    TaskContext& Dispatch(Apply&& apply)
+    {
+        if (auto const owner = _owner.lock())
+            apply(*owner);
+
+        return *this;
+    }
 
 public:
     // Empty constructor
     TaskContext()
-        : _task(), _owner(), _consumed(std::make_shared<bool>(true)) { }
+        : _task(), _owner(), _consumed(std::allocate_shared<bool>(Trinity::NodePoolAllocator<bool>(), true)) { }
 
     // Construct from task and owner
     explicit TaskContext(TaskScheduler::TaskContainer&& task, std::weak_ptr<TaskScheduler>&& owner)
-        : _task(task), _owner(owner), _consumed(std::make_shared<bool>(false)) { }
+        : _task(task), _owner(owner), _consumed(std::allocate_shared<bool>(Trinity::NodePoolAllocator<bool>(), false)) { }
 
     // Copy construct
     TaskContext(TaskContext const& right)
@@ -520,14 +567,14 @@ public:
     /// Its possible that the new event is executed immediately!
     /// Use TaskScheduler::Async to create a task
     /// which will be called at the next update tick.
-    template<class _Rep, class _Period>
+    template<class _Rep, class _Period, typename Handler>
     TaskContext& Schedule(std::chrono::duration<_Rep, _Period> const& time,
-        TaskScheduler::task_handler_t const& task)
+        Handler&& task)
     {
         auto const end = _task->_end;
-        return Dispatch([end, time, task](TaskScheduler& scheduler) -> TaskScheduler&
+        return Dispatch([end, time, &task](TaskScheduler& scheduler) -> TaskScheduler&
         {
-            return scheduler.ScheduleAt<_Rep, _Period>(end, time, task);
+            return scheduler.ScheduleAt<_Rep, _Period>(end, time, std::forward<Handler>(task));
         });
     }
 
@@ -535,14 +582,14 @@ public:
     /// Its possible that the new event is executed immediately!
     /// Use TaskScheduler::Async to create a task
     /// which will be called at the next update tick.
-    template<class _Rep, class _Period>
+    template<class _Rep, class _Period, typename Handler>
     TaskContext& Schedule(std::chrono::duration<_Rep, _Period> const& time,
-        TaskScheduler::group_t const group, TaskScheduler::task_handler_t const& task)
+        TaskScheduler::group_t const group, Handler&& task)
     {
         auto const end = _task->_end;
-        return Dispatch([end, time, group, task](TaskScheduler& scheduler) -> TaskScheduler&
+        return Dispatch([end, time, group, &task](TaskScheduler& scheduler) -> TaskScheduler&
         {
-            return scheduler.ScheduleAt<_Rep, _Period>(end, time, group, task);
+            return scheduler.ScheduleAt<_Rep, _Period>(end, time, group, std::forward<Handler>(task));
         });
     }
 
@@ -550,23 +597,23 @@ public:
     /// Its possible that the new event is executed immediately!
     /// Use TaskScheduler::Async to create a task
     /// which will be called at the next update tick.
-    template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight>
+    template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight, typename Handler>
     TaskContext& Schedule(std::chrono::duration<_RepLeft, _PeriodLeft> const& min,
-        std::chrono::duration<_RepRight, _PeriodRight> const& max, TaskScheduler::task_handler_t const& task)
+        std::chrono::duration<_RepRight, _PeriodRight> const& max, Handler&& task)
     {
-        return Schedule(TaskScheduler::RandomDurationBetween(min, max), task);
+        return Schedule(TaskScheduler::RandomDurationBetween(min, max), std::forward<Handler>(task));
     }
 
     /// Schedule an event with a randomized rate between min and max rate from within the context.
     /// Its possible that the new event is executed immediately!
     /// Use TaskScheduler::Async to create a task
     /// which will be called at the next update tick.
-    template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight>
+    template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight, typename Handler>
     TaskContext& Schedule(std::chrono::duration<_RepLeft, _PeriodLeft> const& min,
         std::chrono::duration<_RepRight, _PeriodRight> const& max, TaskScheduler::group_t const group,
-        TaskScheduler::task_handler_t const& task)
+        Handler&& task)
     {
-        return Schedule(TaskScheduler::RandomDurationBetween(min, max), group, task);
+        return Schedule(TaskScheduler::RandomDurationBetween(min, max), group, std::forward<Handler>(task));
     }
 
     /// Cancels all tasks from within the context.
@@ -0,0 +1,259 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "AIProfiler.h"
+#include "Log.h"
+#include "Object.h"
+#include "ObjectMgr.h"
+#include "World.h"
+#include <algorithm>
+
+void AIProfileStats::Add(AIProfileStats const& other)
+{
+    Calls += other.Calls;
+    TotalNs += other.TotalNs;
+    SelfNs += other.SelfNs;
+    MaxNs = std::max(MaxNs, other.MaxNs);
+}
+
+uint64 AIProfileEntry::GetSelfNs() const
+{
+    uint64 selfNs = 0;
+    for (AIProfileStats const& stats : Stages)
+        selfNs += stats.SelfNs;
+    return selfNs;
+}
+
+std::string AIProfileEntry::GetName() const
+{
+    std::string name;
+    std::string script;
+    if (GameObject)
+    {
+        if (GameObjectTemplate const* goInfo = sObjectMgr->GetGameObjectTemplate(Entry))
+        {
+            name = goInfo->name;
+            script = goInfo->ScriptId ? sObjectMgr->GetScriptName(goInfo->ScriptId) : goInfo->AIName;
+        }
+    }
+    else if (CreatureTemplate const* cInfo = sObjectMgr->GetCreatureTemplate(Entry))
+    {
+        name = cInfo->Name;
+        script = cInfo->ScriptID ? sObjectMgr->GetScriptName(cInfo->ScriptID) : cInfo->AIName;
+    }
+
+    return Trinity::StringFormat("%s %u %s (%s)", GameObject ? "gameobject" : "creature", Entry,
+        name.empty() ? "<unknown>" : name.c_str(), script.empty() ? "no script" : script.c_str());
+}
+
+AIProfiler* AIProfiler::instance()
+{
+    static AIProfiler instance;
+    return &instance;
+}
+
+uint64 AIProfiler::GetKey(WorldObject const* object)
+{
+    return (uint64(object->GetMapId()) << 33) | (uint64(object->GetTypeId() == TYPEID_GAMEOBJECT) << 32) | object->GetEntry();
+}
+
+void AIProfiler::Record(uint64 key, AIProfileStage stage, uint64 totalNs, uint64 childNs)
+{
+    AIProfileStats stats;
+    stats.Calls = 1;
+    stats.TotalNs = totalNs;
+    stats.SelfNs = totalNs > childNs ? totalNs - childNs : 0;
+    stats.MaxNs = totalNs;
+
+    ThreadData& data = _threads.Local();
+    std::lock_guard<std::mutex> lock(data.Lock);
+
+    ThreadEntry& threadEntry = data.Entries[key];
+    for (AIProfileEntry* entry : { &threadEntry.Total, &threadEntry.Interval })
+    {
+        entry->MapId = uint32(key >> 33);
+        entry->GameObject = (key >> 32) & 1;
+        entry->Entry = uint32(key);
+        entry->Stages[stage].Add(stats);
+    }
+}
+
+void AIProfiler::Reset()
+{
+    _threads.ForEach([](ThreadData& data, uint32 /*index*/)
+    {
+        std::lock_guard<std::mutex> dataLock(data.Lock);
+        data.Entries.clear();
+    });
+}
+
+std::vector<AIProfileEntry> AIProfiler::GetTopEntries(uint32 count) const
+{
+    return GetTopEntries(count, &ThreadEntry::Total);
+}
+
+std::vector<AIProfileEntry> AIProfiler::GetTopEntries(uint32 count, AIProfileEntry ThreadEntry::* part) const
+{
+    std::unordered_map<uint64, AIProfileEntry> merged;
+    _threads.ForEach([&merged, part](ThreadData& data, uint32 /*index*/)
+    {
+        std::lock_guard<std::mutex> dataLock(data.Lock);
+        for (auto const& itr : data.Entries)
+        {
+            AIProfileEntry const& threadEntry = itr.second.*part;
+            if (std::none_of(threadEntry.Stages.begin(), threadEntry.Stages.end(), [](AIProfileStats const& stats) { return stats.Calls != 0; }))
+                continue;       // not called during the interval
+
+            AIProfileEntry& entry = merged[itr.first];
+            entry.MapId = threadEntry.MapId;
+            entry.Entry = threadEntry.Entry;
+            entry.GameObject = threadEntry.GameObject;
+            for (uint32 i = 0; i < MAX_AI_PROFILE_STAGES; ++i)
+                entry.Stages[i].Add(threadEntry.Stages[i]);
+        }
+    });
+
+    std::vector<AIProfileEntry> result;
+    result.reserve(merged.size());
+    for (auto const& itr : merged)
+        result.push_back(itr.second);
+
+    std::sort(result.begin(), result.end(), [](AIProfileEntry const& left, AIProfileEntry const& right)
+    {
+        return left.GetSelfNs() > right.GetSelfNs();
+    });
+
+    if (result.size() > count)
+        result.resize(count);
+
+    return result;
+}
+
+void AIProfiler::Update(uint32 diff)
+{
+    uint32 interval = sWorld->getIntConfig(CONFIG_AI_PROFILER_LOG_INTERVAL) * IN_MILLISECONDS;
+    if (!interval || !IsRunning())
+        return;
+
+    _logTimer += diff;
+    if (_logTimer < interval)
+        return;
+
+    _logTimer = 0;
+
+    std::vector<AIProfileEntry> top = GetTopEntries(sWorld->getIntConfig(CONFIG_AI_PROFILER_LOG_COUNT), &ThreadEntry::Interval);
+
+    // every line covers one interval, the totals stay for .debug aiprofile
+    _threads.ForEach([](ThreadData& data, uint32 /*index*/)
+    {
+        std::lock_guard<std::mutex> dataLock(data.Lock);
+        for (auto& itr : data.Entries)
+            itr.second.Interval = AIProfileEntry();
+    });
+
+    if (top.empty())
+        return;
+
+    TC_LOG_INFO("scripts.ai.profiler", "Top %u AI entries of the last %u seconds by self time:", uint32(top.size()), interval / IN_MILLISECONDS);
+    for (AIProfileEntry const& entry : top)
+    {
+        AIProfileStats const& ai = entry.Stages[AI_PROFILE_UPDATE_AI];
+        AIProfileStats const& movement = entry.Stages[AI_PROFILE_MOVEMENT];
+        AIProfileStats const& events = entry.Stages[AI_PROFILE_EVENTS];
+        TC_LOG_INFO("scripts.ai.profiler", "map %u %s: " UI64FMTD " us, ai " UI64FMTD " us (" UI64FMTD " calls, " UI64FMTD " us max), movement " UI64FMTD " us, events " UI64FMTD " us (" UI64FMTD " calls, " UI64FMTD " us max)",
+            entry.MapId, entry.GetName().c_str(), entry.GetSelfNs() / 1000, ai.SelfNs / 1000, ai.Calls, ai.MaxNs / 1000,
+            movement.SelfNs / 1000, events.SelfNs / 1000, events.Calls, events.MaxNs / 1000);
+    }
+}
+
+void AIProfiler::OnTaskBegin()
+{
+    if (AIProfileScope* scope = AIProfileScope::Current())
+        scope->EventBoundary(true);
+}
+
+void AIProfiler::OnTaskEnd()
+{
+    if (AIProfileScope* scope = AIProfileScope::Current())
+        scope->EventBoundary(false);
+}
+
+char const* AIProfiler::GetStageName(AIProfileStage stage)
+{
+    switch (stage)
+    {
+        case AI_PROFILE_UPDATE_AI:  return "UpdateAI";
+        case AI_PROFILE_MOVEMENT:   return "movement";
+        case AI_PROFILE_EVENTS:     return "events";
+        default:                    return "unknown";
+    }
+}
+
+void AIProfileScope::Begin(WorldObject const* object, AIProfileStage stage)
+{
+    _active = true;
+    _inEvent = false;
+    _stage = stage;
+    _key = AIProfiler::GetKey(object);
+    _childNs = 0;
+    _parent = Current();
+    Current() = this;
+    _previousObserver = TaskSchedulerObserver::Current();
+    TaskSchedulerObserver::Current() = sAIProfiler;
+    _start = std::chrono::steady_clock::now();
+}
+
+void AIProfileScope::End()
+{
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    if (_inEvent)
+        EndEvent(end);
+
+    Current() = _parent;
+    TaskSchedulerObserver::Current() = _previousObserver;
+
+    uint64 totalNs = uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(end - _start).count());
+    if (_parent)
+        _parent->_childNs += totalNs;
+
+    sAIProfiler->Record(_key, _stage, totalNs, _childNs);
+}
+
+void AIProfileScope::EventBoundary(bool hasEvent)
+{
+    if (!_inEvent && !hasEvent)
+        return;
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (_inEvent)
+        EndEvent(now);
+
+    if (hasEvent)
+    {
+        _inEvent = true;
+        _eventStart = now;
+    }
+}
+
+void AIProfileScope::EndEvent(std::chrono::steady_clock::time_point now)
+{
+    _inEvent = false;
+
+    uint64 eventNs = uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(now - _eventStart).count());
+    _childNs += eventNs;
+    sAIProfiler->Record(_key, AI_PROFILE_EVENTS, eventNs, 0);
+}
@@ -0,0 +1,168 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TRINITY_AIPROFILER_H
+#define TRINITY_AIPROFILER_H
+
+#include "Define.h"
+#include "PerThreadRegistry.h"
+#include "TaskScheduler.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class WorldObject;
+
+enum AIProfileStage : uint8
+{
+    AI_PROFILE_UPDATE_AI,       // UpdateAI of the creature or gameobject AI
+    AI_PROFILE_MOVEMENT,        // movement generators of the creature
+    AI_PROFILE_EVENTS,          // EventMap events and TaskScheduler tasks run by the AI
+    MAX_AI_PROFILE_STAGES
+};
+
+struct AIProfileStats
+{
+    uint64 Calls = 0;
+    uint64 TotalNs = 0;     // including nested stages
+    uint64 SelfNs = 0;      // without nested stages
+    uint64 MaxNs = 0;
+
+    void Add(AIProfileStats const& other);
+};
+
+struct AIProfileEntry
+{
+    uint32 MapId = 0;
+    uint32 Entry = 0;
+    bool GameObject = false;
+    std::array<AIProfileStats, MAX_AI_PROFILE_STAGES> Stages;
+
+    uint64 GetSelfNs() const;
+    // "creature 1234 name (script)" for reports, resolved from the templates
+    std::string GetName() const;
+};
+
+// time spent in the AI, movement and scripted events of creatures and gameobjects, per map and entry
+class TC_GAME_API AIProfiler : public TaskSchedulerObserver
+{
+    typedef std::chrono::steady_clock Clock;
+
+    struct ThreadEntry
+    {
+        AIProfileEntry Total;       // since the profiler was reset, reported by .debug aiprofile
+        AIProfileEntry Interval;    // since the last log line
+    };
+
+    struct ThreadData
+    {
+        std::mutex Lock;
+        std::unordered_map<uint64, ThreadEntry> Entries;
+    };
+
+    public:
+        static AIProfiler* instance();
+
+        void Start() { _running = true; }
+        void Stop() { _running = false; }
+        bool IsRunning() const { return _running.load(std::memory_order_relaxed); }
+        void Reset();
+
+        void Record(uint64 key, AIProfileStage stage, uint64 totalNs, uint64 childNs);
+        // map id, gameobject flag and entry of the object
+        static uint64 GetKey(WorldObject const* object);
+
+        std::vector<AIProfileEntry> GetTopEntries(uint32 count) const;
+
+        // world thread, writes the top entries to the scripts.ai.profiler log every AIProfiler.LogInterval
+        void Update(uint32 diff);
+
+        static char const* GetStageName(AIProfileStage stage);
+
+    private:
+        AIProfiler() : _running(false), _logTimer(0) { }
+        ~AIProfiler() { }
+
+        void OnTaskBegin() override;
+        void OnTaskEnd() override;
+
+        std::vector<AIProfileEntry> GetTopEntries(uint32 count, AIProfileEntry ThreadEntry::* part) const;
+
+        Trinity::PerThreadRegistry<ThreadData> _threads;
+
+        std::atomic<bool> _running;
+        uint32 _logTimer;
+};
+
+#define sAIProfiler AIProfiler::instance()
+
+// times the enclosing block as one stage of the object, inactive for null objects or while the profiler is stopped
+class TC_GAME_API AIProfileScope
+{
+    public:
+        AIProfileScope(WorldObject const* object, AIProfileStage stage) : _active(false)
+        {
+            if (object && sAIProfiler->IsRunning())
+                Begin(object, stage);
+        }
+
+        ~AIProfileScope()
+        {
+            if (_active)
+                End();
+        }
+
+        AIProfileScope(AIProfileScope const&) = delete;
+        AIProfileScope& operator=(AIProfileScope const&) = delete;
+
+        // called by EventMap::ExecuteEvent, an event runs until the AI asks for the next one
+        static void OnEventExecuted(bool hasEvent)
+        {
+            if (AIProfileScope* scope = Current())
+                scope->EventBoundary(hasEvent);
+        }
+
+    private:
+        friend class AIProfiler;
+
+        static AIProfileScope*& Current()
+        {
+            thread_local AIProfileScope* current = nullptr;
+            return current;
+        }
+
+        void Begin(WorldObject const* object, AIProfileStage stage);
+        void End();
+        void EventBoundary(bool hasEvent);
+        void EndEvent(std::chrono::steady_clock::time_point now);
+
+        bool _active;
+        bool _inEvent;
+        AIProfileStage _stage;
+        uint64 _key;
+        uint64 _childNs;
+        AIProfileScope* _parent;
+        TaskSchedulerObserver* _previousObserver;
+        std::chrono::steady_clock::time_point _start;
+        std::chrono::steady_clock::time_point _eventStart;
+};
+
+#endif
@@ -18,6 +18,7 @@
 #ifndef CREATUREAIIMPL_H
 #define CREATUREAIIMPL_H
 
+#include "AIProfiler.h"
 #include "Common.h"
 #include "Define.h"
 #include "Duration.h"
@@ -558,17 +559,19 @@ class EventMap
                 EventStore::iterator itr = _eventMap.begin();
 
                 if (itr->first > _time)
-                    return 0;
+                    break;
                 else if (_phase && (itr->second & 0xFF000000) && !((itr->second >> 24) & _phase))
                     _eventMap.erase(itr);
                 else
                 {
                     uint32 eventId = (itr->second & 0x0000FFFF);
                     _eventMap.erase(itr);
+                    AIProfileScope::OnEventExecuted(true);
                     return eventId;
                 }
             }
 
+            AIProfileScope::OnEventExecuted(false);
             return 0;
         }
 
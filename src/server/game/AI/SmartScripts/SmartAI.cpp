@@ -261,6 +261,8 @@ void SmartAI::EndPath(bool fail)
             }
         }
     }
+    GetScript()->ReleaseTargetList(targets);
+
     if (mDespawnState == 1)
         StartDespawn();
 }
@@ -403,7 +405,10 @@ bool SmartAI::IsEscortInvokerInRange()
         {
             Player* player = (*targets->begin())->ToPlayer();
             if (me->GetDistance(player) <= SMART_ESCORT_MAX_PLAYER_DIST)
-                        return true;
+            {
+                GetScript()->ReleaseTargetList(targets);
+                return true;
+            }
 
             if (Group* group = player->GetGroup())
             {
@@ -412,7 +417,10 @@ bool SmartAI::IsEscortInvokerInRange()
                     Player* groupGuy = groupRef->GetSource();
 
                     if (me->GetDistance(groupGuy) <= SMART_ESCORT_MAX_PLAYER_DIST)
+                    {
+                        GetScript()->ReleaseTargetList(targets);
                         return true;
+                    }
                 }
             }
         }else
@@ -422,10 +430,15 @@ bool SmartAI::IsEscortInvokerInRange()
                 if (GetScript()->IsPlayer((*iter)))
                 {
                     if (me->GetDistance((*iter)->ToPlayer()) <= SMART_ESCORT_MAX_PLAYER_DIST)
+                    {
+                        GetScript()->ReleaseTargetList(targets);
                         return true;
+                    }
                 }
             }
         }
+
+        GetScript()->ReleaseTargetList(targets);
     }
     return true;//escort targets were not set, ignore range check
 }
@@ -56,12 +56,56 @@ SmartScript::SmartScript()
     goOrigGUID.Clear();
     mLastInvoker = ObjectGuid::Empty;
     mScriptType = SMART_SCRIPT_TYPE_CREATURE;
+    mEventTypeOffsets.fill(0);
+    mProfileDepth = 0;
 }
 
 SmartScript::~SmartScript()
 {
     delete mTargetStorage;
     mCounterList.clear();
+
+    for (ObjectList* targets : mFreeTargetLists)
+        delete targets;
+}
+
+// attributes the time of the outermost update or event of a script to its entry while SmartAI profiling is on
+class SmartScriptCostScope
+{
+    public:
+        SmartScriptCostScope(SmartScript* script, bool update) : _script(script), _update(update),
+            _timed(!script->mProfileDepth++ && sSmartScriptMgr->IsProfiling())
+        {
+            if (_timed)
+                _start = std::chrono::steady_clock::now();
+        }
+
+        ~SmartScriptCostScope()
+        {
+            --_script->mProfileDepth;
+            if (_timed)
+                sSmartScriptMgr->RecordCost(_script->mScriptType, _script->GetProfileEntry(), _update, std::chrono::steady_clock::now() - _start);
+        }
+
+        SmartScriptCostScope(SmartScriptCostScope const&) = delete;
+        SmartScriptCostScope& operator=(SmartScriptCostScope const&) = delete;
+
+    private:
+        SmartScript* _script;
+        bool _update;
+        bool _timed;
+        std::chrono::steady_clock::time_point _start;
+};
+
+int32 SmartScript::GetProfileEntry() const
+{
+    if (me)
+        return int32(me->GetEntry());
+    if (go)
+        return int32(go->GetEntry());
+    if (trigger)
+        return int32(trigger->ID);
+    return 0;
 }
 
 void SmartScript::OnReset()
@@ -83,17 +127,18 @@ void SmartScript::OnReset()
 
 void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
-    {
-        SMART_EVENT eventType = SMART_EVENT((*i).GetEventType());
-        if (eventType == SMART_EVENT_LINK)//special handling
-            continue;
+    // links are only processed through the event linking to them
+    if (e == SMART_EVENT_LINK || e >= SMART_EVENT_END || mEventTypeOffsets[e] == mEventTypeOffsets[e + 1])
+        return;
 
-        if (eventType == e/* && (!(*i).event.event_phase_mask || IsInPhase((*i).event.event_phase_mask)) && !((*i).event.event_flags & SMART_EVENT_FLAG_NOT_REPEATABLE && (*i).runOnce)*/)
-        {
-            if (sConditionMgr->IsObjectMeetingSmartEventConditions(i->entryOrGuid, i->event_id, i->source_type, unit, GetBaseObject()))
-                ProcessEvent(*i, unit, var0, var1, bvar, spell, gob);
-        }
+    SmartScriptCostScope costScope(this, false);
+
+    // offsets are read on every iteration, the index is rebuilt if new events get installed
+    for (uint32 i = mEventTypeOffsets[e]; i < mEventTypeOffsets[e + 1]; ++i)
+    {
+        SmartScriptHolder& holder = mEvents[mEventsByType[i]];
+        if (sConditionMgr->IsObjectMeetingSmartEventConditions(holder.entryOrGuid, holder.event_id, holder.source_type, unit, GetBaseObject()))
+            ProcessEvent(holder, unit, var0, var1, bvar, spell, gob);
     }
 }
 
@@ -145,7 +190,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
 
             if (!talkTarget)
@@ -181,7 +226,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         (*itr)->GetName().c_str(), (*itr)->GetGUID().GetCounter(), uint8(e.action.talk.textGroupID));
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -200,7 +245,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -223,7 +268,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -257,7 +302,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -301,7 +346,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_FAIL_QUEST:
@@ -320,7 +365,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_ADD_QUEST:
@@ -340,7 +385,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_REACT_STATE:
@@ -379,7 +424,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 
             if (count == 0)
             {
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
 
@@ -394,7 +439,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_THREAT_ALL_PCT:
@@ -433,7 +478,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_CALL_AREAEXPLOREDOREVENTHAPPENS:
@@ -459,7 +504,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_CAST:
@@ -515,7 +560,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     TC_LOG_DEBUG("scripts.ai", "Spell %u not casted because it has flag SMARTCAST_AURA_NOT_PRESENT and the target (Guid: " UI64FMTD " Entry: %u Type: %u) already has the aura", e.action.cast.spell, (*itr)->GetGUID().GetRawValue(), (*itr)->GetEntry(), uint32((*itr)->GetTypeId()));
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_INVOKER_CAST:
@@ -546,7 +591,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                         TC_LOG_DEBUG("scripts.ai", "Spell %u not casted because it has flag SMARTCAST_AURA_NOT_PRESENT and the target (Guid: " UI64FMTD " Entry: %u Type: %u) already has the aura", e.action.cast.spell, (*itr)->GetGUID().GetRawValue(), (*itr)->GetEntry(), uint32((*itr)->GetTypeId()));
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_ADD_AURA:
@@ -565,7 +610,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_ACTIVATE_GOBJECT:
@@ -586,7 +631,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_RESET_GOBJECT:
@@ -605,7 +650,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_EMOTE_STATE:
@@ -624,7 +669,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_UNIT_FLAG:
@@ -652,7 +697,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_UNIT_FLAG:
@@ -680,7 +725,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_AUTO_ATTACK:
@@ -787,7 +832,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->GetGUID().GetCounter(), e.action.removeAura.spell);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_FOLLOW:
@@ -813,7 +858,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_RANDOM_PHASE:
@@ -896,7 +941,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                                         e.action.killedMonster.countMax ? urand(e.action.killedMonster.countMin, e.action.killedMonster.countMax) : (e.action.killedMonster.countMin ? e.action.killedMonster.countMin : 1));
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -945,7 +990,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             TC_LOG_DEBUG("scripts.ai", "SmartScript::ProcessAction: SMART_ACTION_SET_INST_DATA64: Field: %u, data: " UI64FMTD,
                 e.action.setInstanceData64.field, targets->front()->GetGUID().GetRawValue());
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_UPDATE_TEMPLATE:
@@ -1049,7 +1094,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToUnit()->Dismount();
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_INVINCIBILITY_HP_LEVEL:
@@ -1082,7 +1127,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToGameObject()->AI()->SetData(e.action.setData.field, e.action.setData.data);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_MOVE_OFFSET:
@@ -1105,7 +1150,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToCreature()->GetMotionMaster()->MovePoint(SMART_RANDOM_POINT, x, y, z);
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -1139,7 +1184,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SUMMON_CREATURE:
@@ -1160,7 +1205,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                             summon->AI()->AttackStart((*itr)->ToUnit());
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
 
             if (e.GetTargetType() != SMART_TARGET_POSITION)
@@ -1193,7 +1238,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     GetBaseObject()->SummonGameObject(e.action.summonGO.entry, x, y, z, o, { }, e.action.summonGO.despawnTime, GOSummonType(e.action.summonGO.summonType));
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
 
             if (e.GetTargetType() != SMART_TARGET_POSITION)
@@ -1216,7 +1261,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 (*itr)->ToUnit()->Kill((*itr)->ToUnit());
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_INSTALL_AI_TEMPLATE:
@@ -1238,7 +1283,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 (*itr)->ToPlayer()->AddItem(e.action.item.entry, e.action.item.count);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_ITEM:
@@ -1255,14 +1300,14 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 (*itr)->ToPlayer()->DestroyItemCount(e.action.item.entry, e.action.item.count, true);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_STORE_TARGET_LIST:
         {
             ObjectList* targets = GetTargets(e, unit);
             StoreTargetList(targets, e.action.storeTargets.id);
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_TELEPORT:
@@ -1279,7 +1324,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToCreature()->NearTeleportTo(e.target.x, e.target.y, e.target.z, e.target.o);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_FLY:
@@ -1321,6 +1366,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             bool repeat = e.action.wpStart.repeat;
             ObjectList* targets = GetTargets(e, unit);
             StoreTargetList(targets, SMART_ESCORT_TARGETS);
+            ReleaseTargetList(targets);
             me->SetReactState((ReactStates)e.action.wpStart.reactState);
             CAST_AI(SmartAI, me->AI())->StartPath(run, entry, repeat, unit);
 
@@ -1372,7 +1418,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (!targets->empty())
                     me->SetFacingToObject(*targets->begin());
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
 
             break;
@@ -1391,7 +1437,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 (*itr)->ToPlayer()->SendMovieStart(e.action.movie.entry);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_MOVE_TO_POS:
@@ -1413,7 +1459,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     break;
 
                 target = targets->front();
-                delete targets;
+                ReleaseTargetList(targets);
             }
 
             if (!target)
@@ -1443,7 +1489,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToGameObject()->SetRespawnTime(e.action.RespawnTarget.goRespawnTime);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_CLOSE_GOSSIP:
@@ -1456,7 +1502,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsPlayer(*itr))
                     (*itr)->ToPlayer()->PlayerTalkClass->SendCloseGossip();
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_EQUIP:
@@ -1500,7 +1546,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_CREATE_TIMED_EVENT:
@@ -1568,7 +1614,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_RESET_SCRIPT_BASE_OBJECT:
@@ -1594,7 +1640,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                             if (CAST_AI(SmartAI, target->AI())->CanCombatMove())
                                 target->GetMotionMaster()->MoveChase(target->GetVictim(), attackDistance, attackAngle);
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -1622,7 +1668,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -1636,7 +1682,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetUInt32Value(UNIT_FIELD_NPC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_ADD_NPC_FLAG:
@@ -1649,7 +1695,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetFlag(UNIT_FIELD_NPC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_NPC_FLAG:
@@ -1662,7 +1708,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->RemoveFlag(UNIT_FIELD_NPC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_CROSS_CAST:
@@ -1674,7 +1720,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             ObjectList* targets = GetTargets(e, unit);
             if (!targets)
             {
-                delete casters; // casters already validated, delete now
+                ReleaseTargetList(casters); // casters already validated, release now
                 break;
             }
 
@@ -1705,8 +1751,8 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
-            delete casters;
+            ReleaseTargetList(targets);
+            ReleaseTargetList(casters);
             break;
         }
         case SMART_ACTION_CALL_RANDOM_TIMED_ACTIONLIST:
@@ -1756,7 +1802,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -1786,7 +1832,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -1800,7 +1846,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsPlayer(*itr))
                     (*itr)->ToPlayer()->ActivateTaxiPathTo(e.action.taxi.id);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_RANDOM_MOVE:
@@ -1832,7 +1878,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     me->GetMotionMaster()->MoveIdle();
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_UNIT_FIELD_BYTES_1:
@@ -1844,7 +1890,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetByteFlag(UNIT_FIELD_BYTES_1, e.action.setunitByte.type, e.action.setunitByte.byte1);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_UNIT_FIELD_BYTES_1:
@@ -1857,7 +1903,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->RemoveByteFlag(UNIT_FIELD_BYTES_1, e.action.delunitByte.type, e.action.delunitByte.byte1);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_INTERRUPT_SPELL:
@@ -1870,7 +1916,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->InterruptNonMeleeSpells(e.action.interruptSpellCasting.withDelayed, e.action.interruptSpellCasting.spell_id, e.action.interruptSpellCasting.withInstant);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SEND_GO_CUSTOM_ANIM:
@@ -1883,7 +1929,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsGameObject(*itr))
                     (*itr)->ToGameObject()->SendCustomAnim(e.action.sendGoCustomAnim.anim);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_DYNAMIC_FLAG:
@@ -1896,7 +1942,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetUInt32Value(OBJECT_FIELD_DYNAMIC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_ADD_DYNAMIC_FLAG:
@@ -1909,7 +1955,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->SetFlag(OBJECT_FIELD_DYNAMIC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_DYNAMIC_FLAG:
@@ -1922,7 +1968,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsUnit(*itr))
                     (*itr)->ToUnit()->RemoveFlag(OBJECT_FIELD_DYNAMIC_FLAGS, e.action.unitFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_JUMP_TO_POS:
@@ -1941,7 +1987,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             }
             /// @todo Resume path when reached jump location
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_GO_SET_LOOT_STATE:
@@ -1955,7 +2001,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsGameObject(*itr))
                     (*itr)->ToGameObject()->SetLootState((LootState)e.action.setGoLootState.state);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SEND_TARGET_TO_TARGET:
@@ -1967,7 +2013,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             ObjectList* storedTargets = GetTargetList(e.action.sendTargetToTarget.id, unit);
             if (!storedTargets)
             {
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
 
@@ -1976,20 +2022,21 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsCreature(*itr))
                 {
                     if (SmartAI* ai = CAST_AI(SmartAI, (*itr)->ToCreature()->AI()))
-                        ai->GetScript()->StoreTargetList(new ObjectList(*storedTargets), e.action.sendTargetToTarget.id);   // store a copy of target list
+                        ai->GetScript()->StoreTargetList(storedTargets, e.action.sendTargetToTarget.id);   // stores a copy of target list
                     else
                         TC_LOG_ERROR("sql.sql", "SmartScript: Action target for SMART_ACTION_SEND_TARGET_TO_TARGET is not using SmartAI, skipping");
                 }
                 else if (IsGameObject(*itr))
                 {
                     if (SmartGameObjectAI* ai = CAST_AI(SmartGameObjectAI, (*itr)->ToGameObject()->AI()))
-                        ai->GetScript()->StoreTargetList(new ObjectList(*storedTargets), e.action.sendTargetToTarget.id);   // store a copy of target list
+                        ai->GetScript()->StoreTargetList(storedTargets, e.action.sendTargetToTarget.id);   // stores a copy of target list
                     else
                         TC_LOG_ERROR("sql.sql", "SmartScript: Action target for SMART_ACTION_SEND_TARGET_TO_TARGET is not using SmartGameObjectAI, skipping");
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(storedTargets);
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SEND_GOSSIP_MENU:
@@ -2023,7 +2070,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_HOME_POS:
@@ -2054,7 +2101,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_HEALTH_REGEN:
@@ -2067,7 +2114,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsCreature(*itr))
                     (*itr)->ToCreature()->setRegeneratingHealth(e.action.setHealthRegen.regenHealth);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_ROOT:
@@ -2080,7 +2127,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsCreature(*itr))
                     (*itr)->ToCreature()->SetControlled(e.action.setRoot.root, UNIT_STATE_ROOT);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_GO_FLAG:
@@ -2093,7 +2140,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsGameObject(*itr))
                     (*itr)->ToGameObject()->SetUInt32Value(GAMEOBJECT_FIELD_FLAGS, e.action.goFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_ADD_GO_FLAG:
@@ -2106,7 +2153,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsGameObject(*itr))
                     (*itr)->ToGameObject()->SetFlag(GAMEOBJECT_FIELD_FLAGS, e.action.goFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_GO_FLAG:
@@ -2119,7 +2166,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsGameObject(*itr))
                     (*itr)->ToGameObject()->RemoveFlag(GAMEOBJECT_FIELD_FLAGS, e.action.goFlag.flag);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SUMMON_CREATURE_GROUP:
@@ -2142,7 +2189,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->SetPower(Powers(e.action.power.powerType), e.action.power.newPower);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_ADD_POWER:
@@ -2154,7 +2201,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->SetPower(Powers(e.action.power.powerType), (*itr)->ToUnit()->GetPower(Powers(e.action.power.powerType)) + e.action.power.newPower);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_REMOVE_POWER:
@@ -2166,7 +2213,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     if (IsUnit(*itr))
                         (*itr)->ToUnit()->SetPower(Powers(e.action.power.powerType), (*itr)->ToUnit()->GetPower(Powers(e.action.power.powerType)) - e.action.power.newPower);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_GAME_EVENT_STOP:
@@ -2245,7 +2292,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
             }
             break;
         }
@@ -2274,7 +2321,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     }
                 }
 
-                delete targets;
+                ReleaseTargetList(targets);
                 break;
             }
         }
@@ -2290,7 +2337,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToCreature()->SetCorpseDelay(e.action.corpseDelay.timer);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_DISABLE_EVADE:
@@ -2330,7 +2377,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_PLAY_SCENE_ID:
@@ -2356,7 +2403,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToPlayer()->GetSceneMgr().CancelSceneByPackageId(sceneTemplate->ScenePackageId);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_PLAY_SCENE_PACKAGE:
@@ -2382,7 +2429,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToPlayer()->GetSceneMgr().CancelSceneByPackageId(packageID);
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_COMBAT_STOP:
@@ -2397,7 +2444,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     (*itr)->ToCreature()->CombatStop();
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_OVERRIDE_INHABIT_TYPE:
@@ -2415,7 +2462,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_STOP_FOLLOW:
@@ -2505,7 +2552,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     TC_LOG_DEBUG("scripts.ai", "Spell %u not casted because it has flag SMARTCAST_AURA_NOT_PRESENT and the target (Guid: " UI64FMTD " Entry: %u Type: %u) already has the aura", e.action.cast.spell, (*itr)->GetGUID().GetRawValue(), (*itr)->GetEntry(), uint32((*itr)->GetTypeId()));
             }
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         case SMART_ACTION_SET_INGAME_PHASE_ID:
@@ -2518,7 +2565,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             for (ObjectList::const_iterator itr = targets->begin(); itr != targets->end(); ++itr)
                 (*itr)->ToUnit()->SetPhased(e.action.ingamePhaseId.id, true, e.action.ingamePhaseId.apply);
 
-            delete targets;
+            ReleaseTargetList(targets);
             break;
         }
         default:
@@ -2665,7 +2712,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
 
     WorldObject* baseObject = GetBaseObject();
 
-    ObjectList* l = new ObjectList();
+    ObjectList* l = AcquireTargetList();
     switch (e.GetTargetType())
     {
         case SMART_TARGET_SELF:
@@ -2740,7 +2787,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                     l->push_back(*itr);
             }
 
-            delete units;
+            ReleaseTargetList(units);
             break;
         }
         case SMART_TARGET_CREATURE_DISTANCE:
@@ -2759,7 +2806,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                     l->push_back(*itr);
             }
 
-            delete units;
+            ReleaseTargetList(units);
             break;
         }
         case SMART_TARGET_GAMEOBJECT_DISTANCE:
@@ -2778,7 +2825,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                     l->push_back(*itr);
             }
 
-            delete units;
+            ReleaseTargetList(units);
             break;
         }
         case SMART_TARGET_GAMEOBJECT_RANGE:
@@ -2797,7 +2844,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                     l->push_back(*itr);
             }
 
-            delete units;
+            ReleaseTargetList(units);
             break;
         }
         case SMART_TARGET_CREATURE_GUID:
@@ -2839,7 +2886,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                     if (IsPlayer(*itr) && baseObject->IsInRange(*itr, (float)e.target.playerRange.minDist, (float)e.target.playerRange.maxDist))
                         l->push_back(*itr);
 
-            delete units;
+            ReleaseTargetList(units);
             break;
         }
         case SMART_TARGET_PLAYER_DISTANCE:
@@ -2850,7 +2897,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
                 if (IsPlayer(*itr))
                     l->push_back(*itr);
 
-            delete units;
+            ReleaseTargetList(units);
             break;
         }
         case SMART_TARGET_STORED:
@@ -2967,7 +3014,7 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
 
     if (l->empty())
     {
-        delete l;
+        ReleaseTargetList(l);
         l = NULL;
     }
 
@@ -2976,17 +3023,48 @@ ObjectList* SmartScript::GetTargets(SmartScriptHolder const& e, Unit* invoker /*
 
 ObjectList* SmartScript::GetWorldObjectsInDist(float dist)
 {
-    ObjectList* targets = new ObjectList();
+    ObjectList* targets = AcquireTargetList();
     WorldObject* obj = GetBaseObject();
     if (obj)
     {
         Trinity::AllWorldObjectsInRange u_check(obj, dist);
-        Trinity::WorldObjectListSearcher<Trinity::AllWorldObjectsInRange> searcher(obj, *targets, u_check);
-        obj->VisitNearbyObject(dist, searcher);
+        auto collect = [&u_check, targets](WorldObject* target)
+        {
+            if (u_check(target))
+                targets->push_back(target);
+        };
+        Trinity::WorldObjectWorker<decltype(collect)> worker(obj, collect);
+        obj->VisitNearbyObject(dist, worker);
     }
     return targets;
 }
 
+ObjectList* SmartScript::AcquireTargetList()
+{
+    if (mFreeTargetLists.empty())
+        return new ObjectList();
+
+    ObjectList* targets = mFreeTargetLists.back();
+    mFreeTargetLists.pop_back();
+    return targets;
+}
+
+void SmartScript::ReleaseTargetList(ObjectList* targets)
+{
+    if (!targets)
+        return;
+
+    // a handful of lists cover the nesting of linked events, keep their buffers for the next action
+    if (mFreeTargetLists.size() >= 8)
+    {
+        delete targets;
+        return;
+    }
+
+    targets->clear();
+    mFreeTargetLists.push_back(targets);
+}
+
 void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
     if (!e.active && e.GetEventType() != SMART_EVENT_LINK)
@@ -3483,7 +3561,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
                 }
             }
 
-            delete _targets;
+            ReleaseTargetList(_targets);
 
             if (!target)
                 return;
@@ -3587,6 +3665,81 @@ void SmartScript::RecalcTimer(SmartScriptHolder& e, uint32 min, uint32 max)
     // min/max was checked at loading!
     e.timer = urand(uint32(min), uint32(max));
     e.active = e.timer ? false : true;
+
+    if (!e.active && !IsTimedEvent(e.GetEventType()))
+        StartCooldown(e);
+}
+
+void SmartScript::StartCooldown(SmartScriptHolder const& e)
+{
+    // stored events, timed action lists and event copies are not indexed, they are updated as a whole
+    if (e.GetEventType() == SMART_EVENT_LINK || mEvents.empty() || std::less<SmartScriptHolder const*>()(&e, mEvents.data()) || !std::less<SmartScriptHolder const*>()(&e, mEvents.data() + mEvents.size()))
+        return;
+
+    uint32 index = uint32(&e - mEvents.data());
+    if (std::find(mCooldownEvents.begin(), mCooldownEvents.end(), index) == mCooldownEvents.end())
+        mCooldownEvents.push_back(index);
+}
+
+bool SmartScript::IsTimedEvent(uint32 eventType)
+{
+    switch (eventType)
+    {
+        case SMART_EVENT_UPDATE:
+        case SMART_EVENT_UPDATE_OOC:
+        case SMART_EVENT_UPDATE_IC:
+        case SMART_EVENT_HEALTH_PCT:
+        case SMART_EVENT_TARGET_HEALTH_PCT:
+        case SMART_EVENT_MANA_PCT:
+        case SMART_EVENT_TARGET_MANA_PCT:
+        case SMART_EVENT_RANGE:
+        case SMART_EVENT_VICTIM_CASTING:
+        case SMART_EVENT_FRIENDLY_HEALTH:
+        case SMART_EVENT_FRIENDLY_IS_CC:
+        case SMART_EVENT_FRIENDLY_MISSING_BUFF:
+        case SMART_EVENT_HAS_AURA:
+        case SMART_EVENT_TARGET_BUFFED:
+        case SMART_EVENT_IS_BEHIND_TARGET:
+        case SMART_EVENT_FRIENDLY_HEALTH_PCT:
+        case SMART_EVENT_DISTANCE_CREATURE:
+        case SMART_EVENT_DISTANCE_GAMEOBJECT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void SmartScript::RebuildEventIndex()
+{
+    mEventTypeOffsets.fill(0);
+    mTimedEvents.clear();
+
+    for (uint32 i = 0; i < mEvents.size(); ++i)
+    {
+        uint32 eventType = mEvents[i].GetEventType();
+        if (eventType == SMART_EVENT_LINK || eventType >= SMART_EVENT_END)
+            continue;
+
+        ++mEventTypeOffsets[eventType + 1];
+        if (IsTimedEvent(eventType))
+            mTimedEvents.push_back(i);
+        else if (!mEvents[i].active)
+            StartCooldown(mEvents[i]);      // activated by their first UpdateTimer
+    }
+
+    for (uint32 eventType = 0; eventType < SMART_EVENT_END; ++eventType)
+        mEventTypeOffsets[eventType + 1] += mEventTypeOffsets[eventType];
+
+    std::array<uint32, SMART_EVENT_END> next;
+    std::copy(mEventTypeOffsets.begin(), mEventTypeOffsets.end() - 1, next.begin());
+
+    mEventsByType.resize(mEventTypeOffsets[SMART_EVENT_END]);
+    for (uint32 i = 0; i < mEvents.size(); ++i)
+    {
+        uint32 eventType = mEvents[i].GetEventType();
+        if (eventType != SMART_EVENT_LINK && eventType < SMART_EVENT_END)
+            mEventsByType[next[eventType]++] = i;
+    }
 }
 
 void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
@@ -3619,42 +3772,21 @@ void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
         }
 
         e.active = true;//activate events with cooldown
-        switch (e.GetEventType())//process ONLY timed events
-        {
-            case SMART_EVENT_UPDATE:
-            case SMART_EVENT_UPDATE_OOC:
-            case SMART_EVENT_UPDATE_IC:
-            case SMART_EVENT_HEALTH_PCT:
-            case SMART_EVENT_TARGET_HEALTH_PCT:
-            case SMART_EVENT_MANA_PCT:
-            case SMART_EVENT_TARGET_MANA_PCT:
-            case SMART_EVENT_RANGE:
-            case SMART_EVENT_VICTIM_CASTING:
-            case SMART_EVENT_FRIENDLY_HEALTH:
-            case SMART_EVENT_FRIENDLY_IS_CC:
-            case SMART_EVENT_FRIENDLY_MISSING_BUFF:
-            case SMART_EVENT_HAS_AURA:
-            case SMART_EVENT_TARGET_BUFFED:
-            case SMART_EVENT_IS_BEHIND_TARGET:
-            case SMART_EVENT_FRIENDLY_HEALTH_PCT:
-            case SMART_EVENT_DISTANCE_CREATURE:
-            case SMART_EVENT_DISTANCE_GAMEOBJECT:
-            {
-                ProcessEvent(e);
-                if (e.GetScriptType() == SMART_SCRIPT_TYPE_TIMED_ACTIONLIST)
+        if (IsTimedEvent(e.GetEventType()))//process ONLY timed events
+        {
+            ProcessEvent(e);
+            if (e.GetScriptType() == SMART_SCRIPT_TYPE_TIMED_ACTIONLIST)
+            {
+                e.enableTimed = false;//disable event if it is in an ActionList and was processed once
+                for (SmartAIEventList::iterator i = mTimedActionList.begin(); i != mTimedActionList.end(); ++i)
                 {
-                    e.enableTimed = false;//disable event if it is in an ActionList and was processed once
-                    for (SmartAIEventList::iterator i = mTimedActionList.begin(); i != mTimedActionList.end(); ++i)
+                    //find the first event which is not the current one and enable it
+                    if (i->event_id > e.event_id)
                     {
-                        //find the first event which is not the current one and enable it
-                        if (i->event_id > e.event_id)
-                        {
-                            i->enableTimed = true;
-                            break;
-                        }
+                        i->enableTimed = true;
+                        break;
                     }
                 }
-                break;
             }
         }
     }
@@ -3675,6 +3807,7 @@ void SmartScript::InstallEvents()
             mEvents.push_back(*i);//must be before UpdateTimers
 
         mInstallEvents.clear();
+        RebuildEventIndex();
     }
 }
 
@@ -3683,10 +3816,26 @@ void SmartScript::OnUpdate(uint32 const diff)
     if ((mScriptType == SMART_SCRIPT_TYPE_CREATURE || mScriptType == SMART_SCRIPT_TYPE_GAMEOBJECT) && !GetBaseObject())
         return;
 
+    SmartScriptCostScope costScope(this, true);
+
     InstallEvents();//before UpdateTimers
 
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
-        UpdateTimer(*i, diff);
+    // only timed events and the ones on cooldown have a timer to update
+    for (uint32 i = 0; i < mTimedEvents.size(); ++i)
+        UpdateTimer(mEvents[mTimedEvents[i]], diff);
+
+    for (uint32 i = 0; i < mCooldownEvents.size();)
+    {
+        SmartScriptHolder& e = mEvents[mCooldownEvents[i]];
+        UpdateTimer(e, diff);
+        if (e.active)
+        {
+            mCooldownEvents[i] = mCooldownEvents.back();
+            mCooldownEvents.pop_back();
+        }
+        else
+            ++i;
+    }
 
     if (!mStoredEvents.empty())
         for (SmartAIEventList::iterator i = mStoredEvents.begin(); i != mStoredEvents.end(); ++i)
@@ -3729,7 +3878,7 @@ void SmartScript::OnUpdate(uint32 const diff)
     }
 }
 
-void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEntry const* at)
+void SmartScript::FillScript(SmartAIEventList const& e, WorldObject* obj, AreaTriggerEntry const* at)
 {
     if (e.empty())
     {
@@ -3739,7 +3888,7 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEn
             TC_LOG_DEBUG("scripts.ai", "SmartScript: EventMap for AreaTrigger %u is empty but is using SmartScript.", at->ID);
         return;
     }
-    for (SmartAIEventList::iterator i = e.begin(); i != e.end(); ++i)
+    for (SmartAIEventList::const_iterator i = e.begin(); i != e.end(); ++i)
     {
         #ifndef TRINITY_DEBUG
             if ((*i).event.event_flags & SMART_EVENT_FLAG_DEBUG_ONLY)
@@ -3763,30 +3912,28 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEn
         TC_LOG_ERROR("sql.sql", "SmartScript: Entry %u has events but no events added to list because of instance flags.", obj->GetEntry());
     if (mEvents.empty() && at)
         TC_LOG_ERROR("sql.sql", "SmartScript: AreaTrigger %u has events but no events added to list because of instance flags. NOTE: triggers can not handle any instance flags.", at->ID);
+
+    RebuildEventIndex();
 }
 
 void SmartScript::GetScript()
 {
-    SmartAIEventList e;
     if (me)
     {
-        e = sSmartScriptMgr->GetScript(-((int32)me->GetDBTableGUIDLow()), mScriptType);
-        if (e.empty())
-            e = sSmartScriptMgr->GetScript((int32)me->GetEntry(), mScriptType);
-        FillScript(e, me, NULL);
+        SmartAIEventList const* e = &sSmartScriptMgr->GetScript(-((int32)me->GetDBTableGUIDLow()), mScriptType);
+        if (e->empty())
+            e = &sSmartScriptMgr->GetScript((int32)me->GetEntry(), mScriptType);
+        FillScript(*e, me, NULL);
     }
     else if (go)
     {
-        e = sSmartScriptMgr->GetScript(-((int32)go->GetDBTableGUIDLow()), mScriptType);
-        if (e.empty())
-            e = sSmartScriptMgr->GetScript((int32)go->GetEntry(), mScriptType);
-        FillScript(e, go, NULL);
+        SmartAIEventList const* e = &sSmartScriptMgr->GetScript(-((int32)go->GetDBTableGUIDLow()), mScriptType);
+        if (e->empty())
+            e = &sSmartScriptMgr->GetScript((int32)go->GetEntry(), mScriptType);
+        FillScript(*e, go, NULL);
     }
     else if (trigger)
-    {
-        e = sSmartScriptMgr->GetScript((int32)trigger->ID, mScriptType);
-        FillScript(e, NULL, trigger);
-    }
+        FillScript(sSmartScriptMgr->GetScript((int32)trigger->ID, mScriptType), NULL, trigger);
 }
 
 void SmartScript::OnInitialize(WorldObject* obj, AreaTriggerEntry const* at)
@@ -3953,7 +4100,7 @@ ObjectList* SmartScript::GetTargetList(uint32 id, WorldObject const* scriptTrigg
     auto itr = mTargetStorage->find(id);
     if (itr != mTargetStorage->end())
     {
-        ObjectList* list = new ObjectList();
+        ObjectList* list = AcquireTargetList();
         for (GuidList::const_iterator itr2 = itr->second.begin(); itr2 != itr->second.end(); ++itr2)
             if (WorldObject* obj = ObjectAccessor::GetWorldObject(*mapObject, *itr2))
                 list->push_back(obj);
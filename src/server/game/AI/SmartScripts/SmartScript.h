@@ -28,6 +28,8 @@
 #include "SmartScriptMgr.h"
 //#include "SmartAI.h"
 
+#include <array>
+
 class SmartScript
 {
     public:
@@ -36,7 +38,7 @@ class SmartScript
 
         void OnInitialize(WorldObject* obj, AreaTriggerEntry const* at = NULL);
         void GetScript();
-        void FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEntry const* at);
+        void FillScript(SmartAIEventList const& e, WorldObject* obj, AreaTriggerEntry const* at);
 
         void ProcessEventsFor(SMART_EVENT e, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellInfo* spell = NULL, GameObject* gob = NULL);
         void ProcessEvent(SmartScriptHolder& e, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellInfo* spell = NULL, GameObject* gob = NULL);
@@ -48,6 +50,10 @@ class SmartScript
         void ProcessTimedAction(SmartScriptHolder& e, uint32 const& min, uint32 const& max, Unit* unit = NULL, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, const SpellInfo* spell = NULL, GameObject* gob = NULL);
         ObjectList* GetTargets(SmartScriptHolder const& e, Unit* invoker = NULL);
         ObjectList* GetWorldObjectsInDist(float dist);
+
+        // lists returned by GetTargets, GetTargetList and GetWorldObjectsInDist are recycled by this script, give them back here
+        ObjectList* AcquireTargetList();
+        void ReleaseTargetList(ObjectList* targets);
         void InstallTemplate(SmartScriptHolder const& e);
         SmartScriptHolder CreateEvent(SMART_EVENT e, uint32 event_flags, uint32 event_param1, uint32 event_param2, uint32 event_param3, uint32 event_param4, uint32 event_param5, SMART_ACTION action, uint32 action_param1, uint32 action_param2, uint32 action_param3, uint32 action_param4, uint32 action_param5, uint32 action_param6, SMARTAI_TARGETS t, uint32 target_param1, uint32 target_param2, uint32 target_param3, uint32 phaseMask = 0);
         void AddEvent(SMART_EVENT e, uint32 event_flags, uint32 event_param1, uint32 event_param2, uint32 event_param3, uint32 event_param4, uint32 event_param5, SMART_ACTION action, uint32 action_param1, uint32 action_param2, uint32 action_param3, uint32 action_param4, uint32 action_param5, uint32 action_param6, SMARTAI_TARGETS t, uint32 target_param1, uint32 target_param2, uint32 target_param3, uint32 phaseMask = 0);
@@ -243,6 +249,22 @@ class SmartScript
 
         SmartAIEventList mEvents;
         SmartAIEventList mInstallEvents;
+
+        // positions in mEvents grouped by event type, mEventsByType[mEventTypeOffsets[type]] up to the next type's offset
+        std::vector<uint32> mEventsByType;
+        std::array<uint32, SMART_EVENT_END + 1> mEventTypeOffsets;
+        // positions in mEvents of the events UpdateTimer processes, and of the other events while their cooldown runs
+        std::vector<uint32> mTimedEvents;
+        std::vector<uint32> mCooldownEvents;
+        void RebuildEventIndex();
+        void StartCooldown(SmartScriptHolder const& e);
+        static bool IsTimedEvent(uint32 eventType);
+
+        std::vector<ObjectList*> mFreeTargetLists;
+
+        uint32 mProfileDepth;
+        int32 GetProfileEntry() const;
+        friend class SmartScriptCostScope;
         SmartAIEventList mTimedActionList;
         Creature* me;
         ObjectGuid meOrigGUID;
@@ -310,6 +310,67 @@ void SmartAIMgr::LoadSmartAIFromDB()
 
 }
 
+void SmartAIMgr::RecordCost(SmartScriptType type, int32 entryOrGuid, bool update, Clock::duration elapsed)
+{
+    uint64 ns = uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+    ThreadCosts& costs = mThreadCosts.Local();
+    std::lock_guard<std::mutex> lock(costs.Lock);
+
+    SmartScriptCost& cost = costs.Costs[(uint64(type) << 32) | uint32(entryOrGuid)];
+    cost.EntryOrGuid = entryOrGuid;
+    cost.SourceType = type;
+    if (update)
+        ++cost.Updates;
+    else
+        ++cost.Events;
+    cost.TotalNs += ns;
+    cost.MaxNs = std::max(cost.MaxNs, ns);
+}
+
+void SmartAIMgr::ResetCosts()
+{
+    mThreadCosts.ForEach([](ThreadCosts& costs, uint32 /*index*/)
+    {
+        std::lock_guard<std::mutex> costsLock(costs.Lock);
+        costs.Costs.clear();
+    });
+}
+
+std::vector<SmartScriptCost> SmartAIMgr::GetTopCosts(uint32 count) const
+{
+    std::unordered_map<uint64, SmartScriptCost> merged;
+    mThreadCosts.ForEach([&merged](ThreadCosts& costs, uint32 /*index*/)
+    {
+        std::lock_guard<std::mutex> costsLock(costs.Lock);
+        for (auto const& itr : costs.Costs)
+        {
+            SmartScriptCost& cost = merged[itr.first];
+            cost.EntryOrGuid = itr.second.EntryOrGuid;
+            cost.SourceType = itr.second.SourceType;
+            cost.Updates += itr.second.Updates;
+            cost.Events += itr.second.Events;
+            cost.TotalNs += itr.second.TotalNs;
+            cost.MaxNs = std::max(cost.MaxNs, itr.second.MaxNs);
+        }
+    });
+
+    std::vector<SmartScriptCost> result;
+    result.reserve(merged.size());
+    for (auto const& itr : merged)
+        result.push_back(itr.second);
+
+    std::sort(result.begin(), result.end(), [](SmartScriptCost const& left, SmartScriptCost const& right)
+    {
+        return left.TotalNs > right.TotalNs;
+    });
+
+    if (result.size() > count)
+        result.resize(count);
+
+    return result;
+}
+
 bool SmartAIMgr::IsTargetValid(SmartScriptHolder const& e)
 {
     if (e.GetActionType() == SMART_ACTION_INSTALL_AI_TEMPLATE)
@@ -24,6 +24,10 @@
 #include "Unit.h"
 #include "Spell.h"
 #include "DB2Stores.h"
+#include "PerThreadRegistry.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
 
 typedef uint32 SAIBool;
 
@@ -1480,7 +1484,7 @@ struct SmartScriptHolder
 
 typedef std::unordered_map<uint32, WayPoint*> WPPath;
 
-typedef std::list<WorldObject*> ObjectList;
+typedef std::vector<WorldObject*> ObjectList;
 typedef std::unordered_map<uint32, ObjectList*> ObjectListMap;
 typedef std::unordered_map<uint32, GuidList> GuidListMap;
 
@@ -1508,32 +1512,60 @@ typedef std::vector<SmartScriptHolder> SmartAIEventList;
 // all events for all entries / guids
 typedef std::unordered_map<int32, SmartAIEventList> SmartAIEventMap;
 
+struct SmartScriptCost
+{
+    int32 EntryOrGuid = 0;
+    SmartScriptType SourceType = SMART_SCRIPT_TYPE_CREATURE;
+    uint64 Updates = 0;
+    uint64 Events = 0;          // ProcessEventsFor calls from outside of an update
+    uint64 TotalNs = 0;
+    uint64 MaxNs = 0;
+};
+
 class SmartAIMgr
 {
+    typedef std::chrono::steady_clock Clock;
+
+    struct ThreadCosts
+    {
+        std::mutex Lock;
+        std::unordered_map<uint64, SmartScriptCost> Costs;
+    };
+
     private:
-        SmartAIMgr() { }
+        SmartAIMgr() : mProfiling(false) { }
         ~SmartAIMgr() { }
     public:
         static SmartAIMgr* instance();
         void LoadSmartAIFromDB();
 
-        SmartAIEventList GetScript(int32 entry, SmartScriptType type)
+        SmartAIEventList const& GetScript(int32 entry, SmartScriptType type) const
         {
-            SmartAIEventList temp;
-            if (mEventMap[uint32(type)].find(entry) != mEventMap[uint32(type)].end())
-                return mEventMap[uint32(type)][entry];
-            else
-            {
-                if (entry > 0)//first search is for guid (negative), do not drop error if not found
-                    TC_LOG_DEBUG("scripts.ai", "SmartAIMgr::GetScript: Could not load Script for Entry %d ScriptType %u.", entry, uint32(type));
-                return temp;
-            }
+            static SmartAIEventList const emptyList;
+
+            auto itr = mEventMap[uint32(type)].find(entry);
+            if (itr != mEventMap[uint32(type)].end())
+                return itr->second;
+
+            if (entry > 0)//first search is for guid (negative), do not drop error if not found
+                TC_LOG_DEBUG("scripts.ai", "SmartAIMgr::GetScript: Could not load Script for Entry %d ScriptType %u.", entry, uint32(type));
+            return emptyList;
         }
 
+        // time spent in SmartScript updates and event processing, per script entry (or guid)
+        void SetProfiling(bool enable) { mProfiling = enable; }
+        bool IsProfiling() const { return mProfiling.load(std::memory_order_relaxed); }
+        void RecordCost(SmartScriptType type, int32 entryOrGuid, bool update, Clock::duration elapsed);
+        void ResetCosts();
+        std::vector<SmartScriptCost> GetTopCosts(uint32 count) const;
+
     private:
         //event stores
         SmartAIEventMap mEventMap[SMART_SCRIPT_TYPE_MAX];
 
+        std::atomic<bool> mProfiling;
+        Trinity::PerThreadRegistry<ThreadCosts> mThreadCosts;
+
         bool IsEventValid(SmartScriptHolder& e);
         bool IsTargetValid(SmartScriptHolder const& e);
 
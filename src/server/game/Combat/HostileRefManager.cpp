@@ -38,6 +38,8 @@ void HostileRefManager::threatAssist(Unit* victim, float baseThreat, SpellInfo c
     HostileReference* ref = getFirst();
     float threat = ThreatCalcHelper::calcThreat(victim, iOwner, baseThreat, (threatSpell ? threatSpell->GetSchoolMask() : SPELL_SCHOOL_MASK_NORMAL), threatSpell);
     threat /= getSize();
+    // applied right away on purpose, each creature only does an indexed lookup and re-sorts lazily in its own update
+    // deferring it would change victim selection and threat redirection within the tick
     while (ref)
     {
         if (ThreatCalcHelper::isValidProcess(victim, ref->GetSource()->GetOwner(), threatSpell))
@@ -259,6 +259,50 @@ void ThreatContainer::clearReferences()
     }
 
     iThreatList.clear();
+    iThreatIndex.clear();
+}
+
+//============================================================
+
+void ThreatContainer::remove(HostileReference* hostileRef)
+{
+    auto itr = iThreatIndex.find(hostileRef->getUnitGuid());
+    if (itr == iThreatIndex.end() || *itr->second != hostileRef)
+    {
+        iThreatList.remove(hostileRef);
+        return;
+    }
+
+    iThreatList.erase(itr->second);
+    iThreatIndex.erase(itr);
+}
+
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* hostileRef)
+{
+    iThreatList.push_back(hostileRef);
+    iThreatIndex[hostileRef->getUnitGuid()] = std::prev(iThreatList.end());
+    threatChanged(hostileRef);
+}
+
+//============================================================
+// The list is sorted by threat when not dirty, so only the neighbours of the changed reference have to be compared
+
+void ThreatContainer::threatChanged(HostileReference* hostileRef)
+{
+    if (iDirty)
+        return;
+
+    auto itr = iThreatIndex.find(hostileRef->getUnitGuid());
+    if (itr == iThreatIndex.end())
+        return;
+
+    StorageType::iterator pos = itr->second;
+    if (pos != iThreatList.begin() && (*std::prev(pos))->getThreat() < hostileRef->getThreat())
+        iDirty = true;
+    else if (std::next(pos) != iThreatList.end() && (*std::next(pos))->getThreat() > hostileRef->getThreat())
+        iDirty = true;
 }
 
 //============================================================
@@ -268,15 +312,8 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* victim) const
     if (!victim)
         return NULL;
 
-    uint64 const guid = victim->GetGUID();
-    for (ThreatContainer::StorageType::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-    {
-        HostileReference* ref = (*i);
-        if (ref && ref->getUnitGuid() == guid)
-            return ref;
-    }
-
-    return NULL;
+    auto itr = iThreatIndex.find(victim->GetGUID());
+    return itr != iThreatIndex.end() ? *itr->second : NULL;
 }
 
 //============================================================
@@ -551,9 +588,11 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
     switch (threatRefStatusChangeEvent->getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
-            if ((getCurrentVictim() == hostilRef && threatRefStatusChangeEvent->getFValue()<0.0f) ||
-                (getCurrentVictim() != hostilRef && threatRefStatusChangeEvent->getFValue()>0.0f))
-                setDirty(true);                             // the order in the threat list might have changed
+            // the order in the threat list might have changed
+            if (hostilRef->isOnline())
+                iThreatContainer.threatChanged(hostilRef);
+            else
+                iThreatOfflineContainer.threatChanged(hostilRef);
             break;
         case UEV_THREAT_REF_ONLINE_STATUS:
             if (!hostilRef->isOnline())
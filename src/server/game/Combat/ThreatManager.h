@@ -21,9 +21,11 @@
 #include "Common.h"
 #include "SharedDefines.h"
 #include "LinkedReference/Reference.h"
+#include "ObjectGuid.h"
 #include "UnitEvents.h"
 
 #include <list>
+#include <unordered_map>
 
 //==============================================================
 
@@ -175,22 +177,20 @@ class ThreatContainer
         StorageType const & getThreatList() const { return iThreatList; }
 
     private:
-        void remove(HostileReference* hostileRef)
-        {
-            iThreatList.remove(hostileRef);
-        }
+        void remove(HostileReference* hostileRef);
 
-        void addReference(HostileReference* hostileRef)
-        {
-            iThreatList.push_back(hostileRef);
-        }
+        void addReference(HostileReference* hostileRef);
 
         void clearReferences();
 
+        // Mark the list dirty if the changed threat moved the reference out of order
+        void threatChanged(HostileReference* hostileRef);
+
         // Sort the list if necessary
         void update();
 
         StorageType iThreatList;
+        std::unordered_map<ObjectGuid, StorageType::iterator> iThreatIndex;   // target guid -> position in iThreatList
         bool iDirty;
 };
 
@@ -16,6 +16,7 @@
 */
 
 #include "Creature.h"
+#include "AIProfiler.h"
 #include "BattlegroundMgr.h"
 #include "CellImpl.h"
 #include "Common.h"
@@ -662,7 +663,10 @@ void Creature::Update(uint32 diff)
             {
                 // do not allow the AI to be changed during update
                 m_AI_locked = true;
-                i_AI->UpdateAI(diff);
+                {
+                    AIProfileScope profile(this, AI_PROFILE_UPDATE_AI);
+                    i_AI->UpdateAI(diff);
+                }
                 m_AI_locked = false;
             }
 
@@ -698,6 +702,15 @@ void Creature::Update(uint32 diff)
 
 }
 
+bool Creature::CanHaveReducedUpdates() const
+{
+    if (IsInCombat() || IsInEvadeMode() || isActiveObject() || m_triggerJustAppeared)
+        return false;
+
+    // pets, guardians and charmed creatures follow their controller, vehicles carry passengers
+    return !GetCharmerOrOwnerGUID() && !GetVehicleKit() && !GetVehicle();
+}
+
 void Creature::RegenerateMana()
 {
     if (!isRegeneratingMana())
@@ -269,6 +269,11 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
         ObjectGuid::LowType GetSpawnId() const { return m_spawnId; }
 
         void Update(uint32 time) override;         // overwrited Unit::Update
+
+        // out of combat creatures away from players may be updated with the diff of several map ticks at once
+        bool CanHaveReducedUpdates() const;
+        bool DeferUpdate(uint32 diff, uint32 interval) { m_deferredUpdateDiff += diff; return m_deferredUpdateDiff < interval; }
+        uint32 TakeDeferredUpdateDiff(uint32 diff) { diff += m_deferredUpdateDiff; m_deferredUpdateDiff = 0; return diff; }
         void GetRespawnPosition(float &x, float &y, float &z, float* ori = NULL, float* dist =NULL) const;
 
         void SetCorpseDelay(uint32 delay) { m_corpseDelay = delay; }
@@ -603,6 +608,7 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
         bool m_AlreadySearchedAssistance;
         bool m_cannotReachTarget;
         uint32 m_cannotReachTimer;
+        uint32 m_deferredUpdateDiff = 0;
         
         bool m_regenHealth;
         bool m_regenMana = true;
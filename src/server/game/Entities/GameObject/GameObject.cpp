@@ -16,6 +16,7 @@
 */
 
 #include "GameObjectAI.h"
+#include "AIProfiler.h"
 #include "Battleground.h"
 #include "CellImpl.h"
 #include "CreatureAISelector.h"
@@ -365,7 +366,10 @@ void GameObject::Update(uint32 diff)
     UpdateStealthVisibility(diff);
 
     if (AI())
+    {
+        AIProfileScope profile(this, AI_PROFILE_UPDATE_AI);
         AI()->UpdateAI(diff);
+    }
     else if (!AIM_Initialize())
         TC_LOG_ERROR("misc", "Could not initialize GameObjectAI");
 
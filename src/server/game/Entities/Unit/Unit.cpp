@@ -16,6 +16,7 @@
 */
 
 #include "Unit.h"
+#include "AIProfiler.h"
 #include "Battlefield.h"
 #include "BattlefieldMgr.h"
 #include "Battleground.h"
@@ -69,6 +70,7 @@
 #include "AreaTrigger.h"
 #include <math.h>
 #include <numeric>
+#include <bit>
 #include "SpellScript.h"
 #include "PetBattle.h"
 #include "GameEventMgr.h"
@@ -461,6 +463,8 @@ void Unit::Update(uint32 p_time)
     }
 
     UpdateSplineMovement(p_time);
+
+    AIProfileScope profile(GetTypeId() == TYPEID_UNIT ? this : nullptr, AI_PROFILE_MOVEMENT);
     GetMotionMaster()->UpdateMotion(p_time);
 }
 
@@ -3847,6 +3851,88 @@ void Unit::_AddAura(UnitAura* aura, Unit* caster)
 
 // creates aura application instance and registers it in lists
 // aura application effects are handled separately to prevent aura list corruption
+// proc flags an aura reacts to in ProcDamageAndSpellFor, auras without any are rejected by IsTriggeredAtSpellProcEvent
+static uint32 GetProcAuraTriggerFlags(SpellInfo const* spellInfo, SpellProcEventEntry const* procEvent)
+{
+    // handled by the new proc system
+    if (sSpellMgr->GetSpellProcEntry(spellInfo->Id))
+        return 0;
+
+    if (procEvent && procEvent->procFlags)
+        return procEvent->procFlags;
+
+    return spellInfo->ProcFlags;
+}
+
+void Unit::_AddProcAuraToIndex(ProcPhase phase, AuraApplication* aurApp, uint32 procFlags)
+{
+    if (!procFlags)
+        return;
+
+    std::unique_ptr<ProcAuraBuckets>& buckets = m_procAuraBuckets[uint32(phase)];
+    if (!buckets)
+        buckets.reset(new ProcAuraBuckets());
+
+    ProcAuraIndexEntry entry{ uint64(aurApp->GetBase()->GetId()) << 32 | m_procAuraSequence, aurApp };
+    for (uint32 flags = procFlags; flags; flags &= flags - 1)
+    {
+        ProcAuraIndexList& bucket = (*buckets)[std::countr_zero(flags)];
+        bucket.insert(std::upper_bound(bucket.begin(), bucket.end(), entry, [](ProcAuraIndexEntry const& left, ProcAuraIndexEntry const& right)
+        {
+            return left.Order < right.Order;
+        }), entry);
+    }
+
+    m_procAuraFlags[uint32(phase)] |= procFlags;
+}
+
+void Unit::_RemoveProcAuraFromIndex(AuraApplication* aurApp)
+{
+    // flags of the spell may have been reloaded since the aura was added, look through every used bucket
+    for (uint32 phase = 0; phase < uint32(ProcPhase::Max); ++phase)
+    {
+        for (uint32 flags = m_procAuraFlags[phase]; flags; flags &= flags - 1)
+        {
+            uint32 bit = std::countr_zero(flags);
+            ProcAuraIndexList& bucket = (*m_procAuraBuckets[phase])[bit];
+            bucket.erase(std::remove_if(bucket.begin(), bucket.end(), [aurApp](ProcAuraIndexEntry const& entry)
+            {
+                return entry.AurApp == aurApp;
+            }), bucket.end());
+
+            if (bucket.empty())
+                m_procAuraFlags[phase] &= ~(1u << bit);
+        }
+    }
+}
+
+void Unit::GetProcAuraCandidates(ProcPhase phase, uint32 procFlag, ProcAuraIndexList& candidates) const
+{
+    uint32 flags = procFlag & m_procAuraFlags[uint32(phase)];
+    if (!flags)
+        return;
+
+    ProcAuraBuckets const& buckets = *m_procAuraBuckets[uint32(phase)];
+    for (; flags; flags &= flags - 1)
+    {
+        ProcAuraIndexList const& bucket = buckets[std::countr_zero(flags)];
+        candidates.insert(candidates.end(), bucket.begin(), bucket.end());
+    }
+
+    // an aura reacting to several flags of the event is in several buckets
+    if (candidates.size() > 1)
+    {
+        std::sort(candidates.begin(), candidates.end(), [](ProcAuraIndexEntry const& left, ProcAuraIndexEntry const& right)
+        {
+            return left.Order < right.Order;
+        });
+        candidates.erase(std::unique(candidates.begin(), candidates.end(), [](ProcAuraIndexEntry const& left, ProcAuraIndexEntry const& right)
+        {
+            return left.AurApp == right.AurApp;
+        }), candidates.end());
+    }
+}
+
 AuraApplication * Unit::_CreateAuraApplication(Aura* aura, uint32 effMask)
 {
     // can't apply aura on unit which is going to be deleted - to not create a memory leak
@@ -3872,17 +3958,31 @@ AuraApplication * Unit::_CreateAuraApplication(Aura* aura, uint32 effMask)
     m_appliedAuras.insert(AuraApplicationMap::value_type(aurId, aurApp));
 
     auto procEntry = sSpellMgr->GetSpellProcEvent(aurId);
+    uint32 procFlags = GetProcAuraTriggerFlags(aurSpellInfo, procEntry);
     if (procEntry)
     {
         if (procEntry->phaseMask & ProcPhaseMask::Hit)
+        {
             m_procAuras[uint32(ProcPhase::Hit)].insert(AuraApplicationMap::value_type(aurId, aurApp));
+            _AddProcAuraToIndex(ProcPhase::Hit, aurApp, procFlags);
+        }
         if (procEntry->phaseMask & ProcPhaseMask::Cast)
+        {
             m_procAuras[uint32(ProcPhase::Cast)].insert(AuraApplicationMap::value_type(aurId, aurApp));
+            _AddProcAuraToIndex(ProcPhase::Cast, aurApp, procFlags);
+        }
         if (procEntry->phaseMask & ProcPhaseMask::AfterCast)
+        {
             m_procAuras[uint32(ProcPhase::AfterCast)].insert(AuraApplicationMap::value_type(aurId, aurApp));
+            _AddProcAuraToIndex(ProcPhase::AfterCast, aurApp, procFlags);
+        }
     }
     else
+    {
         m_procAuras[uint32(ProcPhase::Hit)].insert(AuraApplicationMap::value_type(aurId, aurApp));
+        _AddProcAuraToIndex(ProcPhase::Hit, aurApp, procFlags);
+    }
+    ++m_procAuraSequence;
 
     if (aurSpellInfo->AuraInterruptFlags)
     {
@@ -3979,6 +4079,7 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator &i, AuraRemoveMode removeMo
                 ++itr;
         }
     }
+    _RemoveProcAuraFromIndex(aurApp);
 
     if (aura->GetSpellInfo()->AuraInterruptFlags)
     {
@@ -4091,6 +4192,8 @@ void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
         m_modAuras [aurEff->GetAuraType()].push_back(aurEff);
     else
         m_modAuras [aurEff->GetAuraType()].remove(aurEff);
+
+    InvalidateAuraModifierCache(aurEff->GetAuraType());
 }
 
 // All aura base removes should go threw this function!
@@ -5313,202 +5416,283 @@ uint32 Unit::GetDoTsByCaster(uint64 casterGUID) const
     return dots;
 }
 
+void Unit::InvalidateAuraModifierCache(AuraType auraType)
+{
+    if (m_auraModifierCache.empty())
+        return;
+
+    std::erase_if(m_auraModifierCache, [auraType](auto const& entry) { return (entry.first >> 40) == uint64(auraType); });
+}
+
+template<typename T, typename Calculator>
+T Unit::GetCachedAuraModifier(AuraType auraType, AuraModifierQuery query, int32 misc, Calculator&& calculate) const
+{
+    // nothing to sum up, not worth an entry
+    if (m_modAuras[auraType].empty())
+        return calculate();
+
+    uint64 key = (uint64(auraType) << 40) | (uint64(query) << 32) | uint32(misc);
+    auto itr = m_auraModifierCache.find(key);
+    if (itr != m_auraModifierCache.end())
+    {
+#ifdef TRINITY_DEBUG
+        T recalculated = calculate();
+        if (recalculated != T(itr->second))
+            TC_LOG_ERROR("entities.unit", "Unit::GetCachedAuraModifier: cached %f differs from recalculated %f (aura type %u, query %u, misc %d) on %s",
+                itr->second, double(recalculated), uint32(auraType), uint32(query), misc, GetGUID().ToString().c_str());
+#endif
+        return T(itr->second);
+    }
+
+    T value = calculate();
+    m_auraModifierCache.emplace(key, double(value));
+    return value;
+}
+
 int32 Unit::GetTotalAuraModifier(AuraType auratype) const
 {
-    std::map<SpellGroup, int32> sameEffectSpellGroup;
-    int32 modifier = 0;
+    return GetCachedAuraModifier<int32>(auratype, AURA_MODIFIER_TOTAL, 0, [&]()
+    {
+        std::map<SpellGroup, int32> sameEffectSpellGroup;
+        int32 modifier = 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (auto&& it : GetAuraEffectsByType(auratype))
-        if (!sSpellMgr->AddSameEffectStackRuleSpellGroups(it->GetSpellInfo(), it->GetAmount(), sameEffectSpellGroup))
-            modifier += it->GetAmount();
+        AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+        for (auto&& it : GetAuraEffectsByType(auratype))
+            if (!sSpellMgr->AddSameEffectStackRuleSpellGroups(it->GetSpellInfo(), it->GetAmount(), sameEffectSpellGroup))
+                modifier += it->GetAmount();
 
-    for (auto&& it : sameEffectSpellGroup)
-        modifier += it.second;
+        for (auto&& it : sameEffectSpellGroup)
+            modifier += it.second;
 
-    return modifier;
+        return modifier;
+    });
 }
 
 float Unit::GetTotalAuraMultiplier(AuraType auratype) const
 {
-    std::map<SpellGroup, int32> sameEffectSpellGroup;
-    float multiplier = 1.0f;
+    return GetCachedAuraModifier<float>(auratype, AURA_MODIFIER_MULTIPLIER, 0, [&]()
+    {
+        std::map<SpellGroup, int32> sameEffectSpellGroup;
+        float multiplier = 1.0f;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (auto&& it : GetAuraEffectsByType(auratype))
-        if (!sSpellMgr->AddSameEffectStackRuleSpellGroups(it->GetSpellInfo(), it->GetAmount(), sameEffectSpellGroup))
-            AddPct(multiplier, it->GetAmount());
+        AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+        for (auto&& it : GetAuraEffectsByType(auratype))
+            if (!sSpellMgr->AddSameEffectStackRuleSpellGroups(it->GetSpellInfo(), it->GetAmount(), sameEffectSpellGroup))
+                AddPct(multiplier, it->GetAmount());
 
-    for (auto&& it : sameEffectSpellGroup)
-        AddPct(multiplier, it.second);
+        for (auto&& it : sameEffectSpellGroup)
+            AddPct(multiplier, it.second);
 
-    return multiplier;
+        return multiplier;
+    });
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype) const
 {
-    int32 modifier = 0;
+    auto calculate = [&]()
+    {
+        int32 modifier = 0;
 
-    Battleground* bg = GetBattlegorund();
+        Battleground* bg = GetBattlegorund();
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (auto&& itr : mTotalAuraList)
-    {
-        if (bg && itr->GetSpellInfo()->CheckArenaAndBattlegroundCastRules(bg) != SPELL_CAST_OK)
-            continue;
+        AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+        for (auto&& itr : mTotalAuraList)
+        {
+            if (bg && itr->GetSpellInfo()->CheckArenaAndBattlegroundCastRules(bg) != SPELL_CAST_OK)
+                continue;
 
-        if (itr->GetAmount() > modifier)
-            modifier = itr->GetAmount();
-    }
+            if (itr->GetAmount() > modifier)
+                modifier = itr->GetAmount();
+        }
 
-    return modifier;
+        return modifier;
+    };
+
+    // arena and battleground cast rules are checked per call
+    if (GetBattlegorund())
+        return calculate();
+
+    return GetCachedAuraModifier<int32>(auratype, AURA_MODIFIER_MAX_POSITIVE, 0, calculate);
 }
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
 {
-    int32 modifier = 0;
+    return GetCachedAuraModifier<int32>(auratype, AURA_MODIFIER_MAX_NEGATIVE, 0, [&]()
+    {
+        int32 modifier = 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
+        AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+        for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+            if ((*i)->GetAmount() < modifier)
+                modifier = (*i)->GetAmount();
 
-    return modifier;
+        return modifier;
+    });
 }
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 miscMask) const
 {
-    std::map<SpellGroup, int32> SameEffectSpellGroup;
-    int32 modifier = 0;
+    return GetCachedAuraModifier<int32>(auratype, AURA_MODIFIER_TOTAL_BY_MISC_MASK, int32(miscMask), [&]()
+    {
+        std::map<SpellGroup, int32> SameEffectSpellGroup;
+        int32 modifier = 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+        AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
 
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetMiscValue() & miscMask)
-            if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
-                modifier += (*i)->GetAmount();
+        for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+            if ((*i)->GetMiscValue() & miscMask)
+                if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
+                    modifier += (*i)->GetAmount();
 
-    for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
-        modifier += itr->second;
+        for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
+            modifier += itr->second;
 
-    return modifier;
+        return modifier;
+    });
 }
 
 float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 miscMask) const
 {
-    std::map<SpellGroup, int32> SameEffectSpellGroup;
-    float multiplier = 1.0f;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    return GetCachedAuraModifier<float>(auratype, AURA_MODIFIER_MULTIPLIER_BY_MISC_MASK, int32(miscMask), [&]()
     {
-        if (((*i)->GetMiscValue() & miscMask))
+        std::map<SpellGroup, int32> SameEffectSpellGroup;
+        float multiplier = 1.0f;
+
+        AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+        for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
         {
-            // Check if the Aura Effect has a the Same Effect Stack Rule and if so, use the highest amount of that SpellGroup
-            // If the Aura Effect does not have this Stack Rule, it returns false so we can add to the multiplier as usual
-            if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
-                AddPct(multiplier, (*i)->GetAmount());
+            if (((*i)->GetMiscValue() & miscMask))
+            {
+                // Check if the Aura Effect has a the Same Effect Stack Rule and if so, use the highest amount of that SpellGroup
+                // If the Aura Effect does not have this Stack Rule, it returns false so we can add to the multiplier as usual
+                if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
+                    AddPct(multiplier, (*i)->GetAmount());
+            }
         }
-    }
-    // Add the highest of the Same Effect Stack Rule SpellGroups to the multiplier
-    for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
-        AddPct(multiplier, itr->second);
+        // Add the highest of the Same Effect Stack Rule SpellGroups to the multiplier
+        for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
+            AddPct(multiplier, itr->second);
 
-    return multiplier;
+        return multiplier;
+    });
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 miscMask, const AuraEffect* except) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    auto calculate = [&]()
     {
-        if (except != (*i) && (*i)->GetMiscValue()& miscMask && (*i)->GetAmount() > modifier)
-            modifier = (*i)->GetAmount();
-    }
+        int32 modifier = 0;
 
-    return modifier;
+        AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+        for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+        {
+            if (except != (*i) && (*i)->GetMiscValue()& miscMask && (*i)->GetAmount() > modifier)
+                modifier = (*i)->GetAmount();
+        }
+
+        return modifier;
+    };
+
+    // the excluded effect is not part of the cache key
+    if (except)
+        return calculate();
+
+    return GetCachedAuraModifier<int32>(auratype, AURA_MODIFIER_MAX_POSITIVE_BY_MISC_MASK, int32(miscMask), calculate);
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 miscMask) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    return GetCachedAuraModifier<int32>(auratype, AURA_MODIFIER_MAX_NEGATIVE_BY_MISC_MASK, int32(miscMask), [&]()
     {
-        if ((*i)->GetMiscValue()& miscMask && (*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
-    }
+        int32 modifier = 0;
 
-    return modifier;
+        AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+        for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+        {
+            if ((*i)->GetMiscValue()& miscMask && (*i)->GetAmount() < modifier)
+                modifier = (*i)->GetAmount();
+        }
+
+        return modifier;
+    });
 }
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 miscValue) const
 {
-    std::map<SpellGroup, int32> SameEffectSpellGroup;
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    return GetCachedAuraModifier<int32>(auratype, AURA_MODIFIER_TOTAL_BY_MISC_VALUE, miscValue, [&]()
     {
-        if ((*i)->GetMiscValue() == miscValue)
-            if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
-                modifier += (*i)->GetAmount();
-    }
+        std::map<SpellGroup, int32> SameEffectSpellGroup;
+        int32 modifier = 0;
 
-    for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
-        modifier += itr->second;
+        AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+        for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+        {
+            if ((*i)->GetMiscValue() == miscValue)
+                if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
+                    modifier += (*i)->GetAmount();
+        }
 
-    return modifier;
+        for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
+            modifier += itr->second;
+
+        return modifier;
+    });
 }
 
 float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 miscValue) const
 {
-    std::map<SpellGroup, int32> SameEffectSpellGroup;
-    float multiplier = 1.0f;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    return GetCachedAuraModifier<float>(auratype, AURA_MODIFIER_MULTIPLIER_BY_MISC_VALUE, miscValue, [&]()
     {
-        if ((*i)->GetMiscValue() == miscValue)
-            if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
-                AddPct(multiplier, (*i)->GetAmount());
-    }
+        std::map<SpellGroup, int32> SameEffectSpellGroup;
+        float multiplier = 1.0f;
 
-    for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
-        AddPct(multiplier, itr->second);
+        AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+        for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+        {
+            if ((*i)->GetMiscValue() == miscValue)
+                if (!sSpellMgr->AddSameEffectStackRuleSpellGroups((*i)->GetSpellInfo(), (*i)->GetAmount(), SameEffectSpellGroup))
+                    AddPct(multiplier, (*i)->GetAmount());
+        }
 
-    return multiplier;
+        for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
+            AddPct(multiplier, itr->second);
+
+        return multiplier;
+    });
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 miscValue) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    return GetCachedAuraModifier<int32>(auratype, AURA_MODIFIER_MAX_POSITIVE_BY_MISC_VALUE, miscValue, [&]()
     {
-        if ((*i)->GetMiscValue() == miscValue && (*i)->GetAmount() > modifier)
-            modifier = (*i)->GetAmount();
-    }
+        int32 modifier = 0;
 
-    return modifier;
+        AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+        for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+        {
+            if ((*i)->GetMiscValue() == miscValue && (*i)->GetAmount() > modifier)
+                modifier = (*i)->GetAmount();
+        }
+
+        return modifier;
+    });
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 miscValue) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    return GetCachedAuraModifier<int32>(auratype, AURA_MODIFIER_MAX_NEGATIVE_BY_MISC_VALUE, miscValue, [&]()
     {
-        if ((*i)->GetMiscValue() == miscValue && (*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
-    }
+        int32 modifier = 0;
 
-    return modifier;
+        AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+        for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+        {
+            if ((*i)->GetMiscValue() == miscValue && (*i)->GetAmount() < modifier)
+                modifier = (*i)->GetAmount();
+        }
+
+        return modifier;
+    });
 }
 
 int32 Unit::GetTotalAuraModifierByAffectMask(AuraType auratype, SpellInfo const* affectedSpell) const
@@ -5996,6 +6180,8 @@ void Unit::ProcDamageAndSpell(Unit* victim, uint32 procAttacker, uint32 procVict
         victim->ProcDamageAndSpellFor(true, this, procVictim, procExtra, attType, procSpell, amount, procAura, context);
 }
 
+std::atomic<uint64> Unit::s_periodicAuraLogTicks(0);
+
 void Unit::SendPeriodicAuraLog(SpellPeriodicAuraLogInfo* pInfo)
 {
     AuraEffect const* aura = pInfo->auraEff;
@@ -6071,6 +6257,7 @@ void Unit::SendPeriodicAuraLog(SpellPeriodicAuraLogInfo* pInfo)
     data.WriteByteSeq(targetGuid[2]);
     data.WriteByteSeq(casterGuid[6]);
 
+    ++s_periodicAuraLogTicks;
     SendMessageToSet(&data, true);
 }
 
@@ -14463,21 +14650,40 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
 
     ProcTriggeredList procTriggered;
 
-    AuraApplicationMap& procAuras = m_procAuras[uint32(context.Phase)];
+    ProcAuraIndexList candidates;
+    GetProcAuraCandidates(context.Phase, procFlag, candidates);
+
+#ifdef TRINITY_DEBUG
+    {
+        // the index must select exactly the auras of m_procAuras that can trigger from these flags, in the same order
+        std::vector<AuraApplication*> expected;
+        for (auto&& itr : m_procAuras[uint32(context.Phase)])
+            if (procFlag & GetProcAuraTriggerFlags(itr.second->GetBase()->GetSpellInfo(), sSpellMgr->GetSpellProcEvent(itr.first)))
+                expected.push_back(itr.second);
+
+        if (!std::equal(expected.begin(), expected.end(), candidates.begin(), candidates.end(), [](AuraApplication* aurApp, ProcAuraIndexEntry const& entry) { return aurApp == entry.AurApp; }))
+            TC_LOG_ERROR("entities.unit", "Unit::ProcDamageAndSpellFor: proc aura index selected %u auras, expected %u (proc flags 0x%08X, phase %u) on %s",
+                uint32(candidates.size()), uint32(expected.size()), procFlag, uint32(context.Phase), GetGUID().ToString().c_str());
+    }
+#endif
 
     // Fill procTriggered list
-    for (auto&& itr : procAuras)
+    for (ProcAuraIndexEntry const& candidate : candidates)
     {
+        AuraApplication* aurApp = candidate.AurApp;
+        // removed by the proc checks of a previous candidate
+        if (aurApp->GetRemoveMode())
+            continue;
         // Do not allow auras to proc from effect triggered by itself
-        if (procAura && procAura->Id == itr.first)
+        if (procAura && procAura->Id == aurApp->GetBase()->GetId())
             continue;
-        ProcTriggeredData triggerData{ itr.second, eventInfo };
+        ProcTriggeredData triggerData{ aurApp, eventInfo };
         // Defensive procs are active on absorbs (so absorption effects are not a hindrance)
         bool active = damage || (procExtra & PROC_EX_BLOCK && isVictim) || context.Phase == ProcPhase::Cast;
         if (isVictim)
             procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
 
-        SpellInfo const* spellProto = itr.second->GetBase()->GetSpellInfo();
+        SpellInfo const* spellProto = aurApp->GetBase()->GetSpellInfo();
 
         // only auras that has triggered spell should proc from fully absorbed damage
         if (procExtra & PROC_EX_ABSORB && isVictim)
@@ -14504,9 +14710,9 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
 
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
-            if (itr.second->HasEffect(i))
+            if (aurApp->HasEffect(i))
             {
-                AuraEffect* aurEff = itr.second->GetBase()->GetEffect(i);
+                AuraEffect* aurEff = aurApp->GetBase()->GetEffect(i);
                 // Skip this auras
                 if (isNonTriggerAura [aurEff->GetAuraType()])
                     continue;
@@ -25,6 +25,7 @@
 #include "FunctionProcessor.h"
 #include "HostileRefManager.h"
 #include "MotionMaster.h"
+#include "NodePoolAllocator.h"
 #include "Object.h"
 #include "SpellAuraDefines.h"
 #include "SpellDefines.h"
@@ -35,6 +36,7 @@
 #include "SpellInfo.h"
 #include "UnitDefines.h"
 #include <array>
+#include <atomic>
 #include <memory>
 
 #define WORLD_TRIGGER   12999
@@ -1060,25 +1062,26 @@ public:
     typedef std::set<Unit*> ControlList;
     typedef std::vector<Unit*> UnitVector;
 
-    typedef std::multimap<uint32, Aura*> AuraMap;
+    // aura containers churn on every apply/remove, their nodes come from a per thread pool
+    typedef std::multimap<uint32, Aura*, std::less<uint32>, Trinity::NodePoolAllocator<std::pair<uint32 const, Aura*>>> AuraMap;
     typedef std::pair<AuraMap::const_iterator, AuraMap::const_iterator> AuraMapBounds;
     typedef std::pair<AuraMap::iterator, AuraMap::iterator> AuraMapBoundsNonConst;
 
-    typedef std::multimap<uint32, AuraApplication*> AuraApplicationMap;
+    typedef std::multimap<uint32, AuraApplication*, std::less<uint32>, Trinity::NodePoolAllocator<std::pair<uint32 const, AuraApplication*>>> AuraApplicationMap;
     typedef std::pair<AuraApplicationMap::const_iterator, AuraApplicationMap::const_iterator> AuraApplicationMapBounds;
     typedef std::pair<AuraApplicationMap::iterator, AuraApplicationMap::iterator> AuraApplicationMapBoundsNonConst;
 
     typedef std::multimap<AuraStateType, AuraApplication*> AuraStateAurasMap;
     typedef std::pair<AuraStateAurasMap::const_iterator, AuraStateAurasMap::const_iterator> AuraStateAurasMapBounds;
 
-    typedef std::list<AuraEffect*> AuraEffectList;
+    typedef std::list<AuraEffect*, Trinity::NodePoolAllocator<AuraEffect*>> AuraEffectList;
     typedef std::list<Aura*> AuraList;
     typedef std::list<AuraApplication *> AuraApplicationList;
     typedef std::list<DiminishingReturn> Diminishing;
 
     // typedef std::vector<std::pair<uint8 /*procEffectMask*/, AuraApplication*>> AuraApplicationProcContainer; // TC
 
-    typedef std::map<uint8, AuraApplication*> VisibleAuraMap;
+    typedef std::map<uint8, AuraApplication*, std::less<uint8>, Trinity::NodePoolAllocator<std::pair<uint8 const, AuraApplication*>>> VisibleAuraMap;
 
     class RemainingPeriodicAmount final
     {
@@ -1692,6 +1695,7 @@ public:
     void SendSpellNonMeleeDamageLog(SpellNonMeleeDamage* log);
     void SendSpellNonMeleeDamageLog(Unit* target, uint32 SpellID, uint32 Damage, SpellSchoolMask damageSchoolMask, uint32 AbsorbedDamage, uint32 Resist, bool PhysicalDamage, uint32 Blocked, bool CriticalHit = false);
     void SendPeriodicAuraLog(SpellPeriodicAuraLogInfo* pInfo);
+    static uint64 GetPeriodicAuraLogTickCount() { return s_periodicAuraLogTicks; }
     void SendSpellMiss(Unit* target, uint32 spellID, SpellMissInfo missInfo);
     void SendSpellDamageResist(Unit* target, uint32 spellId);
     void SendSpellDamageImmune(Unit* target, uint32 spellId);
@@ -1997,6 +2001,9 @@ public:
     template <class Cond>
     int32 GetTotalAuraModifier(AuraType auraType, Cond cond) const;
 
+    // drops cached GetTotal/GetMax results of the aura type, called whenever an effect of that type is (un)registered or its amount changes
+    void InvalidateAuraModifierCache(AuraType auraType);
+
     float GetTotalHaseMultiplier(AuraType auraType) const;
 
     float GetResistanceBuffMods(SpellSchools school, bool positive) const;
@@ -2635,11 +2642,51 @@ protected:
     AuraMap m_ownedAuras;
     AuraApplicationMap m_appliedAuras;
     AuraApplicationMap m_procAuras[uint32(ProcPhase::Max)];
+
+    // m_procAuras bucketed by the proc flag bits the aura can trigger from, a proc event only visits the buckets of its own flags
+    struct ProcAuraIndexEntry
+    {
+        uint64 Order;               // spell id << 32 | insertion sequence, same order as m_procAuras
+        AuraApplication* AurApp;
+    };
+    typedef std::vector<ProcAuraIndexEntry> ProcAuraIndexList;
+    typedef std::array<ProcAuraIndexList, 32> ProcAuraBuckets;
+
+    void _AddProcAuraToIndex(ProcPhase phase, AuraApplication* aurApp, uint32 procFlags);
+    void _RemoveProcAuraFromIndex(AuraApplication* aurApp);
+    void GetProcAuraCandidates(ProcPhase phase, uint32 procFlag, ProcAuraIndexList& candidates) const;
+
+    std::unique_ptr<ProcAuraBuckets> m_procAuraBuckets[uint32(ProcPhase::Max)];
+    uint32 m_procAuraFlags[uint32(ProcPhase::Max)] = { };  // bits of the non empty buckets
+    uint32 m_procAuraSequence = 0;
     AuraList m_removedAuras;
     AuraMap::iterator m_auraUpdateIterator;
     uint32 m_removedAurasCount;
 
+    // every tick is logged on its own, before the damage and procs it causes, the client shows them in this order
+    static std::atomic<uint64> s_periodicAuraLogTicks;
+
+    enum AuraModifierQuery : uint8
+    {
+        AURA_MODIFIER_TOTAL,
+        AURA_MODIFIER_MULTIPLIER,
+        AURA_MODIFIER_MAX_POSITIVE,
+        AURA_MODIFIER_MAX_NEGATIVE,
+        AURA_MODIFIER_TOTAL_BY_MISC_MASK,
+        AURA_MODIFIER_MULTIPLIER_BY_MISC_MASK,
+        AURA_MODIFIER_MAX_POSITIVE_BY_MISC_MASK,
+        AURA_MODIFIER_MAX_NEGATIVE_BY_MISC_MASK,
+        AURA_MODIFIER_TOTAL_BY_MISC_VALUE,
+        AURA_MODIFIER_MULTIPLIER_BY_MISC_VALUE,
+        AURA_MODIFIER_MAX_POSITIVE_BY_MISC_VALUE,
+        AURA_MODIFIER_MAX_NEGATIVE_BY_MISC_VALUE,
+    };
+
+    template<typename T, typename Calculator>
+    T GetCachedAuraModifier(AuraType auraType, AuraModifierQuery query, int32 misc, Calculator&& calculate) const;
+
     AuraEffectList m_modAuras [TOTAL_AURAS];
+    mutable std::unordered_map<uint64, double> m_auraModifierCache;  // [aura type, query, misc value] -> result of the query
     AuraApplicationList m_interruptableAuras;             // auras which have interrupt mask applied on unit
     AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
     std::map<uint32, AuraList> m_boundAuras;
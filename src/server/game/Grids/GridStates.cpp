@@ -65,10 +65,20 @@ void RemovalState::Update(Map& map, NGridType& grid, GridInfo& info, uint32 diff
     if (!info.getUnloadLock())
     {
         info.UpdateTimeTracker(diff);
-        if (info.getTimeTracker().Passed() && !map.UnloadGrid(grid, false))
+        if (!info.getTimeTracker().Passed())
+            return;
+
+        if (map.AddToDormantGrids(grid))
+            TC_LOG_DEBUG("maps", "Grid[%u, %u] on map %u moved to DORMANT state", grid.getX(), grid.getY(), map.GetId());
+        else if (!map.UnloadGrid(grid, false))
         {
             TC_LOG_DEBUG("maps", "Grid[%u, %u] for map %u differed unloading due to players or active objects nearby", grid.getX(), grid.getY(), map.GetId());
             map.ResetGridExpiry(grid);
         }
     }
 }
+
+void DormantState::Update(Map&, NGridType&, GridInfo&, uint32) const
+{
+    // left by an active object loading it again or evicted by Map::TrimDormantGrids
+}
@@ -60,4 +60,10 @@ class RemovalState : public GridState
     public:
         void Update(Map &, NGridType &, GridInfo &, uint32 t_diff) const;
 };
+
+class DormantState : public GridState
+{
+    public:
+        void Update(Map &, NGridType &, GridInfo &, uint32 t_diff) const;
+};
 #endif
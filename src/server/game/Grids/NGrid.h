@@ -64,7 +64,8 @@ typedef enum
     GRID_STATE_ACTIVE = 1,
     GRID_STATE_IDLE = 2,
     GRID_STATE_REMOVAL= 3,
-    MAX_GRID_STATE = 4
+    GRID_STATE_DORMANT = 4,                                 // unload delay expired, kept loaded in the dormant grid pool of the map
+    MAX_GRID_STATE = 5
 } grid_state_t;
 
 template
@@ -180,6 +181,16 @@ class NGrid
             return count;
         }
 
+        template<class T>
+        uint32 GetGridObjectCountInNGrid() const
+        {
+            uint32 count = 0;
+            for (uint32 x = 0; x < N; ++x)
+                for (uint32 y = 0; y < N; ++y)
+                    count += i_cells[x][y].template GetGridObjectCountInGrid<T>();
+            return count;
+        }
+
     private:
         uint32 i_gridId;
         GridInfo i_GridInfo;
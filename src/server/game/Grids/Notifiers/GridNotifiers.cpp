@@ -258,6 +258,31 @@ void ObjectUpdater::Visit(GridRefManager<T> &m)
             iter->GetSource()->Update(i_timeDiff);
 }
 
+void ObjectUpdater::Visit(CreatureMapType& m)
+{
+    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        Creature* creature = iter->GetSource();
+        if (!creature->IsInWorld())
+            continue;
+
+        uint32 diff = i_timeDiff;
+        if (i_reducedUpdateInterval && creature->CanHaveReducedUpdates() && !i_map->IsInUpdateInterestCell(creature))
+        {
+            if (creature->DeferUpdate(i_timeDiff, i_reducedUpdateInterval))
+            {
+                ++i_skippedCreatureUpdates;
+                continue;
+            }
+
+            diff = 0;
+        }
+
+        ++i_creatureUpdates;
+        creature->Update(creature->TakeDeferredUpdateDiff(diff));
+    }
+}
+
 bool AnyDeadUnitObjectInRangeCheck::operator()(Player* u)
 {
     return !u->IsAlive() && !u->HasAuraType(SPELL_AURA_GHOST) && i_searchObj->IsWithinDistInMap(u, i_range);
@@ -288,7 +313,6 @@ bool AnyDeadUnitSpellTargetInRangeCheck::operator()(Creature* u)
     return AnyDeadUnitObjectInRangeCheck::operator()(u) && i_check(u);
 }
 
-template void ObjectUpdater::Visit<Creature>(CreatureMapType&);
 template void ObjectUpdater::Visit<GameObject>(GameObjectMapType&);
 template void ObjectUpdater::Visit<DynamicObject>(DynamicObjectMapType&);
 template void ObjectUpdater::Visit<AreaTrigger>(AreaTriggerMapType &);
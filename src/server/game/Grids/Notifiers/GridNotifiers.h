@@ -132,8 +132,14 @@ namespace Trinity
     struct ObjectUpdater
     {
         uint32 i_timeDiff;
-        explicit ObjectUpdater(const uint32 diff) : i_timeDiff(diff) { }
+        Map* i_map;
+        uint32 i_reducedUpdateInterval;                     // 0 updates every creature each tick
+        uint32 i_creatureUpdates;
+        uint32 i_skippedCreatureUpdates;
+        explicit ObjectUpdater(const uint32 diff, Map* map = nullptr, uint32 reducedUpdateInterval = 0)
+            : i_timeDiff(diff), i_map(map), i_reducedUpdateInterval(reducedUpdateInterval), i_creatureUpdates(0), i_skippedCreatureUpdates(0) { }
         template<class T> void Visit(GridRefManager<T> &m);
+        void Visit(CreatureMapType &m);
         void Visit(PlayerMapType &) { }
         void Visit(CorpseMapType &) { }
     };
@@ -259,13 +259,43 @@ namespace LuaGlobalFunctions
         return 1;
     }
 
-    // ReloadEluna() - Reloads eluna
+    // ReloadEluna() - Reloads eluna on the next world update
     int ReloadEluna(lua_State* L)
     {
-        StartEluna(true);
+        Eluna::RequestReload();
         return 0;
     }
 
+    // SendStateMessage(channel, message[, mapId, instanceId]) - Queues a message for the states of mapId, -1 (default) is the world state and instanceId 0 (default) every instance
+    int SendStateMessage(lua_State* L)
+    {
+        std::string channel = luaL_checkstring(L, 1);
+        std::string message = luaL_checkstring(L, 2);
+        int32 mapId = luaL_optint(L, 3, -1);
+        uint32 instanceId = luaL_optunsigned(L, 4, 0);
+
+        sEluna->SendStateMessage(mapId, instanceId, channel, message);
+        return 0;
+    }
+
+    // BroadcastStateMessage(channel, message) - Queues a message for every other state
+    int BroadcastStateMessage(lua_State* L)
+    {
+        std::string channel = luaL_checkstring(L, 1);
+        std::string message = luaL_checkstring(L, 2);
+
+        sEluna->BroadcastStateMessage(channel, message);
+        return 0;
+    }
+
+    // GetStateMapId() - Returns the map id and instance id of the running state, -1 for the world state
+    int GetStateMapId(lua_State* L)
+    {
+        sEluna->Push(L, sEluna->GetMapId());
+        sEluna->Push(L, sEluna->GetInstanceId());
+        return 2;
+    }
+
     // GetPlayerByGUID(guid) - Gets Player object by its guid
     int GetPlayerByGUID(lua_State* L)
     {
@@ -21,7 +21,7 @@ HookMgr* HookMgr::instance()
 
 void HookMgr::OnWorldUpdate(uint32 diff)
 {
-    sEluna->m_EventMgr.Update(diff);
+    sEluna->Update(diff);
     for (std::vector<int>::const_iterator itr = sEluna->ServerEventBindings[WORLD_EVENT_ON_UPDATE].begin();
         itr != sEluna->ServerEventBindings[WORLD_EVENT_ON_UPDATE].end(); ++itr)
     {
@@ -184,6 +184,21 @@ void HookMgr::OnEngineRestart()
     }
 }
 
+void HookMgr::OnStateMessage(std::string const& channel, std::string const& message, int32 fromMapId, uint32 fromInstanceId)
+{
+    for (std::vector<int>::const_iterator itr = sEluna->ServerEventBindings[ELUNA_EVENT_ON_STATE_MESSAGE].begin();
+        itr != sEluna->ServerEventBindings[ELUNA_EVENT_ON_STATE_MESSAGE].end(); ++itr)
+    {
+        sEluna->BeginCall((*itr));
+        sEluna->Push(sEluna->L, ELUNA_EVENT_ON_STATE_MESSAGE);
+        sEluna->Push(sEluna->L, channel);
+        sEluna->Push(sEluna->L, message);
+        sEluna->Push(sEluna->L, fromMapId);
+        sEluna->Push(sEluna->L, fromInstanceId);
+        sEluna->ExecuteCall(5, 0);
+    }
+}
+
 // item
 bool HookMgr::OnDummyEffect(Unit* pCaster, uint32 spellId, SpellEffIndex effIndex, Item* pTarget)
 {
@@ -1233,7 +1248,7 @@ public:
 
     void OnUpdate(uint32 diff) override
     {
-        sEluna->m_EventMgr.Update(diff);
+        sEluna->Update(diff);
         for (std::vector<int>::const_iterator itr = sEluna->ServerEventBindings[WORLD_EVENT_ON_UPDATE].begin();
             itr != sEluna->ServerEventBindings[WORLD_EVENT_ON_UPDATE].end(); ++itr)
         {
@@ -89,6 +89,9 @@ enum ServerEvents
     AUCTION_EVENT_ON_SUCCESSFUL             =     28,       // (event, AHObject)
     AUCTION_EVENT_ON_EXPIRE                 =     29,       // (event, AHObject)
 
+    // Eluna
+    ELUNA_EVENT_ON_STATE_MESSAGE            =     30,       // (event, channel, message, fromMapId, fromInstanceId)
+
     SERVER_EVENT_COUNT
 };
 
@@ -281,6 +284,7 @@ struct HookMgr
     void OnResurrect(Player* pPlayer);
     InventoryResult OnCanUseItem(const Player* pPlayer, uint32 itemEntry);
     void OnEngineRestart();
+    void OnStateMessage(std::string const& channel, std::string const& message, int32 fromMapId, uint32 fromInstanceId);
     /* Item */
     bool OnDummyEffect(Unit* pCaster, uint32 spellId, SpellEffIndex effIndex, Item* pTarget);
     bool OnQuestAccept(Player* pPlayer, Item* pItem, Quest const* pQuest);
@@ -35,134 +35,402 @@ template<> const char* GetTName<Corpse>() { return "Corpse"; }
 template<> const char* GetTName<Weather>() { return "Weather"; }
 template<> const char* GetTName<AuctionHouseObject>() { return "AuctionHouse"; }
 
+std::mutex Eluna::_statesLock;
+std::vector<Eluna*> Eluna::_states;
+std::atomic<bool> Eluna::_reloadRequested(false);
+
+static thread_local Eluna* currentState = nullptr;
+
 void StartEluna(bool restart)
 {
+    if (restart)
+    {
+        // Map states are created again with the new scripts on their next update
+        sMapMgr->DoForAllMaps([](Map* map)
+        {
+            map->ResetElunaState();
+        });
+    }
+    else
+        AddElunaScripts();
+
+    Eluna* previous = Eluna::SetCurrent(Eluna::GetWorldState().get());
+    Eluna::GetWorldState()->Load(restart);
+    Eluna::SetCurrent(previous);
+
+    if (restart)
+    {
+        //! Iterate over every supported source type (creature and gameobject)
+        //! Not entirely sure how this will affect units in non-loaded grids.
+        sMapMgr->DoForAllMaps([](Map* map)
+        {
+            ElunaMapScope elunaScope(map);
+
+            for (auto itr : map->GetCreatureBySpawnIdStore())
+            {
+                if (itr.second->IsInWorld())
+                    if(sEluna->CreatureEventBindings->GetBindMap(itr.second->GetEntry())) // update all AI or just Eluna?
+                        itr.second->AIM_Initialize();
+            }
+
+            for (auto itr : map->GetGameObjectBySpawnIdStore())
+            {
+                if (itr.second->IsInWorld())
+                    if(sEluna->GameObjectEventBindings->GetBindMap(itr.second->GetEntry())) // update all AI or just Eluna?
+                        itr.second->AIM_Initialize();
+            }
+        });
+    }
+}
+
+void Eluna::Load(bool restart)
+{
+    bool worldState = _mapId < 0;
+
     if (restart)
     {
         sHookMgr->OnEngineRestart();
         TC_LOG_INFO("server.loading", "[Eluna]: Restarting Lua Engine");
 
-        if (sEluna->L)
+        if (L)
         {
             // Unregisters and stops all timed events
-            sEluna->m_EventMgr.RemoveEvents();
+            m_EventMgr.RemoveEvents();
 
             // Remove bindings
-            for (std::map<int, std::vector<int> >::iterator itr = sEluna->ServerEventBindings.begin(); itr != sEluna->ServerEventBindings.end(); ++itr)
+            for (std::map<int, std::vector<int> >::iterator itr = ServerEventBindings.begin(); itr != ServerEventBindings.end(); ++itr)
             {
                 for (std::vector<int>::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-                    luaL_unref(sEluna->L, LUA_REGISTRYINDEX, (*it));
+                    luaL_unref(L, LUA_REGISTRYINDEX, (*it));
                 itr->second.clear();
             }
 
-            for (std::map<int, std::vector<int> >::iterator itr = sEluna->PlayerEventBindings.begin(); itr != sEluna->PlayerEventBindings.end(); ++itr)
+            for (std::map<int, std::vector<int> >::iterator itr = PlayerEventBindings.begin(); itr != PlayerEventBindings.end(); ++itr)
             {
                 for (std::vector<int>::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-                    luaL_unref(sEluna->L, LUA_REGISTRYINDEX, (*it));
+                    luaL_unref(L, LUA_REGISTRYINDEX, (*it));
                 itr->second.clear();
             }
 
-            for (std::map<int, std::vector<int> >::iterator itr = sEluna->VehicleEventBindings.begin(); itr != sEluna->VehicleEventBindings.end(); ++itr)
+            for (std::map<int, std::vector<int> >::iterator itr = VehicleEventBindings.begin(); itr != VehicleEventBindings.end(); ++itr)
             {
                 for (std::vector<int>::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-                    luaL_unref(sEluna->L, LUA_REGISTRYINDEX, (*it));
+                    luaL_unref(L, LUA_REGISTRYINDEX, (*it));
                 itr->second.clear();
             }
 
-            for (std::map<int, std::vector<int> >::iterator itr = sEluna->GuildEventBindings.begin(); itr != sEluna->GuildEventBindings.end(); ++itr)
+            for (std::map<int, std::vector<int> >::iterator itr = GuildEventBindings.begin(); itr != GuildEventBindings.end(); ++itr)
             {
                 for (std::vector<int>::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-                    luaL_unref(sEluna->L, LUA_REGISTRYINDEX, (*it));
+                    luaL_unref(L, LUA_REGISTRYINDEX, (*it));
                 itr->second.clear();
             }
 
-            for (std::map<int, std::vector<int> >::iterator itr = sEluna->GroupEventBindings.begin(); itr != sEluna->GroupEventBindings.end(); ++itr)
+            for (std::map<int, std::vector<int> >::iterator itr = GroupEventBindings.begin(); itr != GroupEventBindings.end(); ++itr)
             {
                 for (std::vector<int>::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-                    luaL_unref(sEluna->L, LUA_REGISTRYINDEX, (*it));
+                    luaL_unref(L, LUA_REGISTRYINDEX, (*it));
                 itr->second.clear();
             }
-            sEluna->CreatureEventBindings->Clear();
-            sEluna->CreatureGossipBindings->Clear();
-            sEluna->GameObjectEventBindings->Clear();
-            sEluna->GameObjectGossipBindings->Clear();
-            sEluna->ItemEventBindings->Clear();
-            sEluna->ItemGossipBindings->Clear();
-            sEluna->playerGossipBindings->Clear();
-
-            lua_close(sEluna->L);
+            CreatureEventBindings->Clear();
+            CreatureGossipBindings->Clear();
+            GameObjectEventBindings->Clear();
+            GameObjectGossipBindings->Clear();
+            ItemEventBindings->Clear();
+            ItemGossipBindings->Clear();
+            playerGossipBindings->Clear();
+
+            lua_close(L);
         }
+
+        // References of events that are still queued belong to the closed state
+        ++_generation;
+        std::lock_guard<std::mutex> lock(_inboxLock);
+        _pendingUnrefs.clear();
     }
-    else
-        AddElunaScripts();
 
-    sEluna->L = luaL_newstate();
-    TC_LOG_INFO("server.loading", "");
-    TC_LOG_INFO("server.loading", "[Eluna]: Lua Engine loaded.");
-    TC_LOG_INFO("server.loading", "");
+    L = luaL_newstate();
+    if (worldState)
+    {
+        TC_LOG_INFO("server.loading", "");
+        TC_LOG_INFO("server.loading", "[Eluna]: Lua Engine loaded.");
+        TC_LOG_INFO("server.loading", "");
+    }
 
 	std::string lua_folderpath = sConfigMgr->GetStringDefault("Eluna.ScriptPath", "lua_scripts");
 
     LoadedScripts loadedScripts;
-    sEluna->LoadDirectory(lua_folderpath.c_str(), &loadedScripts);
-    luaL_openlibs(sEluna->L);
+    LoadDirectory(lua_folderpath.c_str(), &loadedScripts);
+    luaL_openlibs(L);
     // Register functions here
-    RegisterFunctions(sEluna->L);
+    RegisterFunctions(L);
 
     uint32 count = 0;
     char filename[200];
     for (std::set<std::string>::const_iterator itr = loadedScripts.begin(); itr !=  loadedScripts.end(); ++itr)
     {
         strcpy(filename, itr->c_str());
-        if (luaL_loadfile(sEluna->L, filename) != 0)
+        if (luaL_loadfile(L, filename) != 0)
         {
             TC_LOG_INFO("server.loading", "[Eluna]: Error loading file `%s`.", itr->c_str());
-            sEluna->report(sEluna->L);
+            report(L);
         }
         else
         {
-            int err = lua_pcall(sEluna->L, 0, 0, 0);
+            int err = lua_pcall(L, 0, 0, 0);
             if (err != 0 && err == LUA_ERRRUN)
             {
-                TC_LOG_INFO("server.loading", "server.loading", "[Eluna]: Error loading file `%s`.", itr->c_str());
-                sEluna->report(sEluna->L);
+                TC_LOG_INFO("server.loading", "[Eluna]: Error loading file `%s`.", itr->c_str());
+                report(L);
             }
         }
         ++count;
     }
 
-    
-    if (restart)
+    if (worldState)
     {
-        //! Iterate over every supported source type (creature and gameobject)
-        //! Not entirely sure how this will affect units in non-loaded grids.
-        sMapMgr->DoForAllMaps([](Map* map)
+        TC_LOG_INFO("server.loading", "[Eluna]: Loaded %u Lua scripts..", count);
+        TC_LOG_INFO("server.loading", "");
+    }
+    else
+        TC_LOG_DEBUG("server.loading", "[Eluna]: Loaded %u Lua scripts for map %d instance %u", count, _mapId, _instanceId);
+}
+
+Eluna* Eluna::instance()
+{
+    if (currentState)
+        return currentState;
+    return GetWorldState().get();
+}
+
+Eluna* Eluna::SetCurrent(Eluna* state)
+{
+    Eluna* previous = currentState;
+    currentState = state;
+    return previous;
+}
+
+std::shared_ptr<Eluna> const& Eluna::GetWorldState()
+{
+    static std::shared_ptr<Eluna> worldState = std::make_shared<Eluna>();
+    return worldState;
+}
+
+bool Eluna::IsPerMapStates()
+{
+    return sWorld->getBoolConfig(CONFIG_BOOL_ELUNA_ENABLED) && sWorld->getBoolConfig(CONFIG_BOOL_ELUNA_PER_MAP_STATES);
+}
+
+std::shared_ptr<Eluna> Eluna::CreateMapState(Map* map)
+{
+    std::shared_ptr<Eluna> state = std::make_shared<Eluna>(int32(map->GetId()), map->GetInstanceId());
+    Eluna* previous = SetCurrent(state.get());
+    state->Load(false);
+    SetCurrent(previous);
+    return state;
+}
+
+void Eluna::Update(uint32 diff)
+{
+    if (_mapId < 0 && _reloadRequested.exchange(false))
+        StartEluna(true);
+
+    std::vector<int> unrefs;
+    std::vector<StateMessage> messages;
+    {
+        std::lock_guard<std::mutex> lock(_inboxLock);
+        unrefs.swap(_pendingUnrefs);
+        messages.swap(_inbox);
+    }
+
+    Eluna* previous = SetCurrent(this);
+
+    for (int funcRef : unrefs)
+        luaL_unref(L, LUA_REGISTRYINDEX, funcRef);
+
+    for (StateMessage const& message : messages)
+        sHookMgr->OnStateMessage(message.Channel, message.Message, message.FromMapId, message.FromInstanceId);
+
+    m_EventMgr.Update(diff);
+
+    SetCurrent(previous);
+}
+
+void Eluna::Unref(int funcRef)
+{
+    if (instance() == this)
+    {
+        luaL_unref(L, LUA_REGISTRYINDEX, funcRef);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_inboxLock);
+    _pendingUnrefs.push_back(funcRef);
+}
+
+void Eluna::SendStateMessage(int32 mapId, uint32 instanceId, std::string const& channel, std::string const& message)
+{
+    // Without per map states the world state runs every script
+    bool perMapStates = IsPerMapStates();
+
+    std::lock_guard<std::mutex> lock(_statesLock);
+    for (Eluna* state : _states)
+    {
+        if (perMapStates ? (state->_mapId != mapId || (instanceId && state->_instanceId != instanceId)) : state->_mapId >= 0)
+            continue;
+
+        std::lock_guard<std::mutex> inboxLock(state->_inboxLock);
+        state->_inbox.push_back({ channel, message, _mapId, _instanceId });
+    }
+}
+
+void Eluna::BroadcastStateMessage(std::string const& channel, std::string const& message)
+{
+    std::lock_guard<std::mutex> lock(_statesLock);
+    for (Eluna* state : _states)
+    {
+        if (state == this)
+            continue;
+
+        std::lock_guard<std::mutex> inboxLock(state->_inboxLock);
+        state->_inbox.push_back({ channel, message, _mapId, _instanceId });
+    }
+}
+
+std::vector<Eluna::StateStats> Eluna::GetStateStats()
+{
+    std::vector<StateStats> stats;
+
+    std::lock_guard<std::mutex> lock(_statesLock);
+    stats.reserve(_states.size());
+    for (Eluna* state : _states)
+        stats.push_back({ state->_mapId, state->_instanceId, state->_calls.load(std::memory_order_relaxed), state->_totalNs.load(std::memory_order_relaxed),
+            state->_maxNs.load(std::memory_order_relaxed), state->_errors.load(std::memory_order_relaxed) });
+
+    return stats;
+}
+
+void Eluna::ResetStateStats()
+{
+    std::lock_guard<std::mutex> lock(_statesLock);
+    for (Eluna* state : _states)
+    {
+        state->_calls = 0;
+        state->_totalNs = 0;
+        state->_maxNs = 0;
+        state->_errors = 0;
+    }
+}
+
+bool Eluna::Benchmark(Player* player, Unit* target, uint32 count, BenchmarkResult& result)
+{
+    static char const* const handlers[] =
+    {
+        "return function(event, killer, killed) return killer:GetName(), killed:GetEntry(), killed:GetLevel(), killed:GetGUID() end",
+        "return function(event, player, msg, type, lang) if msg:find(\"^#\") then return false end return player:GetLevel() end"
+    };
+
+    if (!L)
+        return false;
+
+    int refs[2];
+    for (uint8 i = 0; i < 2; ++i)
+    {
+        lua_settop(L, 0);
+        if (luaL_loadstring(L, handlers[i]) || lua_pcall(L, 0, 1, 0))
         {
-            for (auto itr : map->GetCreatureBySpawnIdStore())
-            {
-                if (itr.second->IsInWorld())
-                    if(sEluna->CreatureEventBindings->GetBindMap(itr.second->GetEntry())) // update all AI or just Eluna?
-                        itr.second->AIM_Initialize();
-            }
+            report(L);
+            if (i)
+                luaL_unref(L, LUA_REGISTRYINDEX, refs[0]);
+            return false;
+        }
+        refs[i] = luaL_ref(L, LUA_REGISTRYINDEX);
+    }
 
-            for (auto itr : map->GetGameObjectBySpawnIdStore())
-            {
-                if (itr.second->IsInWorld())
-                    if(sEluna->GameObjectEventBindings->GetBindMap(itr.second->GetEntry())) // update all AI or just Eluna?
-                        itr.second->AIM_Initialize();
-            }
-        });
+    typedef std::chrono::steady_clock Clock;
+    std::string const msg = "benchmark message";
+
+    Clock::time_point start = Clock::now();
+    for (uint32 i = 0; i < count; ++i)
+    {
+        lua_settop(L, 0);
+        Push(L, PLAYER_EVENT_ON_KILL_CREATURE);
+        Push(L, player);
+        Push(L, target);
     }
-    
-    
-    TC_LOG_INFO("server.loading", "[Eluna]: Loaded %u Lua scripts..", count);
-    TC_LOG_INFO("server.loading", "");
+    lua_settop(L, 0);
+    result.PushNs = uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+
+    start = Clock::now();
+    for (uint32 i = 0; i < count; ++i)
+    {
+        BeginCall(refs[0]);
+        Push(L, PLAYER_EVENT_ON_KILL_CREATURE);
+        Push(L, player);
+        Push(L, target);
+        ExecuteCall(3, 0);
+    }
+    result.KillNs = uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+
+    start = Clock::now();
+    for (uint32 i = 0; i < count; ++i)
+    {
+        BeginCall(refs[1]);
+        Push(L, PLAYER_EVENT_ON_CHAT);
+        Push(L, player);
+        Push(L, msg);
+        Push(L, uint32(CHAT_MSG_SAY));
+        Push(L, uint32(LANG_UNIVERSAL));
+        ExecuteCall(5, 1);
+        EndCall(1);
+    }
+    result.ChatNs = uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+
+    lua_settop(L, 0);
+    luaL_unref(L, LUA_REGISTRYINDEX, refs[0]);
+    luaL_unref(L, LUA_REGISTRYINDEX, refs[1]);
+    return true;
 }
 
-Eluna* Eluna::instance()
+ElunaMapScope::ElunaMapScope(Map* map) : _state(map->GetElunaState()), _previous(nullptr)
+{
+    // Falling back to the world state unlocked would run it next to the map threads that execute its timed events
+    if (!_state && Eluna::IsPerMapStates())
+        _state = Eluna::GetWorldState();
+
+    if (!_state)
+        return;
+
+    _lock = std::unique_lock<std::recursive_mutex>(_state->GetLock());
+    _previous = Eluna::SetCurrent(_state.get());
+}
+
+ElunaMapScope::~ElunaMapScope()
+{
+    if (_state)
+        Eluna::SetCurrent(_previous);
+}
+
+ElunaWorldScope::ElunaWorldScope() : _lock(Eluna::GetWorldState()->GetLock()), _previous(Eluna::SetCurrent(Eluna::GetWorldState().get()))
 {
-    static Eluna instance;
-    return &instance;
+}
+
+ElunaWorldScope::~ElunaWorldScope()
+{
+    if (_lock.owns_lock())
+        Eluna::SetCurrent(_previous);
+}
+
+void ElunaWorldScope::Release()
+{
+    Eluna::SetCurrent(_previous);
+    _lock.unlock();
+}
+
+void ElunaWorldScope::Reacquire()
+{
+    _lock.lock();
+    _previous = Eluna::SetCurrent(Eluna::GetWorldState().get());
 }
 
 // Loads lua scripts from given directory
@@ -294,8 +562,18 @@ bool Eluna::ExecuteCall(uint8 params, uint8 res)
 
     if (lua_type(L, top - params) == LUA_TFUNCTION) // is function
     {
-        if (lua_pcall(L, params, res, 0))
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        int err = lua_pcall(L, params, res, 0);
+        uint64 elapsedNs = uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+        _calls.fetch_add(1, std::memory_order_relaxed);
+        _totalNs.fetch_add(elapsedNs, std::memory_order_relaxed);
+        uint64 maxNs = _maxNs.load(std::memory_order_relaxed);
+        while (elapsedNs > maxNs && !_maxNs.compare_exchange_weak(maxNs, elapsedNs, std::memory_order_relaxed));
+
+        if (err)
         {
+            _errors.fetch_add(1, std::memory_order_relaxed);
             report(L);
             ret = false;
         }
@@ -332,19 +610,19 @@ void Eluna::Push(lua_State* L)
 
 void Eluna::Push(lua_State* L, uint64 l)
 {
-    std::ostringstream ss;
-    ss << "0x" << std::hex << l;
-    sEluna->Push(L, ss.str());
+    char buff[24];
+    snprintf(buff, sizeof(buff), "0x%" PRIx64, l);
+    lua_pushstring(L, buff);
 }
 
 void Eluna::Push(lua_State* L, int64 l)
 {
-    std::ostringstream ss;
+    char buff[24];
     if (l < 0)
-        ss << "-0x" << std::hex << -l;
+        snprintf(buff, sizeof(buff), "-0x%" PRIx64, uint64(-l));
     else
-        ss << "0x" << std::hex << l;
-    sEluna->Push(L, ss.str());
+        snprintf(buff, sizeof(buff), "0x%" PRIx64, uint64(l));
+    lua_pushstring(L, buff);
 }
 
 void Eluna::Push(lua_State* L, uint32 u)
@@ -372,9 +650,9 @@ void Eluna::Push(lua_State* L, bool b)
     lua_pushboolean(L, b);
 }
 
-void Eluna::Push(lua_State* L, std::string str)
+void Eluna::Push(lua_State* L, std::string const& str)
 {
-    lua_pushstring(L, str.c_str());
+    lua_pushlstring(L, str.c_str(), str.size());
 }
 
 void Eluna::Push(lua_State* L, const char* str)
@@ -523,7 +801,7 @@ void Eluna::Register(uint8 regtype, uint32 id, uint32 evt, int functionRef)
                     return;
                 }
 
-                sEluna->CreatureEventBindings->Insert(id, evt, functionRef);
+                CreatureEventBindings->Insert(id, evt, functionRef);
                 return;
             }
             break;
@@ -537,7 +815,7 @@ void Eluna::Register(uint8 regtype, uint32 id, uint32 evt, int functionRef)
                     return;
                 }
 
-                sEluna->CreatureGossipBindings->Insert(id, evt, functionRef);
+                CreatureGossipBindings->Insert(id, evt, functionRef);
                 return;
             }
             break;
@@ -551,7 +829,7 @@ void Eluna::Register(uint8 regtype, uint32 id, uint32 evt, int functionRef)
                     return;
                 }
 
-                sEluna->GameObjectEventBindings->Insert(id, evt, functionRef);
+                GameObjectEventBindings->Insert(id, evt, functionRef);
                 return;
             }
             break;
@@ -565,7 +843,7 @@ void Eluna::Register(uint8 regtype, uint32 id, uint32 evt, int functionRef)
                     return;
                 }
 
-                sEluna->GameObjectGossipBindings->Insert(id, evt, functionRef);
+                GameObjectGossipBindings->Insert(id, evt, functionRef);
                 return;
             }
             break;
@@ -579,7 +857,7 @@ void Eluna::Register(uint8 regtype, uint32 id, uint32 evt, int functionRef)
                     return;
                 }
 
-                sEluna->ItemEventBindings->Insert(id, evt, functionRef);
+                ItemEventBindings->Insert(id, evt, functionRef);
                 return;
             }
             break;
@@ -593,7 +871,7 @@ void Eluna::Register(uint8 regtype, uint32 id, uint32 evt, int functionRef)
                     return;
                 }
 
-                sEluna->ItemGossipBindings->Insert(id, evt, functionRef);
+                ItemGossipBindings->Insert(id, evt, functionRef);
                 return;
             }
             break;
@@ -601,7 +879,7 @@ void Eluna::Register(uint8 regtype, uint32 id, uint32 evt, int functionRef)
         case REGTYPE_PLAYER_GOSSIP:
             if (evt < GOSSIP_EVENT_COUNT)
             {
-                sEluna->playerGossipBindings->Insert(id, evt, functionRef);
+                playerGossipBindings->Insert(id, evt, functionRef);
                 return;
             }
             break;
@@ -618,7 +896,7 @@ void Eluna::ElunaBind::Clear()
     for (ElunaEntryMap::iterator itr = Bindings.begin(); itr != Bindings.end(); ++itr)
     {
         for (ElunaBindingMap::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-            luaL_unref(sEluna->L, LUA_REGISTRYINDEX, it->second);
+            luaL_unref(E->L, LUA_REGISTRYINDEX, it->second);
         itr->second.clear();
     }
     Bindings.clear();
@@ -628,45 +906,70 @@ void Eluna::ElunaBind::Insert(uint32 entryId, uint32 eventId, int funcRef)
 {
     if (Bindings[entryId][eventId])
     {
-        luaL_error(sEluna->L, "A function is already registered for entry (%d) event (%d)", entryId, eventId);
-        luaL_unref(sEluna->L, LUA_REGISTRYINDEX, funcRef); // free the unused ref
+        luaL_error(E->L, "A function is already registered for entry (%d) event (%d)", entryId, eventId);
+        luaL_unref(E->L, LUA_REGISTRYINDEX, funcRef); // free the unused ref
     }
     else
         Bindings[entryId][eventId] = funcRef;
 }
 
-EventMgr::LuaEvent::LuaEvent(EventProcessor* _events, int _funcRef, uint32 _delay, uint32 _calls, Object* _obj) :
-    events(_events), funcRef(_funcRef), delay(_delay), calls(_calls), obj(_obj)
+EventMgr::LuaEvent::LuaEvent(EventMgr* mgr, EventProcessor* _events, int _funcRef, uint32 _delay, uint32 _calls, Object* _obj) :
+    owner(mgr->Owner->weak_from_this()), generation(mgr->Owner->GetGeneration()), obj(_obj), funcRef(_funcRef), delay(_delay), calls(_calls), events(_events)
 {
     hasObject = _obj;
     if (_events)
-        sEluna->m_EventMgr.LuaEvents[_events].insert(this); // Able to access the event if we have the processor
+    {
+        std::lock_guard<std::mutex> lock(mgr->LuaEventsLock);
+        mgr->LuaEvents[_events].insert(this); // Able to access the event if we have the processor
+    }
 }
 
 EventMgr::LuaEvent::~LuaEvent()
 {
+    std::shared_ptr<Eluna> state = owner.lock();
+    if (!state) // The lua state is already closed
+        return;
+
     if (events)
     {
         // Attempt to remove the pointer from LuaEvents
-        EventMgr::EventMap::const_iterator it = sEluna->m_EventMgr.LuaEvents.find(events); // Get event set
-        if (it != sEluna->m_EventMgr.LuaEvents.end())
-            sEluna->m_EventMgr.LuaEvents[events].erase(this); // Remove pointer
+        std::lock_guard<std::mutex> lock(state->m_EventMgr.LuaEventsLock);
+        EventMgr::EventMap::iterator it = state->m_EventMgr.LuaEvents.find(events); // Get event set
+        if (it != state->m_EventMgr.LuaEvents.end())
+            it->second.erase(this); // Remove pointer
     }
-    luaL_unref(sEluna->L, LUA_REGISTRYINDEX, funcRef); // Free lua function ref
+
+    if (generation == state->GetGeneration())
+        state->Unref(funcRef); // Free lua function ref
 }
 
 bool EventMgr::LuaEvent::Execute(uint64 time, uint32 diff)
 {
+    std::shared_ptr<Eluna> state = owner.lock();
+    if (!state || generation != state->GetGeneration()) // Scripts were reloaded or the map state unloaded
+        return true;
     if (hasObject && !obj) // interrupt event if object doesnt exist anymore and should exist.
         return true;
+
+    // Events registered from another state run while that state is idle, never wait on it to not deadlock two maps
+    // The world state is held by the world thread outside the map updates, so its events run on map threads in between
+    std::unique_lock<std::recursive_mutex> lock(state->GetLock(), std::defer_lock);
+    if (state.get() != Eluna::instance() && !lock.try_lock())
+    {
+        events->AddEvent(this, events->CalculateTime(1));
+        return false;
+    }
+
     if (calls != 1)
         events->AddEvent(this, events->CalculateTime(delay)); // Reschedule before calling incase RemoveEvents used
-    sEluna->BeginCall(funcRef);
-    sEluna->Push(sEluna->L, funcRef);
-    sEluna->Push(sEluna->L, delay);
-    sEluna->Push(sEluna->L, calls);
-    sEluna->Push(sEluna->L, obj);
-    sEluna->ExecuteCall(4, 0);
+    Eluna* previous = Eluna::SetCurrent(state.get());
+    state->BeginCall(funcRef);
+    state->Push(state->L, funcRef);
+    state->Push(state->L, delay);
+    state->Push(state->L, calls);
+    state->Push(state->L, obj);
+    state->ExecuteCall(4, 0);
+    Eluna::SetCurrent(previous);
     return !(!calls || --calls); // Destory (true) event if not run
 }
 
@@ -16,6 +16,9 @@ extern "C"
 
 #include "Includes.h"
 #include "HookMgr.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 typedef std::set<std::string> LoadedScripts;
 
@@ -63,51 +66,47 @@ class ElunaTemplate
             lua_pushcfunction(L, tostringT);
             lua_setfield(L, metatable, "__tostring");
 
-            lua_pushcfunction(L, gcT);
-            lua_setfield(L, metatable, "__gc");
-
             lua_newtable(L);
             lua_setmetatable(L, methods);
+
+            // push looks both up by address instead of hashing the type name
+            lua_pushvalue(L, metatable);
+            lua_rawsetp(L, LUA_REGISTRYINDEX, MetatableKey());
+
+            lua_newtable(L);
+            lua_newtable(L);
+            lua_pushliteral(L, "v");
+            lua_setfield(L, -2, "__mode");
+            lua_setmetatable(L, -2);
+            lua_rawsetp(L, LUA_REGISTRYINDEX, CacheKey());
         }
 
-        static int push(lua_State* L, T const* obj, bool gc = false)
+        // The userdata only holds the pointer, an object pushed again reuses it for as long as lua references it.
+        // An address reused by a new object of the same type maps to an identical userdata, the cache is per type.
+        static int push(lua_State* L, T const* obj)
         {
             if (!obj)
             {
                 lua_pushnil(L);
                 return lua_gettop(L);
             }
-            luaL_getmetatable(L, GetTName<T>());
-            if (lua_isnil(L, -1))
+            lua_rawgetp(L, LUA_REGISTRYINDEX, CacheKey());
+            if (!lua_istable(L, -1))
                 luaL_error(L, "%s missing metatable", GetTName<T>());
-            int idxMt = lua_gettop(L);
-            T const** ptrHold = (T const**)lua_newuserdata(L, sizeof(T**));
-            int ud = lua_gettop(L);
-            if (ptrHold)
+            int cache = lua_gettop(L);
+            lua_rawgetp(L, cache, obj);
+            if (lua_isnil(L, -1))
             {
+                lua_pop(L, 1);
+                T const** ptrHold = (T const**)lua_newuserdata(L, sizeof(T const*));
                 *ptrHold = obj;
-                lua_pushvalue(L, idxMt);
+                lua_rawgetp(L, LUA_REGISTRYINDEX, MetatableKey());
                 lua_setmetatable(L, -2);
-                char name[32];
-                tostring(name, obj);
-                lua_getfield(L, LUA_REGISTRYINDEX, "DO NOT TRASH");
-                if (lua_isnil(L, -1))
-                {
-                    luaL_newmetatable(L, "DO NOT TRASH");
-                    lua_pop(L, 1);
-                }
-                lua_getfield(L, LUA_REGISTRYINDEX, "DO NOT TRASH");
-                if (!gc)
-                {
-                    lua_pushboolean(L, 1);
-                    lua_setfield(L, -2, name);
-                }
-                lua_pop(L, 1);
+                lua_pushvalue(L, -1);
+                lua_rawsetp(L, cache, obj);
             }
-            lua_settop(L, ud);
-            lua_replace(L, idxMt);
-            lua_settop(L, idxMt);
-            return idxMt;
+            lua_replace(L, cache);
+            return cache;
         }
 
         static T* check(lua_State* L, int narg)
@@ -128,21 +127,6 @@ class ElunaTemplate
             return l->mfunc(L, obj);
         }
 
-        static int gcT(lua_State* L)
-        {
-            T* obj = check(L, 1);
-            if (!obj)
-                return 0;
-            lua_getfield(L, LUA_REGISTRYINDEX, "DO NOT TRASH");
-            if (lua_istable(L, -1))
-            {
-                char name[32];
-                tostring(name, obj);
-                lua_getfield(L, -1, std::string(name).c_str());
-            }
-            return 1;
-        }
-
         static int tostringT(lua_State* L)
         {
             char buff[32];
@@ -153,9 +137,17 @@ class ElunaTemplate
             return 1;
         }
 
-        inline static void tostring(char* buff, void const* obj)
+        // Registry keys unique per type, no name is hashed on push
+        static void* MetatableKey()
         {
-            sprintf(buff, "%p", obj);
+            static char key;
+            return &key;
+        }
+
+        static void* CacheKey()
+        {
+            static char key;
+            return &key;
         }
 
         static int index(lua_State* L)
@@ -219,6 +211,8 @@ void SetMethods(lua_State* L, ElunaRegister<T>* methodTable)
     }
 }
 
+class Eluna;
+
 struct EventMgr
 {
     struct LuaEvent;
@@ -227,19 +221,25 @@ struct EventMgr
     typedef std::map<EventProcessor*, EventSet> EventMap;
     typedef std::unordered_map<uint64, EventProcessor> ProcessorMap;
 
+    explicit EventMgr(Eluna* owner) : Owner(owner) { }
+
+    Eluna* Owner; // State the events were registered in
+    std::mutex LuaEventsLock; // Events of objects can be destroyed by another map thread
     EventMap LuaEvents; // LuaEvents[events] = {LuaEvents}
     ProcessorMap Processors; // Processors[guid] = processor
     EventProcessor GlobalEvents;
 
     struct LuaEvent : public BasicEvent
     {
-        LuaEvent(EventProcessor* _events, int _funcRef, uint32 _delay, uint32 _calls, Object* _obj);
+        LuaEvent(EventMgr* mgr, EventProcessor* _events, int _funcRef, uint32 _delay, uint32 _calls, Object* _obj);
 
         ~LuaEvent();
 
         // Should never execute on dead events
         bool Execute(uint64 time, uint32 diff);
 
+        std::weak_ptr<Eluna> owner; // State of funcRef, expires when the state is unloaded
+        uint32 generation; // Reloads of the state invalidate funcRef
         bool hasObject; // Dont call event if object no longer exists
         Object* obj;    // Object to push
         int funcRef;    // Lua function reference ID, also used as event ID
@@ -273,6 +273,7 @@ struct EventMgr
     {
         if (!events)
             return;
+        std::lock_guard<std::mutex> lock(LuaEventsLock);
         auto it = LuaEvents.find(events); // Get event set
         if (it == LuaEvents.end())
             return;
@@ -286,17 +287,20 @@ struct EventMgr
         for (auto & Processor : Processors)
             Processor.second.KillAllEvents(true);
         Processors.clear();
+        std::lock_guard<std::mutex> lock(LuaEventsLock);
         for (auto & LuaEvent : LuaEvents) // loop processors
-            KillAllEvents(LuaEvent.first);
+            for (auto itr : LuaEvent.second)
+                itr->to_Abort = true;
         LuaEvents.clear(); // remove pointer sets
     }
-    
+
     // Remove timed events from processor
     void RemoveEvents(EventProcessor* events)
     {
         if (!events)
             return;
         KillAllEvents(events);
+        std::lock_guard<std::mutex> lock(LuaEventsLock);
         LuaEvents.erase(events); // remove pointer set
     }
 
@@ -314,7 +318,7 @@ struct EventMgr
     {
         if (!events || funcRef <= 0) // If funcRef <= 0, function reference failed
             return 0; // on fail always return 0. funcRef can be negative.
-        events->AddEvent(new LuaEvent(events, funcRef, delay, calls, obj), events->CalculateTime(delay));
+        events->AddEvent(new LuaEvent(this, events, funcRef, delay, calls, obj), events->CalculateTime(delay));
         return funcRef; // return the event ID
     }
 
@@ -326,7 +330,7 @@ struct EventMgr
         return AddEvent(&Processors[guid], funcRef, delay, calls, obj);
     }
 
-    // Finds the event that has the ID from events
+    // Finds the event that has the ID from events, LuaEventsLock must be held
     LuaEvent* GetEvent(EventProcessor* events, int eventId)
     {
         if (!events || !eventId)
@@ -346,6 +350,7 @@ struct EventMgr
     {
         if (!events || !eventId)
             return false;
+        std::lock_guard<std::mutex> lock(LuaEventsLock);
         LuaEvent* luaEvent = GetEvent(events, eventId);
         if (!luaEvent)
             return false;
@@ -367,17 +372,30 @@ struct EventMgr
     {
         if (!eventId)
             return;
-        for (auto & LuaEvent : LuaEvents) // loop processors
-            if (RemoveEvent(LuaEvent.first, eventId))
+        std::lock_guard<std::mutex> lock(LuaEventsLock);
+        for (auto & itr : LuaEvents) // loop processors
+        {
+            if (LuaEvent* luaEvent = GetEvent(itr.first, eventId))
+            {
+                luaEvent->to_Abort = true;
                 break; // succesfully remove the event, stop loop.
+            }
+        }
     }
 };
 
-class Eluna
+class Eluna : public std::enable_shared_from_this<Eluna>
 {
     public:
         friend class ScriptMgr;
+        // State of the calling thread: the one bound by ElunaMapScope or ElunaWorldScope, otherwise the world state
         static Eluna* instance();
+        static Eluna* SetCurrent(Eluna* state); // Returns the previous state of the thread
+        static std::shared_ptr<Eluna> const& GetWorldState();
+        // With Eluna.PerMapStates every map gets its own state that loads all scripts
+        static bool IsPerMapStates();
+        static std::shared_ptr<Eluna> CreateMapState(Map* map);
+
         lua_State* L;
         EventMgr m_EventMgr;
 
@@ -414,7 +432,7 @@ class Eluna
         void Push(lua_State*, float);
         void Push(lua_State*, double);
         void Push(lua_State*, const char*);
-        void Push(lua_State*, std::string);
+        void Push(lua_State*, std::string const&);
         template<typename T> void Push(lua_State* L, T const* ptr)
         {
             ElunaTemplate<T>::push(L, ptr);
@@ -518,10 +536,61 @@ class Eluna
         int64 CHECK_LONG(lua_State* L, int narg);
         Item* CHECK_ITEM(lua_State* L, int narg);
 
+        struct StateMessage
+        {
+            std::string Channel;
+            std::string Message;
+            int32 FromMapId;
+            uint32 FromInstanceId;
+        };
+
+        struct StateStats
+        {
+            int32 MapId;
+            uint32 InstanceId;
+            uint64 Calls;
+            uint64 TotalNs;
+            uint64 MaxNs;
+            uint64 Errors;
+        };
+
+        // Loads the scripts, restarting closes the lua state and unregisters everything first
+        void Load(bool restart);
+        // Runs timed events and delivers messages, called by the thread that owns the state
+        void Update(uint32 diff);
+        // Releases a function reference, deferred to the next Update when called from another state
+        void Unref(int funcRef);
+        std::recursive_mutex& GetLock() { return _lock; }
+        uint32 GetGeneration() const { return _generation; }
+        int32 GetMapId() const { return _mapId; } // -1 for the world state
+        uint32 GetInstanceId() const { return _instanceId; }
+
+        // Queued for the next update of the receiving states: mapId -1 is the world state, instanceId 0 every state of mapId
+        void SendStateMessage(int32 mapId, uint32 instanceId, std::string const& channel, std::string const& message);
+        void BroadcastStateMessage(std::string const& channel, std::string const& message);
+        // A state can't close itself while it runs, reloads requested from lua happen on the next world update
+        static void RequestReload() { _reloadRequested = true; }
+        static std::vector<StateStats> GetStateStats();
+        static void ResetStateStats();
+
+        struct BenchmarkResult
+        {
+            uint64 PushNs;      // pushing event, player and target
+            uint64 KillNs;      // PLAYER_EVENT_ON_KILL_CREATURE style handler
+            uint64 ChatNs;      // PLAYER_EVENT_ON_CHAT style handler
+        };
+
+        // Fires synthetic hooks with small representative handlers count times in this state
+        bool Benchmark(Player* player, Unit* target, uint32 count, BenchmarkResult& result);
+
         // Creates new binding stores
-        Eluna()
+        Eluna(int32 mapId = -1, uint32 instanceId = 0) : L(nullptr), m_EventMgr(this), _mapId(mapId), _instanceId(instanceId), _generation(0),
+            _calls(0), _totalNs(0), _maxNs(0), _errors(0)
         {
-            L = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(_statesLock);
+                _states.push_back(this);
+            }
 
             for (int i = 0; i < SERVER_EVENT_COUNT; ++i)
             {
@@ -552,17 +621,22 @@ class Eluna
                 std::vector<int> _vector;
                 GroupEventBindings.insert(std::pair<int, std::vector<int> >(i, _vector));
             }
-            CreatureEventBindings = new ElunaBind;
-            CreatureGossipBindings = new ElunaBind;
-            GameObjectEventBindings = new ElunaBind;
-            GameObjectGossipBindings = new ElunaBind;
-            ItemEventBindings = new ElunaBind;
-            ItemGossipBindings = new ElunaBind;
-            playerGossipBindings = new ElunaBind;
+            CreatureEventBindings = new ElunaBind(this);
+            CreatureGossipBindings = new ElunaBind(this);
+            GameObjectEventBindings = new ElunaBind(this);
+            GameObjectGossipBindings = new ElunaBind(this);
+            ItemEventBindings = new ElunaBind(this);
+            ItemGossipBindings = new ElunaBind(this);
+            playerGossipBindings = new ElunaBind(this);
         }
 
         ~Eluna()
         {
+            {
+                std::lock_guard<std::mutex> lock(_statesLock);
+                _states.erase(std::remove(_states.begin(), _states.end(), this), _states.end());
+            }
+
             for (auto & ServerEventBinding : ServerEventBindings)
             {
                 for (int & it : ServerEventBinding.second)
@@ -609,12 +683,22 @@ class Eluna
             ItemEventBindings->Clear();
             ItemGossipBindings->Clear();
             playerGossipBindings->Clear();
-
-            lua_close(L); // Closing
+            delete CreatureEventBindings;
+            delete CreatureGossipBindings;
+            delete GameObjectEventBindings;
+            delete GameObjectGossipBindings;
+            delete ItemEventBindings;
+            delete ItemGossipBindings;
+            delete playerGossipBindings;
+
+            if (L)
+                lua_close(L); // Closing
         }
 
         struct ElunaBind
         {
+            explicit ElunaBind(Eluna* e) : E(e) { }
+
             void Clear(); // unregisters all registered functions and clears all registered events from the bind std::maps (reset)
             void Insert(uint32 entryId, uint32 eventId, int funcRef); // Inserts a new registered event
 
@@ -638,6 +722,7 @@ class Eluna
                 return &itr->second;
             }
 
+            Eluna* E; // State owning the function refs
             ElunaEntryMap Bindings; // Binding store Bindings[entryId][eventId] = funcRef;
         };
 
@@ -698,9 +783,62 @@ class Eluna
 
             WorldObjectInRangeCheck(WorldObjectInRangeCheck const&);
         };
+
+    private:
+        int32 _mapId;
+        uint32 _instanceId;
+        uint32 _generation;
+        std::recursive_mutex _lock;
+        std::mutex _inboxLock;
+        std::vector<StateMessage> _inbox;
+        std::vector<int> _pendingUnrefs;
+        std::atomic<uint64> _calls;
+        std::atomic<uint64> _totalNs;
+        std::atomic<uint64> _maxNs;
+        std::atomic<uint64> _errors;
+
+        static std::mutex _statesLock;
+        static std::vector<Eluna*> _states;
+        static std::atomic<bool> _reloadRequested;
 };
 #define sEluna Eluna::instance()
 
+// Binds the state of the map to the thread while the map is updated or loads grids, when Eluna.PerMapStates is enabled
+// Instanced parent maps have no state of their own and bind the world state, locked like any other
+class ElunaMapScope
+{
+    public:
+        explicit ElunaMapScope(Map* map);
+        ~ElunaMapScope();
+
+        ElunaMapScope(ElunaMapScope const&) = delete;
+        ElunaMapScope& operator=(ElunaMapScope const&) = delete;
+
+    private:
+        std::shared_ptr<Eluna> _state;
+        std::unique_lock<std::recursive_mutex> _lock;
+        Eluna* _previous;
+};
+
+// Binds and locks the world state for the world thread during World::Update
+// Released while the maps update, map threads then run the timed events the world state registered on their objects
+class ElunaWorldScope
+{
+    public:
+        ElunaWorldScope();
+        ~ElunaWorldScope();
+
+        ElunaWorldScope(ElunaWorldScope const&) = delete;
+        ElunaWorldScope& operator=(ElunaWorldScope const&) = delete;
+
+        void Release();
+        void Reacquire();
+
+    private:
+        std::unique_lock<std::recursive_mutex> _lock;
+        Eluna* _previous;
+};
+
 class LuaTaxiMgr
 {
     private:
@@ -75,6 +75,9 @@ void RegisterGlobals(lua_State* L)
 
     // Other
     lua_register(L, "ReloadEluna", &LuaGlobalFunctions::ReloadEluna);                                       // ReloadEluna() - Reload's Eluna engine
+    lua_register(L, "SendStateMessage", &LuaGlobalFunctions::SendStateMessage);                             // SendStateMessage(channel, message[, mapId, instanceId]) - Queues a message for the lua states of the map, -1 (default) is the world state and instanceId 0 (default) every instance
+    lua_register(L, "BroadcastStateMessage", &LuaGlobalFunctions::BroadcastStateMessage);                   // BroadcastStateMessage(channel, message) - Queues a message for every other lua state
+    lua_register(L, "GetStateMapId", &LuaGlobalFunctions::GetStateMapId);                                   // GetStateMapId() - Returns the map id and instance id of the running lua state, -1 for the world state
     lua_register(L, "SendWorldMessage", &LuaGlobalFunctions::SendWorldMessage);                             // SendWorldMessage(msg) - Sends a broadcast message to everyone
     lua_register(L, "WorldDBQuery", &LuaGlobalFunctions::WorldDBQuery);                                     // WorldDBQuery(sql) - Executes given SQL query to world database instantly and returns a QueryResult object
     lua_register(L, "WorldDBExecute", &LuaGlobalFunctions::WorldDBExecute);                                 // WorldDBExecute(sql) - Executes given SQL query to world database (not instant)
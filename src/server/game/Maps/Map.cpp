@@ -33,6 +33,8 @@
 #include "MMapFactory.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
+#include "PathCache.h"
+#include "PathRequestMgr.h"
 #include "Pet.h"
 #include "PoolMgr.h"
 #include "ScriptMgr.h"
@@ -43,6 +45,9 @@
 #include "Weather.h"
 #include "WeatherMgr.h"
 #include "G3D/Plane.h"
+#ifdef ELUNA
+#include "LuaEngine.h"
+#endif
 
 u_map_magic MapMagic        = { {'M','A','P','S'} };
 uint32 MapVersionMagic      = 10;
@@ -82,6 +87,7 @@ Map::~Map()
     if (!m_scriptSchedule.empty())
         sScriptMgr->DecreaseScheduledScriptCount(m_scriptSchedule.size());
 
+    sPathRequestMgr->WaitForMap(this);
     MMAP::MMapFactory::createOrGetMMapManager()->unloadMapInstance(GetId(), i_InstanceId);
 }
 
@@ -233,6 +239,7 @@ void Map::InitStateMachine()
     si_GridStates[GRID_STATE_ACTIVE] = new ActiveState;
     si_GridStates[GRID_STATE_IDLE] = new IdleState;
     si_GridStates[GRID_STATE_REMOVAL] = new RemovalState;
+    si_GridStates[GRID_STATE_DORMANT] = new DormantState;
 }
 
 void Map::DeleteStateMachine()
@@ -241,6 +248,7 @@ void Map::DeleteStateMachine()
     delete si_GridStates[GRID_STATE_ACTIVE];
     delete si_GridStates[GRID_STATE_IDLE];
     delete si_GridStates[GRID_STATE_REMOVAL];
+    delete si_GridStates[GRID_STATE_DORMANT];
 }
 
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint16 SpawnMode, Map* _parent):
@@ -250,7 +258,8 @@ m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
 m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsUpdateIter(_transports.end()),
 i_gridExpiry(expiry), debugFlexPlayersCount(0),
-i_scriptLock(false), _defaultLight(GetDefaultMapLight(id))
+m_creatureUpdates(0), m_skippedCreatureUpdates(0), m_dormantGridCount(0), m_dormantGridMemory(0),
+m_dormantGridHits(0), m_dormantGridMisses(0), m_dormantGridEvictions(0), i_scriptLock(false), _defaultLight(GetDefaultMapLight(id))
 {
     m_parentMap = (_parent ? _parent : this);
     for (unsigned int idx=0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
@@ -457,6 +466,12 @@ void Map::EnsureGridLoadedForActiveObject(Cell const& cell, WorldObject const* o
     if (grid->GetGridState() != GRID_STATE_ACTIVE)
     {
         TC_LOG_DEBUG("maps", "Active object " UI64FMTD " triggers loading of grid [%u, %u] on map %u", object->GetGUID().GetRawValue(), cell.GridX(), cell.GridY(), GetId());
+        if (grid->GetGridState() == GRID_STATE_DORMANT)
+        {
+            RemoveFromDormantGrids(*grid);
+            ++m_dormantGridHits;
+        }
+
         ResetGridExpiry(*grid, 0.1f);
         grid->SetGridState(GRID_STATE_ACTIVE);
     }
@@ -473,6 +488,9 @@ bool Map::EnsureGridLoaded(const Cell &cell)
     {
         TC_LOG_DEBUG("maps", "Loading grid[%u, %u] for map %u instance %u", cell.GridX(), cell.GridY(), GetId(), i_InstanceId);
 
+        if (m_unloadedGrids.test(cell.GridX() * MAX_NUMBER_OF_GRIDS + cell.GridY()))
+            ++m_dormantGridMisses;
+
         setGridObjectDataLoaded(true, cell.GridX(), cell.GridY());
 
         ObjectGridLoader loader(*grid, this, cell);
@@ -684,8 +702,40 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::Obj
     }
 }
 
+bool Map::IsInUpdateInterestCell(WorldObject const* obj) const
+{
+    CellCoord p = Trinity::ComputeCellCoord(obj->GetPositionX(), obj->GetPositionY());
+    return !p.IsCoordValid() || interest_cells.test(p.GetId());
+}
+
+void Map::MarkUpdateInterestCells(WorldObject const* obj, float range)
+{
+    if (!obj->IsPositionValid())
+        return;
+
+    CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), range);
+    for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+        for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+            interest_cells.set((y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x);
+}
+
+#ifdef ELUNA
+std::shared_ptr<Eluna> const& Map::GetElunaState()
+{
+    // instanced parent maps only schedule their instances
+    if (!_elunaState && Eluna::IsPerMapStates() && !(Instanceable() && !GetInstanceId()))
+        _elunaState = Eluna::CreateMapState(this);
+
+    return _elunaState;
+}
+#endif
+
 void Map::Update(const uint32 t_diff)
 {
+#ifdef ELUNA
+    ElunaMapScope elunaScope(this);
+#endif
+
     uint32 updateTimeMark;
     if (!Instanceable()) // Map update time for instanced maps is handled in InstanceMap::Update
         updateTimeMark = getMSTime();
@@ -706,7 +756,29 @@ void Map::Update(const uint32 t_diff)
     /// update active cells around players and active objects
     resetMarkedCells();
 
-    Trinity::ObjectUpdater updater(t_diff);
+    // continents only, scripted encounters in instances keep their exact timing
+    uint32 reducedUpdateInterval = Instanceable() ? 0 : sWorld->getIntConfig(CONFIG_CREATURE_REDUCED_UPDATE_INTERVAL);
+    if (reducedUpdateInterval)
+    {
+        float range = sWorld->getFloatConfig(CONFIG_CREATURE_REDUCED_UPDATE_RANGE);
+        interest_cells.reset();
+        for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+        {
+            Player* player = itr->GetSource();
+            if (!player || !player->IsInWorld())
+                continue;
+
+            MarkUpdateInterestCells(player, range);
+            if (WorldObject* viewPoint = player->GetViewpoint())
+                MarkUpdateInterestCells(viewPoint, range);
+        }
+
+        for (WorldObject* obj : m_activeNonPlayers)
+            if (obj && obj->IsInWorld())
+                MarkUpdateInterestCells(obj, range);
+    }
+
+    Trinity::ObjectUpdater updater(t_diff, this, reducedUpdateInterval);
     // for creature
     TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
     // for pets
@@ -754,6 +826,9 @@ void Map::Update(const uint32 t_diff)
         obj->Update(t_diff);
     }
 
+    m_creatureUpdates += updater.i_creatureUpdates;
+    m_skippedCreatureUpdates += updater.i_skippedCreatureUpdates;
+
     ///- Process necessary scripts
     if (!m_scriptSchedule.empty())
     {
@@ -779,6 +854,11 @@ void Map::Update(const uint32 t_diff)
 
     sScriptMgr->OnMapUpdate(this, t_diff);
 
+#ifdef ELUNA
+    if (_elunaState)
+        _elunaState->Update(t_diff);
+#endif
+
     UpdateDataMapType updatePlayers;
 
     for (auto&& obj : m_updatable)
@@ -1599,6 +1679,12 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
 
         TC_LOG_DEBUG("maps", "Unloading grid[%u, %u] for map %u", x, y, GetId());
 
+        if (ngrid.GetGridState() == GRID_STATE_DORMANT)
+            RemoveFromDormantGrids(ngrid);
+
+        if (!unloadAll)
+            m_unloadedGrids.set(x * MAX_NUMBER_OF_GRIDS + y);
+
         if (!unloadAll)
         {
             // Finish creature moves, remove and delete all creatures with delayed remove before moving to respawn grids
@@ -1647,6 +1733,9 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
     {
         if (i_InstanceId == 0)
         {
+            // let the searches of this map end before their navmesh tiles go away
+            sPathRequestMgr->WaitForMap(this);
+
             if (GridMaps[gx][gy])
             {
                 GridMaps[gx][gy]->unloadData();
@@ -1654,6 +1743,7 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
             }
             VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(GetId(), gx, gy);
             MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(GetId(), gx, gy);
+            sPathCache->InvalidateMap(GetId());
         }
         else
             ((MapInstanced*)m_parentMap)->RemoveGridMapReference(GridCoord(gx, gy));
@@ -1763,8 +1853,7 @@ GridMap::GridMap()
     // Height level data
     _gridHeight = INVALID_HEIGHT;
     _gridGetHeight = &GridMap::getHeightFromFlat;
-    m_V9 = nullptr;
-    m_V8 = nullptr;
+    _heightMap = nullptr;
     _minHeightPlanes = nullptr;
     // Liquid data
     _liquidType    = 0;
@@ -1843,16 +1932,14 @@ bool GridMap::loadData(char* filename)
 void GridMap::unloadData()
 {
     delete[] _areaMap;
-    delete[] m_V9;
-    delete[] m_V8;
+    delete[] _heightMap;
     delete[] _minHeightPlanes;
     delete[] _liquidEntry;
     delete[] _liquidFlags;
     delete[] _liquidMap;
     delete[] _holes;
     _areaMap = nullptr;
-    m_V9 = nullptr;
-    m_V8 = nullptr;
+    _heightMap = nullptr;
     _minHeightPlanes = nullptr;
     _liquidEntry = nullptr;
     _liquidFlags = nullptr;
@@ -1879,6 +1966,35 @@ bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
+template<typename T>
+bool GridMap::loadHeightMap(FILE* in)
+{
+    std::vector<T> V9(129 * 129);
+    std::vector<T> V8(128 * 128);
+    if (fread(V9.data(), sizeof(T), V9.size(), in) != V9.size() ||
+        fread(V8.data(), sizeof(T), V8.size(), in) != V8.size())
+        return false;
+
+    // raw bytes, unloadData frees the buffer without knowing T
+    _heightMap = new uint8[129 * HEIGHT_ROW_SIZE * sizeof(T)]();
+    T* heights = reinterpret_cast<T*>(_heightMap);
+    for (uint32 x = 0; x < 129; ++x)
+    {
+        T* row = heights + x * HEIGHT_ROW_SIZE;
+        for (uint32 y = 0; y < 128; ++y)
+        {
+            row[2 * y] = V9[x * 129 + y];
+            // last V9 row has no V8 row below it
+            if (x < 128)
+                row[2 * y + 1] = V8[x * 128 + y];
+        }
+        row[2 * 128] = V9[x * 129 + 128];
+    }
+
+    _gridGetHeight = &GridMap::getHeightFromMap<T>;
+    return true;
+}
+
 bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
 {
     map_heightHeader header;
@@ -1892,33 +2008,18 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16 [129*129];
-            m_uint16_V8 = new uint16 [128*128];
-            if (fread(m_uint16_V9, sizeof(uint16), 129*129, in) != 129*129 ||
-                fread(m_uint16_V8, sizeof(uint16), 128*128, in) != 128*128)
+            if (!loadHeightMap<uint16>(in))
                 return false;
             _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
-            _gridGetHeight = &GridMap::getHeightFromUint16;
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8 [129*129];
-            m_uint8_V8 = new uint8 [128*128];
-            if (fread(m_uint8_V9, sizeof(uint8), 129*129, in) != 129*129 ||
-                fread(m_uint8_V8, sizeof(uint8), 128*128, in) != 128*128)
+            if (!loadHeightMap<uint8>(in))
                 return false;
             _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
-            _gridGetHeight = &GridMap::getHeightFromUint8;
-        }
-        else
-        {
-            m_V9 = new float [129*129];
-            m_V8 = new float [128*128];
-            if (fread(m_V9, sizeof(float), 129*129, in) != 129*129 ||
-                fread(m_V8, sizeof(float), 128*128, in) != 128*128)
-                return false;
-            _gridGetHeight = &GridMap::getHeightFromFloat;
         }
+        else if (!loadHeightMap<float>(in))
+            return false;
     }
     else
         _gridGetHeight = &GridMap::getHeightFromFlat;
@@ -2044,11 +2145,9 @@ float GridMap::getHeightFromFlat(float /*x*/, float /*y*/) const
     return _gridHeight;
 }
 
-float GridMap::getHeightFromFloat(float x, float y) const
+template<typename T>
+float GridMap::getHeightFromMap(float x, float y) const
 {
-    if (!m_V8 || !m_V9)
-        return _gridHeight;
-
     x = MAP_RESOLUTION * (32 - x/SIZE_OF_GRIDS);
     y = MAP_RESOLUTION * (32 - y/SIZE_OF_GRIDS);
 
@@ -2072,201 +2171,26 @@ float GridMap::getHeightFromFloat(float x, float y) const
     // | | /  4  \ |     h5 1/2, 1/2
     // | h3-------h4
     // V Y
-    // For find height need
-    // 1 - detect triangle
-    // 2 - solve linear equation from triangle points
-    // Calculate coefficients for solve h = a*x + b*y + c
-
-    float a, b, c;
-    // Select triangle:
-    if (x+y < 1)
-    {
-        if (x > y)
-        {
-            // 1 triangle (h1, h2, h5 points)
-            float h1 = m_V9[(x_int)*129 + y_int];
-            float h2 = m_V9[(x_int+1)*129 + y_int];
-            float h5 = 2 * m_V8[x_int*128 + y_int];
-            a = h2-h1;
-            b = h5-h1-h2;
-            c = h1;
-        }
-        else
-        {
-            // 2 triangle (h1, h3, h5 points)
-            float h1 = m_V9[x_int*129 + y_int  ];
-            float h3 = m_V9[x_int*129 + y_int+1];
-            float h5 = 2 * m_V8[x_int*128 + y_int];
-            a = h5 - h1 - h3;
-            b = h3 - h1;
-            c = h1;
-        }
-    }
-    else
-    {
-        if (x > y)
-        {
-            // 3 triangle (h2, h4, h5 points)
-            float h2 = m_V9[(x_int+1)*129 + y_int  ];
-            float h4 = m_V9[(x_int+1)*129 + y_int+1];
-            float h5 = 2 * m_V8[x_int*128 + y_int];
-            a = h2 + h4 - h5;
-            b = h4 - h2;
-            c = h5 - h4;
-        }
-        else
-        {
-            // 4 triangle (h3, h4, h5 points)
-            float h3 = m_V9[(x_int)*129 + y_int+1];
-            float h4 = m_V9[(x_int+1)*129 + y_int+1];
-            float h5 = 2 * m_V8[x_int*128 + y_int];
-            a = h4 - h3;
-            b = h3 + h4 - h5;
-            c = h5 - h4;
-        }
-    }
-    // Calculate height
-    return a * x + b * y + c;
-}
-
-float GridMap::getHeightFromUint8(float x, float y) const
-{
-    if (!m_uint8_V8 || !m_uint8_V9)
-        return _gridHeight;
-
-    x = MAP_RESOLUTION * (32 - x/SIZE_OF_GRIDS);
-    y = MAP_RESOLUTION * (32 - y/SIZE_OF_GRIDS);
-
-    int x_int = (int)x;
-    int y_int = (int)y;
-    x -= x_int;
-    y -= y_int;
-    x_int&=(MAP_RESOLUTION - 1);
-    y_int&=(MAP_RESOLUTION - 1);
+    // h1, h5 and h3 are neighbours in the interleaved row, h2 and h4 are in the next one
+    T const* cell = reinterpret_cast<T const*>(_heightMap) + x_int * HEIGHT_ROW_SIZE + 2 * y_int;
+    float h1 = cell[0];
+    float h5 = 2.0f * cell[1];
+    float h3 = cell[2];
+    float h2 = cell[HEIGHT_ROW_SIZE];
+    float h4 = cell[HEIGHT_ROW_SIZE + 2];
+
+    // Select triangle and solve h = a*x + b*y + c, written as selects so the compiler does not need to branch
+    bool upper = x + y < 1;
+    bool right = x > y;
+    float a = upper ? (right ? h2 - h1 : h5 - h1 - h3) : (right ? h2 + h4 - h5 : h4 - h3);
+    float b = upper ? (right ? h5 - h1 - h2 : h3 - h1) : (right ? h4 - h2 : h3 + h4 - h5);
+    float c = upper ? h1 : h5 - h4;
 
-    if (isHole(x_int, y_int))
-        return INVALID_HEIGHT;
-
-    int32 a, b, c;
-    uint8 *V9_h1_ptr = &m_uint8_V9[x_int*128 + x_int + y_int];
-    if (x+y < 1)
-    {
-        if (x > y)
-        {
-            // 1 triangle (h1, h2, h5 points)
-            int32 h1 = V9_h1_ptr[  0];
-            int32 h2 = V9_h1_ptr[129];
-            int32 h5 = 2 * m_uint8_V8[x_int*128 + y_int];
-            a = h2-h1;
-            b = h5-h1-h2;
-            c = h1;
-        }
-        else
-        {
-            // 2 triangle (h1, h3, h5 points)
-            int32 h1 = V9_h1_ptr[0];
-            int32 h3 = V9_h1_ptr[1];
-            int32 h5 = 2 * m_uint8_V8[x_int*128 + y_int];
-            a = h5 - h1 - h3;
-            b = h3 - h1;
-            c = h1;
-        }
-    }
-    else
-    {
-        if (x > y)
-        {
-            // 3 triangle (h2, h4, h5 points)
-            int32 h2 = V9_h1_ptr[129];
-            int32 h4 = V9_h1_ptr[130];
-            int32 h5 = 2 * m_uint8_V8[x_int*128 + y_int];
-            a = h2 + h4 - h5;
-            b = h4 - h2;
-            c = h5 - h4;
-        }
-        else
-        {
-            // 4 triangle (h3, h4, h5 points)
-            int32 h3 = V9_h1_ptr[  1];
-            int32 h4 = V9_h1_ptr[130];
-            int32 h5 = 2 * m_uint8_V8[x_int*128 + y_int];
-            a = h4 - h3;
-            b = h3 + h4 - h5;
-            c = h5 - h4;
-        }
-    }
     // Calculate height
-    return (float)((a * x) + (b * y) + c)*_gridIntHeightMultiplier + _gridHeight;
-}
-
-float GridMap::getHeightFromUint16(float x, float y) const
-{
-    if (!m_uint16_V8 || !m_uint16_V9)
-        return _gridHeight;
-
-    x = MAP_RESOLUTION * (32 - x/SIZE_OF_GRIDS);
-    y = MAP_RESOLUTION * (32 - y/SIZE_OF_GRIDS);
-
-    int x_int = (int)x;
-    int y_int = (int)y;
-    x -= x_int;
-    y -= y_int;
-    x_int&=(MAP_RESOLUTION - 1);
-    y_int&=(MAP_RESOLUTION - 1);
-
-    if (isHole(x_int, y_int))
-        return INVALID_HEIGHT;
-
-    int32 a, b, c;
-    uint16 *V9_h1_ptr = &m_uint16_V9[x_int*128 + x_int + y_int];
-    if (x+y < 1)
-    {
-        if (x > y)
-        {
-            // 1 triangle (h1, h2, h5 points)
-            int32 h1 = V9_h1_ptr[  0];
-            int32 h2 = V9_h1_ptr[129];
-            int32 h5 = 2 * m_uint16_V8[x_int*128 + y_int];
-            a = h2-h1;
-            b = h5-h1-h2;
-            c = h1;
-        }
-        else
-        {
-            // 2 triangle (h1, h3, h5 points)
-            int32 h1 = V9_h1_ptr[0];
-            int32 h3 = V9_h1_ptr[1];
-            int32 h5 = 2 * m_uint16_V8[x_int*128 + y_int];
-            a = h5 - h1 - h3;
-            b = h3 - h1;
-            c = h1;
-        }
-    }
+    if constexpr (std::is_same_v<T, float>)
+        return a * x + b * y + c;
     else
-    {
-        if (x > y)
-        {
-            // 3 triangle (h2, h4, h5 points)
-            int32 h2 = V9_h1_ptr[129];
-            int32 h4 = V9_h1_ptr[130];
-            int32 h5 = 2 * m_uint16_V8[x_int*128 + y_int];
-            a = h2 + h4 - h5;
-            b = h4 - h2;
-            c = h5 - h4;
-        }
-        else
-        {
-            // 4 triangle (h3, h4, h5 points)
-            int32 h3 = V9_h1_ptr[  1];
-            int32 h4 = V9_h1_ptr[130];
-            int32 h5 = 2 * m_uint16_V8[x_int*128 + y_int];
-            a = h4 - h3;
-            b = h3 + h4 - h5;
-            c = h5 - h4;
-        }
-    }
-    // Calculate height
-    return (float)((a * x) + (b * y) + c)*_gridIntHeightMultiplier + _gridHeight;
+        return (a * x + b * y + c) * _gridIntHeightMultiplier + _gridHeight;
 }
 
 float GridMap::getMinHeight(float x, float y) const
@@ -3053,6 +2977,10 @@ inline void Map::setNGrid(NGridType *grid, uint32 x, uint32 y)
 
 void Map::DelayedUpdate(const uint32 t_diff)
 {
+#ifdef ELUNA
+    ElunaMapScope elunaScope(this);
+#endif
+
     for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();)
     {
         Transport* transport = *_transportsUpdateIter;
@@ -3078,6 +3006,71 @@ void Map::DelayedUpdate(const uint32 t_diff)
             ASSERT(grid->GetGridState() >= 0 && grid->GetGridState() < MAX_GRID_STATE);
             si_GridStates[grid->GetGridState()]->Update(*this, *grid, *info, t_diff);
         }
+
+        // evicting while iterating could delete the grid the iterator points to
+        TrimDormantGrids();
+    }
+}
+
+bool Map::AddToDormantGrids(NGridType& grid)
+{
+    uint32 maxGrids = sWorld->getIntConfig(CONFIG_GRID_DORMANT_MAX_GRIDS);
+    if (!maxGrids)
+        return false;
+
+    // the same conditions as UnloadGrid, a grid that can't be unloaded can't be evicted either
+    if (grid.GetWorldObjectCountInNGrid<Creature>() || ActiveObjectsNearGrid(grid))
+        return false;
+
+    // objects and grid containers only, the terrain of the grid is bounded by the grid count
+    uint64 memory = sizeof(NGridType) +
+        uint64(grid.GetGridObjectCountInNGrid<Creature>()) * sizeof(Creature) +
+        uint64(grid.GetGridObjectCountInNGrid<GameObject>()) * sizeof(GameObject) +
+        uint64(grid.GetGridObjectCountInNGrid<DynamicObject>()) * sizeof(DynamicObject) +
+        uint64(grid.GetGridObjectCountInNGrid<AreaTrigger>()) * sizeof(AreaTrigger);
+
+    if (memory > uint64(sWorld->getIntConfig(CONFIG_GRID_DORMANT_MAX_MEMORY)) * 1024 * 1024)
+        return false;
+
+    m_dormantGrids.push_front({ &grid, memory });
+    m_dormantGridCount = m_dormantGrids.size();
+    m_dormantGridMemory += memory;
+    grid.SetGridState(GRID_STATE_DORMANT);
+    return true;
+}
+
+void Map::RemoveFromDormantGrids(NGridType& grid)
+{
+    for (auto itr = m_dormantGrids.begin(); itr != m_dormantGrids.end(); ++itr)
+    {
+        if (itr->Grid != &grid)
+            continue;
+
+        m_dormantGridMemory -= itr->Memory;
+        m_dormantGrids.erase(itr);
+        m_dormantGridCount = m_dormantGrids.size();
+        return;
+    }
+}
+
+void Map::TrimDormantGrids()
+{
+    uint32 maxGrids = sWorld->getIntConfig(CONFIG_GRID_DORMANT_MAX_GRIDS);
+    uint64 maxMemory = uint64(sWorld->getIntConfig(CONFIG_GRID_DORMANT_MAX_MEMORY)) * 1024 * 1024;
+
+    while (!m_dormantGrids.empty() && (m_dormantGrids.size() > maxGrids || m_dormantGridMemory > maxMemory))
+    {
+        NGridType& grid = *m_dormantGrids.back().Grid;
+        if (UnloadGrid(grid, false))
+        {
+            ++m_dormantGridEvictions;
+            continue;
+        }
+
+        // something moved near it meanwhile, take the usual way through the unload delay
+        RemoveFromDormantGrids(grid);
+        grid.SetGridState(GRID_STATE_REMOVAL);
+        ResetGridExpiry(grid);
     }
 }
 
@@ -33,8 +33,10 @@
 #include "GameObjectModel.h"
 #include "ObjectGuid.h"
 
+#include <atomic>
 #include <bitset>
 #include <list>
+#include <memory>
 
 class Unit;
 
@@ -59,6 +61,9 @@ class Weather;
 class WorldObject;
 class WorldPacket;
 class WorldSession;
+#ifdef ELUNA
+class Eluna;
+#endif
 enum WeatherState : uint32;
 namespace Trinity { struct ObjectUpdater; }
 namespace VMAP { enum class ModelIgnoreFlags : uint32; }
@@ -186,17 +191,12 @@ struct PositionFullTerrainStatus
 
 class TC_GAME_API GridMap
 {
+    // each V9 row is interleaved with the V8 row below it: v9[x][0], v8[x][0], v9[x][1], ... v8[x][127], v9[x][128]
+    // so the corners and center of a cell are read from two cache lines instead of three
+    static uint32 constexpr HEIGHT_ROW_SIZE = 129 + 128;
+
     uint32  _flags;
-    union{
-        float* m_V9;
-        uint16* m_uint16_V9;
-        uint8* m_uint8_V9;
-    };
-    union{
-        float* m_V8;
-        uint16* m_uint16_V8;
-        uint8* m_uint8_V8;
-    };
+    uint8* _heightMap;  // float, uint16 or uint8 values depending on _gridGetHeight
     G3D::Plane* _minHeightPlanes;
     // Height level data
     float _gridHeight;
@@ -228,9 +228,10 @@ class TC_GAME_API GridMap
     // Get height functions and pointers
     typedef float (GridMap::*GetHeightPtr) (float x, float y) const;
     GetHeightPtr _gridGetHeight;
-    float getHeightFromFloat(float x, float y) const;
-    float getHeightFromUint16(float x, float y) const;
-    float getHeightFromUint8(float x, float y) const;
+    template<typename T>
+    bool loadHeightMap(FILE* in);
+    template<typename T>
+    float getHeightFromMap(float x, float y) const;
     float getHeightFromFlat(float x, float y) const;
 
 public:
@@ -459,6 +460,28 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         bool isCellMarked(uint32 pCellId) { return marked_cells.test(pCellId); }
         void markCell(uint32 pCellId) { marked_cells.set(pCellId); }
 
+        // creatures in cells near players and active objects are updated every tick, others may be updated at a reduced rate
+        bool IsInUpdateInterestCell(WorldObject const* obj) const;
+        uint64 GetCreatureUpdateCount() const { return m_creatureUpdates; }
+        uint64 GetSkippedCreatureUpdateCount() const { return m_skippedCreatureUpdates; }
+        void ResetCreatureUpdateCounters() { m_creatureUpdates = 0; m_skippedCreatureUpdates = 0; }
+
+        // grids past their unload delay stay loaded in a LRU bounded by GridUnload.DormantGrids and GridUnload.DormantMemory,
+        // an active object returning to one reuses its objects and terrain instead of reloading them
+        bool AddToDormantGrids(NGridType& grid);
+        uint32 GetDormantGridCount() const { return m_dormantGridCount; }
+        uint64 GetDormantGridMemory() const { return m_dormantGridMemory; }
+        uint64 GetDormantGridHits() const { return m_dormantGridHits; }
+        uint64 GetDormantGridMisses() const { return m_dormantGridMisses; }
+        uint64 GetDormantGridEvictions() const { return m_dormantGridEvictions; }
+        void ResetDormantGridCounters() { m_dormantGridHits = 0; m_dormantGridMisses = 0; m_dormantGridEvictions = 0; }
+
+#ifdef ELUNA
+        // own lua state of the map with Eluna.PerMapStates, created with its first update
+        std::shared_ptr<Eluna> const& GetElunaState();
+        void ResetElunaState() { _elunaState.reset(); }
+#endif
+
         bool HavePlayers() const { return !m_mapRefManager.isEmpty(); }
         uint32 GetPlayersCountExceptGMs() const;
         bool ActiveObjectsNearGrid(NGridType const& ngrid) const;
@@ -767,6 +790,32 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         NGridType* i_grids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
         GridMap* GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
         std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP*TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
+        std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP*TOTAL_NUMBER_OF_CELLS_PER_MAP> interest_cells;
+        std::atomic<uint64> m_creatureUpdates;
+        std::atomic<uint64> m_skippedCreatureUpdates;
+
+        struct DormantGrid
+        {
+            NGridType* Grid;
+            uint64 Memory;
+        };
+
+        void RemoveFromDormantGrids(NGridType& grid);
+        void TrimDormantGrids();
+
+        std::list<DormantGrid> m_dormantGrids;                  // most recently deactivated first
+        std::bitset<MAX_NUMBER_OF_GRIDS*MAX_NUMBER_OF_GRIDS> m_unloadedGrids;
+        std::atomic<uint32> m_dormantGridCount;
+        std::atomic<uint64> m_dormantGridMemory;
+        std::atomic<uint64> m_dormantGridHits;                  // active objects reactivating a dormant grid
+        std::atomic<uint64> m_dormantGridMisses;                // loads of grids unloaded before
+        std::atomic<uint64> m_dormantGridEvictions;
+
+        void MarkUpdateInterestCells(WorldObject const* obj, float range);
+
+#ifdef ELUNA
+        std::shared_ptr<Eluna> _elunaState;
+#endif
 
         bool i_scriptLock;
         std::set<WorldObject*> i_objectsToRemove;
@@ -21,6 +21,8 @@
 #include "Battleground.h"
 #include "VMapFactory.h"
 #include "MMapFactory.h"
+#include "PathCache.h"
+#include "PathRequestMgr.h"
 #include "InstanceSaveMgr.h"
 #include "World.h"
 #include "Group.h"
@@ -266,8 +268,10 @@ bool MapInstanced::DestroyInstance(InstancedMaps::iterator &itr)
     // should only unload VMaps if this is the last instance and grid unloading is enabled
     if (m_InstancedMaps.size() <= 1 && sWorld->getBoolConfig(CONFIG_GRID_UNLOAD))
     {
+        sPathRequestMgr->WaitForMap(itr->second);
         VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(itr->second->GetId());
         MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(itr->second->GetId());
+        sPathCache->InvalidateMap(itr->second->GetId());
         // in that case, unload grids of the base map, too
         // so in the next map creation, (EnsureGridCreated actually) VMaps will be reloaded
         Map::UnloadAll();
@@ -35,6 +35,7 @@
 #include "Player.h"
 #include "WorldSession.h"
 #include "Opcodes.h"
+#include "PathRequestMgr.h"
 
 extern GridState* si_GridStates[];                          // debugging code, should be deleted some day
 
@@ -69,7 +70,8 @@ void MapManager::Initialize()
     // Start mtmaps if needed.
     if (num_threads > 0)
         m_updater.activate(num_threads);
-    
+
+    sPathRequestMgr->Initialize();
 }
 
 void MapManager::InitializeVisibilityDistanceInfo()
@@ -429,6 +431,8 @@ bool MapManager::IsValidMAP(uint32 mapid, bool startUp)
 
 void MapManager::UnloadAll()
 {
+    sPathRequestMgr->Shutdown();
+
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end();)
     {
         iter->second->UnloadAll();
@@ -32,9 +32,43 @@
 #define rand_norm() creature.rand_norm()
 #endif
 
+template<>
+void RandomMovementGenerator<Creature>::_launchMove(Creature* creature, G3D::Vector3 const& dest, bool pathBuilt)
+{
+    creature->AddUnitState(UNIT_STATE_ROAMING_MOVE);
+
+    Movement::MoveSplineInit init(creature);
+    if (pathBuilt && !(i_path->GetPathType() & PATHFIND_NOPATH))
+        init.MovebyPath(i_path->GetPath());
+    else
+        init.MoveTo(dest, false);
+
+    bool run = false;
+
+    if (creature->GetAIName() == "SmartAI")
+        run = CAST_AI(SmartAI, creature->AI()) && CAST_AI(SmartAI, creature->AI())->IsCreatureRun();
+
+    if (creature->GetWalkMode() == 1)
+        init.SetWalk(run);
+    else if (creature->GetWalkMode() == 2)
+        init.SetWalk((irand(0, 5) > 0) ? !run : run);
+    else
+        init.SetWalk(!run);
+
+    init.Launch();
+
+    //Call for creature group update
+    if (creature->GetFormation() && creature->GetFormation()->GetLeader() == creature)
+        creature->GetFormation()->LeaderMoveTo(dest.x, dest.y, dest.z);
+}
+
 template<>
 void RandomMovementGenerator<Creature>::_setRandomLocation(Creature* creature)
 {
+    // previous destination is still being searched
+    if (i_pathRequest)
+        return;
+
     float respX, respY, respZ, respO, destX, destY, destZ, travelDistZ;
     creature->GetHomePosition(respX, respY, respZ, respO);
     Map const* map = creature->GetMap();
@@ -101,28 +135,30 @@ void RandomMovementGenerator<Creature>::_setRandomLocation(Creature* creature)
     else
         i_nextMoveTime.Reset(urand(500, 10000));
 
-    creature->AddUnitState(UNIT_STATE_ROAMING_MOVE);
-
-    Movement::MoveSplineInit init(creature);
-    init.MoveTo(destX, destY, destZ);
+    G3D::Vector3 dest(destX, destY, destZ);
 
-    bool run = false;
-
-    if (creature->GetAIName() == "SmartAI")
-        run = CAST_AI(SmartAI, creature->AI()) && CAST_AI(SmartAI, creature->AI())->IsCreatureRun();
+    if (!i_path)
+        i_path = new PathGenerator(creature);
 
-    if (creature->GetWalkMode() == 1)
-        init.SetWalk(run);
-    else if (creature->GetWalkMode() == 2)
-        init.SetWalk((irand(0, 5) > 0) ? !run : run);
-    else
-        init.SetWalk(!run);
+    PathPrepareResult prepared = i_path->PreparePath(destX, destY, destZ);
+    if (prepared == PATH_PREPARE_SEARCH)
+    {
+        // search on a path worker, the move is launched from DoUpdate once the path is ready
+        if (sPathRequestMgr->IsEnabled())
+        {
+            i_pathRequest = sPathRequestMgr->Submit(i_path, creature->GetMap());
+            if (i_pathRequest)
+            {
+                i_pendingDest = dest;
+                return;
+            }
+        }
 
-    init.Launch();
+        i_path->SearchPath();
+        i_path->FinishPath();
+    }
 
-    //Call for creature group update
-    if (creature->GetFormation() && creature->GetFormation()->GetLeader() == creature)
-        creature->GetFormation()->LeaderMoveTo(destX, destY, destZ);
+    _launchMove(creature, dest, prepared != PATH_PREPARE_INVALID);
 }
 
 template<>
@@ -161,6 +197,17 @@ bool RandomMovementGenerator<Creature>::DoUpdate(Creature* creature, const uint3
         return true;
     }
 
+    if (i_pathRequest)
+    {
+        if (!i_pathRequest->IsDone())
+            return true;
+
+        i_pathRequest.reset();
+        i_path->FinishPath();
+        _launchMove(creature, i_pendingDest, true);
+        return true;
+    }
+
     if (creature->movespline->Finalized())
     {
         i_nextMoveTime.Update(diff);
@@ -19,14 +19,23 @@
 #define TRINITY_RANDOMMOTIONGENERATOR_H
 
 #include "MovementGenerator.h"
+#include "PathGenerator.h"
+#include "PathRequestMgr.h"
 
 template<class T>
 class RandomMovementGenerator : public MovementGeneratorMedium< T, RandomMovementGenerator<T> >
 {
     public:
-        RandomMovementGenerator(float wanderDistance = 0.0f) : i_nextMoveTime(0), wander_distance(wanderDistance) { }
+        RandomMovementGenerator(float wanderDistance = 0.0f) : i_nextMoveTime(0), wander_distance(wanderDistance), i_path(nullptr) { }
+        ~RandomMovementGenerator()
+        {
+            if (i_pathRequest)
+                sPathRequestMgr->Cancel(i_pathRequest);
+            delete i_path;
+        }
 
         void _setRandomLocation(T*);
+        void _launchMove(T*, G3D::Vector3 const& dest, bool pathBuilt);
         void DoInitialize(T*);
         void DoFinalize(T*);
         void DoReset(T*);
@@ -38,5 +47,9 @@ class RandomMovementGenerator : public MovementGeneratorMedium< T, RandomMovemen
 
         uint32 i_nextMove;
         float wander_distance;
+
+        PathGenerator* i_path;
+        PathRequestPtr i_pathRequest;
+        G3D::Vector3 i_pendingDest;
 };
 #endif
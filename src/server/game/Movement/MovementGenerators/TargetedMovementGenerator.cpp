@@ -32,7 +32,6 @@ bool TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T* owner, bool up
 {
     enum
     {
-        REACH_TIME      = 1000, // How much time it takes for a pet to reach its owner
         LEADING_TIME    = 1000, // How far into the future to predict owner's movement
         LEADING_STEPS   = 4,    // How many segments to split the leading path into. 1 is fastest but can result in issues when moving on slopes
     };
@@ -42,6 +41,10 @@ bool TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T* owner, bool up
     if (!i_target.isValid() || !i_target->IsInWorld())
         return false;
 
+    // a search is still running, its result is launched from DoUpdate
+    if (i_pathRequest)
+        return false;
+
     if (owner->HasUnitState(UNIT_STATE_NOT_MOVE))
         return false;
 
@@ -185,9 +188,42 @@ bool TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T* owner, bool up
     bool forceDest = (owner->GetTypeId() == TYPEID_UNIT && owner->ToCreature()->IsPet()
         && owner->HasUnitState(UNIT_STATE_FOLLOW));
 
-    bool result = i_path->CalculatePath(x, y, z, forceDest);
+    i_pendingPath = PendingPath{ x, y, z, forceDest, leadingTarget, updateDestination };
+
+    PathPrepareResult prepared = i_path->PreparePath(x, y, z, forceDest);
+    if (prepared == PATH_PREPARE_SEARCH)
+    {
+        // creatures keep their current spline while the search runs on a path worker
+        if (owner->GetTypeId() == TYPEID_UNIT && sPathRequestMgr->IsEnabled())
+        {
+            i_pathRequest = sPathRequestMgr->Submit(i_path, owner->GetMap());
+            if (i_pathRequest)
+                return false;
+        }
+
+        i_path->SearchPath();
+        i_path->FinishPath();
+    }
+
+    return _launchPath(owner, prepared != PATH_PREPARE_INVALID);
+}
 
-    if (!result || (i_path->GetPathType() & PATHFIND_NOPATH) && !forceDest)
+template<class T, typename D>
+bool TargetedMovementGeneratorMedium<T, D>::_launchPath(T* owner, bool pathBuilt)
+{
+    enum
+    {
+        REACH_TIME      = 1000, // How much time it takes for a pet to reach its owner
+    };
+
+    float x = i_pendingPath.x;
+    float y = i_pendingPath.y;
+    float z = i_pendingPath.z;
+    bool forceDest = i_pendingPath.forceDest;
+    bool leadingTarget = i_pendingPath.leadingTarget;
+    bool updateDestination = i_pendingPath.updateDestination;
+
+    if (!pathBuilt || (i_path->GetPathType() & PATHFIND_NOPATH) && !forceDest)
     {
         // Can't reach target
         i_recalculateTravel = true;
@@ -241,6 +277,31 @@ bool TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T* owner, bool up
     return true;
 }
 
+// the owner and target may have changed while the path was searched on a worker, repeat the checks of _setTargetLocation
+template<class T, typename D>
+bool TargetedMovementGeneratorMedium<T, D>::_canLaunchPendingPath(T* owner) const
+{
+    if (!i_target.isValid() || !i_target->IsInWorld())
+        return false;
+
+    if (owner->HasUnitState(UNIT_STATE_NOT_MOVE))
+        return false;
+
+    if (owner->GetTypeId() == TYPEID_UNIT && !i_target->isInAccessiblePlaceFor(owner->ToCreature()))
+        return false;
+
+    if (static_cast<D const*>(this)->IsTargetReachableNow(owner, false) && (!i_pendingPath.updateDestination || owner->IsWithinLOSInMap(i_target.getTarget())))
+        return false;
+
+    // the destination was picked around the target of that moment, drop it once the target is no longer there.
+    // leading destinations are ahead of the target on purpose
+    if (i_pendingPath.updateDestination && !i_pendingPath.leadingTarget)
+        if (!static_cast<D const*>(this)->IsTargetReachableInDestination(owner, G3D::Vector3(i_pendingPath.x, i_pendingPath.y, i_pendingPath.z)))
+            return false;
+
+    return true;
+}
+
 template<class T, typename D>
 bool TargetedMovementGeneratorMedium<T, D>::DoUpdate(T* owner, uint32 time_diff)
 {
@@ -335,6 +396,17 @@ bool TargetedMovementGeneratorMedium<T, D>::DoUpdate(T* owner, uint32 time_diff)
     //     transportChanged = true;
     // }
 
+    // path searched on a worker is ready, the previous spline was followed meanwhile
+    if (i_pathRequest && i_pathRequest->IsDone())
+    {
+        i_pathRequest.reset();
+        i_path->FinishPath();
+        if (_canLaunchPendingPath(owner))
+            _launchPath(owner, true);
+        else
+            i_recalculateTravel = true;
+    }
+
     if (i_recalculateTravel || targetMoved)
     {
         bool splineStarted = _setTargetLocation(owner, targetMoved);
@@ -416,10 +488,8 @@ bool TargetedMovementGeneratorMedium<T, D>::ShouldLeadTarget(T* owner) const
 
 //-----------------------------------------------//
 template<class T>
-bool ChaseMovementGenerator<T>::IsTargetReachableInDestination(T* owner) const
+bool ChaseMovementGenerator<T>::IsTargetReachableInDestination(T* owner, G3D::Vector3 const& dest) const
 {
-    G3D::Vector3 dest{ this->GetDestination(owner) };
-
     float desiredDist;
 
     if (this->i_offset)
@@ -507,14 +577,12 @@ bool FollowMovementGenerator<Player>::EnableWalking() const
 }
 
 template<class T>
-bool FollowMovementGenerator<T>::IsTargetReachableInDestination(T* owner) const
+bool FollowMovementGenerator<T>::IsTargetReachableInDestination(T* owner, G3D::Vector3 const& dest) const
 {
     if (this->ShouldLeadTarget(owner))
         if (this->i_target->HasUnitMovementFlag(MOVEMENTFLAG_FORWARD | MOVEMENTFLAG_BACKWARD | MOVEMENTFLAG_STRAFE_LEFT | MOVEMENTFLAG_STRAFE_RIGHT))
             return false;
 
-    G3D::Vector3 dest{ this->GetDestination(owner) };
-
     float desiredDist;
 
     if (this->i_offset)
@@ -574,13 +642,17 @@ template bool TargetedMovementGeneratorMedium<Player, ChaseMovementGenerator<Pla
 template bool TargetedMovementGeneratorMedium<Player, FollowMovementGenerator<Player> >::_setTargetLocation(Player*, bool);
 template bool TargetedMovementGeneratorMedium<Creature, ChaseMovementGenerator<Creature> >::_setTargetLocation(Creature*, bool);
 template bool TargetedMovementGeneratorMedium<Creature, FollowMovementGenerator<Creature> >::_setTargetLocation(Creature*, bool);
+template bool TargetedMovementGeneratorMedium<Player, ChaseMovementGenerator<Player> >::_launchPath(Player*, bool);
+template bool TargetedMovementGeneratorMedium<Player, FollowMovementGenerator<Player> >::_launchPath(Player*, bool);
+template bool TargetedMovementGeneratorMedium<Creature, ChaseMovementGenerator<Creature> >::_launchPath(Creature*, bool);
+template bool TargetedMovementGeneratorMedium<Creature, FollowMovementGenerator<Creature> >::_launchPath(Creature*, bool);
 template bool TargetedMovementGeneratorMedium<Player, ChaseMovementGenerator<Player> >::DoUpdate(Player*, uint32);
 template bool TargetedMovementGeneratorMedium<Player, FollowMovementGenerator<Player> >::DoUpdate(Player*, uint32);
 template bool TargetedMovementGeneratorMedium<Creature, ChaseMovementGenerator<Creature> >::DoUpdate(Creature*, uint32);
 template bool TargetedMovementGeneratorMedium<Creature, FollowMovementGenerator<Creature> >::DoUpdate(Creature*, uint32);
 
-template bool ChaseMovementGenerator<Player>::IsTargetReachableInDestination(Player*) const;
-template bool ChaseMovementGenerator<Creature>::IsTargetReachableInDestination(Creature*) const;
+template bool ChaseMovementGenerator<Player>::IsTargetReachableInDestination(Player*, G3D::Vector3 const&) const;
+template bool ChaseMovementGenerator<Creature>::IsTargetReachableInDestination(Creature*, G3D::Vector3 const&) const;
 template bool ChaseMovementGenerator<Player>::IsTargetReachableNow(Player*, bool) const;
 template bool ChaseMovementGenerator<Creature>::IsTargetReachableNow(Creature*, bool) const;
 template void ChaseMovementGenerator<Player>::_reachTarget(Player*);
@@ -591,8 +663,8 @@ template void ChaseMovementGenerator<Player>::DoReset(Player*);
 template void ChaseMovementGenerator<Creature>::DoReset(Creature*);
 template void ChaseMovementGenerator<Player>::MovementInform(Player*);
 
-template bool FollowMovementGenerator<Player>::IsTargetReachableInDestination(Player*) const;
-template bool FollowMovementGenerator<Creature>::IsTargetReachableInDestination(Creature*) const;
+template bool FollowMovementGenerator<Player>::IsTargetReachableInDestination(Player*, G3D::Vector3 const&) const;
+template bool FollowMovementGenerator<Creature>::IsTargetReachableInDestination(Creature*, G3D::Vector3 const&) const;
 template bool FollowMovementGenerator<Player>::IsTargetReachableNow(Player*, bool) const;
 template bool FollowMovementGenerator<Creature>::IsTargetReachableNow(Creature*, bool) const;
 template void FollowMovementGenerator<Player>::DoFinalize(Player*);
@@ -23,6 +23,7 @@
 #include "Timer.h"
 #include "Unit.h"
 #include "PathGenerator.h"
+#include "PathRequestMgr.h"
 
 class TargetedMovementGeneratorBase
 {
@@ -41,21 +42,28 @@ class TargetedMovementGeneratorMedium : public MovementGeneratorMedium< T, D >,
 {
     protected:
         TargetedMovementGeneratorMedium(Unit* target, float offset, float angle) :
-            TargetedMovementGeneratorBase(target), i_path(NULL),
+            TargetedMovementGeneratorBase(target), i_path(NULL), i_pendingPath(),
             i_recheckDistance(0), i_offset(offset), i_angle(angle),
             i_recalculateTravel(false), i_targetReached(false)
         {
         }
-        ~TargetedMovementGeneratorMedium() { delete i_path; }
+        ~TargetedMovementGeneratorMedium()
+        {
+            if (i_pathRequest)
+                sPathRequestMgr->Cancel(i_pathRequest);
+            delete i_path;
+        }
 
     public:
         bool DoUpdate(T*, uint32);
         Unit* GetTarget() const { return i_target.getTarget(); }
 
         void unitSpeedChanged() { i_recalculateTravel = true; }
-        bool IsReachable() const { return (i_path) ? (i_path->GetPathType() & PATHFIND_NORMAL) : true; }
+        bool IsReachable() const { return (i_path && !i_pathRequest) ? (i_path->GetPathType() & PATHFIND_NORMAL) : true; }
     protected:
         bool _setTargetLocation(T* owner, bool updateDestination);
+        bool _launchPath(T* owner, bool pathBuilt);
+        bool _canLaunchPendingPath(T* owner) const;
 
         G3D::Vector3 GetDestination(T* owner) const;
 
@@ -63,6 +71,17 @@ class TargetedMovementGeneratorMedium : public MovementGeneratorMedium< T, D >,
         bool ShouldLeadTarget(T* owner) const;
 
         PathGenerator* i_path;
+        PathRequestPtr i_pathRequest;       // search of i_path running on a path worker
+
+        // destination i_path is being built for, used to launch the spline once it is ready
+        struct PendingPath
+        {
+            float x, y, z;
+            bool forceDest;
+            bool leadingTarget;
+            bool updateDestination;
+        } i_pendingPath;
+
         TimeTrackerSmall i_recheckDistance;
         TimeTrackerSmall i_recheckLOS{ 0 };
         float i_offset;
@@ -95,7 +114,8 @@ class ChaseMovementGenerator : public TargetedMovementGeneratorMedium<T, ChaseMo
         static void _clearUnitStateMove(T* u) { u->ClearUnitState(UNIT_STATE_CHASE_MOVE); }
         static void _addUnitStateMove(T* u)  { u->AddUnitState(UNIT_STATE_CHASE_MOVE); }
         bool EnableWalking() const { return false;}
-        bool IsTargetReachableInDestination(T* u) const;
+        bool IsTargetReachableInDestination(T* u) const { return IsTargetReachableInDestination(u, this->GetDestination(u)); }
+        bool IsTargetReachableInDestination(T* u, G3D::Vector3 const& dest) const;
         bool IsTargetReachableNow(T* u, bool duringMovement) const;
         bool _lostTarget(T* u) const { return u->GetVictim() != this->GetTarget(); }
         void _reachTarget(T*);
@@ -121,7 +141,8 @@ class FollowMovementGenerator : public TargetedMovementGeneratorMedium<T, Follow
         static void _clearUnitStateMove(T* u) { u->ClearUnitState(UNIT_STATE_FOLLOW_MOVE); }
         static void _addUnitStateMove(T* u)  { u->AddUnitState(UNIT_STATE_FOLLOW_MOVE); }
         bool EnableWalking() const;
-        bool IsTargetReachableInDestination(T* u) const;
+        bool IsTargetReachableInDestination(T* u) const { return IsTargetReachableInDestination(u, this->GetDestination(u)); }
+        bool IsTargetReachableInDestination(T* u, G3D::Vector3 const& dest) const;
         bool IsTargetReachableNow(T* u, bool duringMovement) const;
         bool _lostTarget(T*) const { return false; }
         void _reachTarget(T*) { }
@@ -0,0 +1,141 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PathCache.h"
+#include "World.h"
+
+PathCache* PathCache::instance()
+{
+    static PathCache instance;
+    return &instance;
+}
+
+bool PathCache::IsEnabled() const
+{
+    return sWorld->getIntConfig(CONFIG_PATHFINDING_CACHE_SIZE) != 0;
+}
+
+PathCache::MapRoutes* PathCache::GetMapRoutes(uint32 mapId, bool create)
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(_mapsLock);
+        auto itr = _maps.find(mapId);
+        if (itr != _maps.end())
+            return itr->second.get();
+    }
+
+    if (!create)
+        return nullptr;
+
+    std::unique_lock<std::shared_mutex> lock(_mapsLock);
+    std::unique_ptr<MapRoutes>& routes = _maps[mapId];
+    if (!routes)
+        routes.reset(new MapRoutes());
+    return routes.get();
+}
+
+bool PathCache::Find(dtNavMesh const* navMesh, uint32 mapId, dtPolyRef startPoly, dtPolyRef endPoly, uint32 filterFlags,
+    dtPolyRef* path, uint32& pathLength, uint32 maxPathLength)
+{
+    MapRoutes* routes = GetMapRoutes(mapId, false);
+    if (!routes)
+    {
+        ++_misses;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(routes->Lock);
+    auto itr = routes->Index.find(RouteKey(std::make_pair(startPoly, endPoly), filterFlags));
+    if (itr == routes->Index.end() || itr->second->Polys.size() > maxPathLength)
+    {
+        ++_misses;
+        return false;
+    }
+
+    Route const& route = *itr->second;
+    for (dtPolyRef poly : route.Polys)
+    {
+        if (!navMesh->isValidPolyRef(poly))
+        {
+            // a tile on the way was reloaded
+            routes->Routes.erase(itr->second);
+            routes->Index.erase(itr);
+            ++_misses;
+            return false;
+        }
+    }
+
+    std::copy(route.Polys.begin(), route.Polys.end(), path);
+    pathLength = uint32(route.Polys.size());
+
+    routes->Routes.splice(routes->Routes.begin(), routes->Routes, itr->second);
+    ++_hits;
+    return true;
+}
+
+void PathCache::Store(uint32 mapId, dtPolyRef startPoly, dtPolyRef endPoly, uint32 filterFlags, dtPolyRef const* path, uint32 pathLength)
+{
+    uint32 maxRoutes = sWorld->getIntConfig(CONFIG_PATHFINDING_CACHE_SIZE);
+    if (!maxRoutes || !pathLength)
+        return;
+
+    MapRoutes* routes = GetMapRoutes(mapId, true);
+    RouteKey key(std::make_pair(startPoly, endPoly), filterFlags);
+
+    std::lock_guard<std::mutex> lock(routes->Lock);
+    auto itr = routes->Index.find(key);
+    if (itr != routes->Index.end())
+    {
+        itr->second->Polys.assign(path, path + pathLength);
+        routes->Routes.splice(routes->Routes.begin(), routes->Routes, itr->second);
+        return;
+    }
+
+    routes->Routes.push_front(Route{ key, std::vector<dtPolyRef>(path, path + pathLength) });
+    routes->Index[key] = routes->Routes.begin();
+
+    while (routes->Routes.size() > maxRoutes)
+    {
+        routes->Index.erase(routes->Routes.back().Key);
+        routes->Routes.pop_back();
+    }
+}
+
+void PathCache::InvalidateMap(uint32 mapId)
+{
+    MapRoutes* routes = GetMapRoutes(mapId, false);
+    if (!routes)
+        return;
+
+    std::lock_guard<std::mutex> lock(routes->Lock);
+    routes->Routes.clear();
+    routes->Index.clear();
+}
+
+uint32 PathCache::GetRouteCount() const
+{
+    uint32 count = 0;
+
+    std::shared_lock<std::shared_mutex> lock(_mapsLock);
+    for (auto const& routes : _maps)
+    {
+        std::lock_guard<std::mutex> routesLock(routes.second->Lock);
+        count += uint32(routes.second->Routes.size());
+    }
+
+    return count;
+}
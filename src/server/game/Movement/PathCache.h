@@ -0,0 +1,85 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TRINITY_PATHCACHE_H
+#define TRINITY_PATHCACHE_H
+
+#include "Define.h"
+#include "DetourNavMesh.h"
+#include "Hash.h"
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+// polygon corridors of recently searched routes, per map
+// routes between the same start and end polygons (spawn to home, waypoint legs) skip the navmesh search
+class TC_GAME_API PathCache
+{
+    typedef std::pair<std::pair<dtPolyRef, dtPolyRef>, uint32> RouteKey;   // [startPoly, endPoly], filter flags
+
+    struct Route
+    {
+        RouteKey Key;
+        std::vector<dtPolyRef> Polys;
+    };
+
+    typedef std::list<Route> RouteList;
+
+    struct MapRoutes
+    {
+        std::mutex Lock;
+        RouteList Routes;   // most recently used first
+        std::unordered_map<RouteKey, RouteList::iterator> Index;
+    };
+
+    public:
+        static PathCache* instance();
+
+        bool IsEnabled() const;
+
+        // copies the cached corridor into path, every polygon is checked against the navmesh before use
+        bool Find(dtNavMesh const* navMesh, uint32 mapId, dtPolyRef startPoly, dtPolyRef endPoly, uint32 filterFlags,
+            dtPolyRef* path, uint32& pathLength, uint32 maxPathLength);
+        // stores a complete corridor from startPoly to endPoly
+        void Store(uint32 mapId, dtPolyRef startPoly, dtPolyRef endPoly, uint32 filterFlags, dtPolyRef const* path, uint32 pathLength);
+        // tiles of the map were unloaded, polygon refs may be reused
+        void InvalidateMap(uint32 mapId);
+
+        uint64 GetHits() const { return _hits; }
+        uint64 GetMisses() const { return _misses; }
+        uint32 GetRouteCount() const;
+
+    private:
+        PathCache() : _hits(0), _misses(0) { }
+        ~PathCache() { }
+
+        MapRoutes* GetMapRoutes(uint32 mapId, bool create);
+
+        mutable std::shared_mutex _mapsLock;
+        std::unordered_map<uint32, std::unique_ptr<MapRoutes>> _maps;
+
+        std::atomic<uint64> _hits;
+        std::atomic<uint64> _misses;
+};
+
+#define sPathCache PathCache::instance()
+
+#endif
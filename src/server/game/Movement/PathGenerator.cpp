@@ -23,6 +23,7 @@
 #include "MapDefines.h"
 #include "MMapFactory.h"
 #include "MMapManager.h"
+#include "PathCache.h"
 #include "Log.h"
 #include "World.h"
 
@@ -34,7 +35,8 @@ PathGenerator::PathGenerator(WorldObject const* owner) :
     _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false),
     _forceDestination(false), _pointPathLimit(MAX_POINT_PATH_LENGTH),
     _endPosition(G3D::Vector3::zero()), _source(owner), _navMesh(nullptr),
-    _navMeshQuery(nullptr), _useRaycast(false)
+    _navMeshQuery(nullptr), _useRaycast(false), _deferNormalize(false),
+    _normalizePending(false), _actualEndOnPath(false)
 {
     memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
 
@@ -45,7 +47,6 @@ PathGenerator::PathGenerator(WorldObject const* owner) :
     {
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
         _navMesh = mmap->GetNavMesh(mapId);
-        _navMeshQuery = mmap->GetNavMeshQuery(mapId, _source->GetInstanceId());
     }
 
     CreateFilter();
@@ -59,6 +60,23 @@ PathGenerator::~PathGenerator()
 }
 
 bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool forceDest, bool straightLine, bool assumeSourceOnGround)
+{
+    switch (PreparePath(destX, destY, destZ, forceDest, assumeSourceOnGround))
+    {
+        case PATH_PREPARE_INVALID:
+            return false;
+        case PATH_PREPARE_DONE:
+            return true;
+        default:
+            break;
+    }
+
+    SearchPath();
+    FinishPath();
+    return true;
+}
+
+PathPrepareResult PathGenerator::PreparePath(float destX, float destY, float destZ, bool forceDest, bool assumeSourceOnGround)
 {
     float x, y, z;
     _source->GetPosition(x, y, z);
@@ -67,7 +85,7 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
         _source->UpdateAllowedPositionZ(x, y, z);
 
     if (!Trinity::IsValidMapCoord(destX, destY, destZ) || !Trinity::IsValidMapCoord(x, y, z))
-        return false;
+        return PATH_PREPARE_INVALID;
 
     G3D::Vector3 dest(destX, destY, destZ);
     SetEndPosition(dest);
@@ -76,6 +94,10 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
     SetStartPosition(start);
 
     _forceDestination = forceDest;
+    _normalizePending = false;
+    _actualEndOnPath = false;
+
+    CaptureSourceState();
 
     TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::CalculatePath() for %u \n", _source->GetGUID().GetCounter());
 
@@ -92,26 +114,104 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
 
     // make sure navMesh works - we can run on map w/o mmap
     // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
+    MMAP::NavMeshReadGuard navMeshGuard;
+    if (_navMesh)
+        navMeshGuard = MMAP::MMapFactory::createOrGetMMapManager()->GetNavMeshReadGuard(_sourceState.mapId);
+
     Unit const* _sourceUnit = _source->ToUnit();
-    if (!_navMesh || !_navMeshQuery || (_sourceUnit && _sourceUnit->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING)) ||
+    if (!navMeshGuard.owns_lock() || (_sourceUnit && _sourceUnit->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING)) ||
         !HaveTile(start) || !HaveTile(dest) || skip)
     {
         BuildShortcut();
         _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
-        return true;
+        return PATH_PREPARE_DONE;
     }
 
     UpdateFilter();
 
-    BuildPolyPath(start, dest);
+    // liquid lookups may load the grid and its navmesh tile, which needs the navmesh exclusively
+    navMeshGuard.unlock();
+    CaptureLiquidState();
+
+    return PATH_PREPARE_SEARCH;
+}
+
+void PathGenerator::SearchPath(bool deferNormalize)
+{
+    // queries are bound to the thread that performs the search, the mesh must not change until we are done
+    MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+    MMAP::NavMeshReadGuard navMeshGuard = mmap->GetNavMeshReadGuard(_sourceState.mapId);
+    _navMeshQuery = navMeshGuard.owns_lock() ? mmap->GetNavMeshQuery(_sourceState.mapId, _sourceState.instanceId) : nullptr;
+    _deferNormalize = deferNormalize;
 
-    if (_sourceUnit->VisualizePathfinding)
+    if (!_navMeshQuery)
+    {
+        BuildShortcut();
+        _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
+    }
+    else
+    {
+        G3D::Vector3 start = GetStartPosition();
+        G3D::Vector3 dest = GetEndPosition();
+        BuildPolyPath(start, dest);
+    }
+
+    _deferNormalize = false;
+    _navMeshQuery = nullptr;
+}
+
+void PathGenerator::FinishPath()
+{
+    // heights can only be adjusted on the owner's map thread, a search done elsewhere leaves that to us
+    if (_normalizePending)
+    {
+        _normalizePending = false;
+        NormalizePath();
+
+        if (_actualEndOnPath && !_pathPoints.empty())
+            SetActualEndPosition(_pathPoints.back());
+    }
+
+    Unit const* _sourceUnit = _source->ToUnit();
+    if (_sourceUnit && _sourceUnit->VisualizePathfinding)
     {
         VisualizePath(2500);
         VisualizeNavmesh(2500);
     }
+}
 
-    return true;
+void PathGenerator::CaptureSourceState()
+{
+    Unit const* unit = _source->ToUnit();
+
+    _sourceState.mapId = _source->GetMapId();
+    _sourceState.instanceId = _source->GetInstanceId();
+    _sourceState.phaseMask = _source->GetPhaseMask();
+    _sourceState.collisionHeight = _source->GetCollisionHeight();
+    _sourceState.isCreature = _source->GetTypeId() == TYPEID_UNIT;
+    _sourceState.canFly = unit && unit->CanFly();
+    _sourceState.canSwim = unit && unit->CanSwim();
+    _sourceState.isFalling = unit && unit->IsFalling();
+    _sourceState.onTransport = _source->GetTransport() != nullptr;
+}
+
+void PathGenerator::CaptureLiquidState()
+{
+    // only used by BuildPolyPath for swimming and flying shortcuts
+    _sourceState.startInLiquid = _sourceState.endInLiquid = false;
+    _sourceState.startInWater = _sourceState.endInWater = false;
+    if (_sourceState.onTransport || (!_sourceState.canSwim && !_sourceState.canFly && !_sourceState.isFalling))
+        return;
+
+    Map const* map = _source->GetMap();
+    ZLiquidStatus startStatus = map->GetLiquidStatus(_sourceState.phaseMask, _startPosition.x, _startPosition.y, _startPosition.z, MAP_ALL_LIQUIDS, nullptr, _sourceState.collisionHeight);
+    ZLiquidStatus endStatus = map->GetLiquidStatus(_sourceState.phaseMask, _endPosition.x, _endPosition.y, _endPosition.z, MAP_ALL_LIQUIDS, nullptr, _sourceState.collisionHeight);
+
+    // the collision height only tells in from under water apart
+    _sourceState.startInLiquid = startStatus != LIQUID_MAP_NO_WATER;
+    _sourceState.endInLiquid = endStatus != LIQUID_MAP_NO_WATER;
+    _sourceState.startInWater = (startStatus & (LIQUID_MAP_IN_WATER | LIQUID_MAP_UNDER_WATER)) != 0;
+    _sourceState.endInWater = (endStatus & (LIQUID_MAP_IN_WATER | LIQUID_MAP_UNDER_WATER)) != 0;
 }
 
 dtPolyRef PathGenerator::GetPathPolyByPosition(dtPolyRef const* polyPath, uint32 polyPathSize, float const* point, float* distance) const
@@ -200,23 +300,11 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
     {
         TC_LOG_DEBUG("maps.mmaps", "++ BuildPolyPath :: (startPoly == 0 || endPoly == 0)\n");
         BuildShortcut();
-        bool path = _source->GetTypeId() == TYPEID_UNIT && _source->ToCreature()->CanFly();
+        bool path = _sourceState.isCreature && _sourceState.canFly;
 
-        bool waterPath = _source->GetTypeId() == TYPEID_UNIT && _source->ToCreature()->CanSwim() && !_source->GetTransport();
-        if (waterPath)
-        {
-            // Check both start and end points, if they're both in water, then we can *safely* let the creature move
-            for (uint32 i = 0; i < _pathPoints.size(); ++i)
-            {
-                ZLiquidStatus status = _source->GetMap()->GetLiquidStatus(_source->GetPhaseMask(), _pathPoints[i].x, _pathPoints[i].y, _pathPoints[i].z, MAP_ALL_LIQUIDS, nullptr, _source->GetCollisionHeight());
-                // One of the points is not in the water, cancel movement.
-                if (status == LIQUID_MAP_NO_WATER)
-                {
-                    waterPath = false;
-                    break;
-                }
-            }
-        }
+        // Check both start and end points, if they're both in water, then we can *safely* let the creature move
+        bool waterPath = _sourceState.isCreature && _sourceState.canSwim && !_sourceState.onTransport &&
+            _sourceState.startInLiquid && _sourceState.endInLiquid;
 
         if (path || waterPath)
         {
@@ -241,25 +329,21 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
 
         bool buildShotrcut = false;
 
-        G3D::Vector3 const& p = (distToStartPoly > 7.0f) ? startPos : endPos;
-        if (!_source->GetTransport() && _source->GetMap()->IsInWater(_source->GetPhaseMask(), p.x, p.y, p.z))
+        bool inWater = startFarFromPoly ? _sourceState.startInWater : _sourceState.endInWater;
+        if (!_sourceState.onTransport && inWater)
         {
             TC_LOG_DEBUG("maps.mmaps", "++ BuildPolyPath :: underWater case\n");
-            if (Unit const* _sourceUnit = _source->ToUnit())
-                if (_sourceUnit->CanSwim())
-                    buildShotrcut = true;
+            if (_sourceState.canSwim)
+                buildShotrcut = true;
         }
         else
         {
             TC_LOG_DEBUG("maps.mmaps", "++ BuildPolyPath :: flying case\n");
-            if (Unit const* _sourceUnit = _source->ToUnit())
-            {
-                if (_sourceUnit->CanFly())
-                    buildShotrcut = true;
-                // Allow to build a shortcut if the unit is falling and it's trying to move downwards towards a target (i.e. charging)
-                else if (_sourceUnit->IsFalling() && endPos.z < startPos.z)
-                    buildShotrcut = true;  
-            }              
+            if (_sourceState.canFly)
+                buildShotrcut = true;
+            // Allow to build a shortcut if the unit is falling and it's trying to move downwards towards a target (i.e. charging)
+            else if (_sourceState.isFalling && endPos.z < startPos.z)
+                buildShotrcut = true;
         }
 
         if (buildShotrcut)
@@ -328,7 +412,7 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
                 TC_LOG_ERROR("maps.mmaps", "Invalid poly ref in BuildPolyPath. _polyLength: %u, pathStartIndex: %u,"
                                      " startPos: %s, endPos: %s, mapid: %u",
                                      _polyLength, pathStartIndex, startPos.toString().c_str(), endPos.toString().c_str(),
-                                     _source->GetMapId());
+                                     _sourceState.mapId);
 
                 break;
             }
@@ -359,6 +443,13 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         _polyLength = pathEndIndex - pathStartIndex + 1;
         memmove(_pathPolyRefs, _pathPolyRefs + pathStartIndex, _polyLength * sizeof(dtPolyRef));
     }
+    else if (startPolyFound && !_useRaycast && MoveCorridorEnd(pathStartIndex, endPoly, endPoint))
+    {
+        TC_LOG_DEBUG("maps.mmaps", "++ BuildPolyPath :: (startPolyFound && endPoly next to path)");
+
+        // target moved a few polygons away from the end of our old poly-path
+        // the corridor was extended by walking there, no search needed
+    }
     else if (startPolyFound && !endPolyFound)
     {
         TC_LOG_DEBUG("maps.mmaps", "++ BuildPolyPath :: (startPolyFound && !endPolyFound)");
@@ -517,15 +608,25 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         }
         else
         {
-            dtResult = _navMeshQuery->findPath(
-                startPoly,          // start polygon
-                endPoly,            // end polygon
-                startPoint,         // start position
-                endPoint,           // end position
-                &_filter,           // polygon search filter
-                _pathPolyRefs,     // [out] path
-                (int*)&_polyLength,
-                MAX_PATH_LENGTH);   // max number of polygons in output path
+            uint32 filterFlags = uint32(_filter.getIncludeFlags()) << 16 | _filter.getExcludeFlags();
+            if (sPathCache->Find(_navMesh, _sourceState.mapId, startPoly, endPoly, filterFlags, _pathPolyRefs, _polyLength, MAX_PATH_LENGTH))
+                dtResult = DT_SUCCESS;
+            else
+            {
+                dtResult = _navMeshQuery->findPath(
+                    startPoly,          // start polygon
+                    endPoly,            // end polygon
+                    startPoint,         // start position
+                    endPoint,           // end position
+                    &_filter,           // polygon search filter
+                    _pathPolyRefs,     // [out] path
+                    (int*)&_polyLength,
+                    MAX_PATH_LENGTH);   // max number of polygons in output path
+
+                // only complete routes are worth remembering
+                if (_polyLength && dtStatusSucceed(dtResult) && !dtStatusDetail(dtResult, DT_PARTIAL_RESULT) && _pathPolyRefs[_polyLength - 1] == endPoly)
+                    sPathCache->Store(_sourceState.mapId, startPoly, endPoly, filterFlags, _pathPolyRefs, _polyLength);
+            }
         }
 
         if (!_polyLength || dtStatusFailed(dtResult))
@@ -621,6 +722,7 @@ void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoin
 
     // first point is always our current location - we need the next one
     SetActualEndPosition(_pathPoints[pointCount-1]);
+    _actualEndOnPath = true;
 
     // force the given destination, if needed
     if (_forceDestination &&
@@ -646,6 +748,12 @@ void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoin
 
 void PathGenerator::NormalizePath()
 {
+    if (_deferNormalize)
+    {
+        _normalizePending = true;
+        return;
+    }
+
     for (uint32 i = 0; i < _pathPoints.size(); ++i)
         _source->UpdateAllowedPositionZ(_pathPoints[i].x, _pathPoints[i].y, _pathPoints[i].z);
 }
@@ -795,6 +903,67 @@ uint32 PathGenerator::FixupCorridor(dtPolyRef* path, uint32 npath, uint32 maxPat
     return req+size;
 }
 
+uint32 PathGenerator::MergeCorridorEndMoved(dtPolyRef* path, uint32 npath, uint32 maxPath, dtPolyRef const* visited, uint32 nvisited)
+{
+    int32 furthestPath = -1;
+    int32 furthestVisited = -1;
+
+    // Find furthest common polygon.
+    for (int32 i = npath-1; i >= 0; --i)
+    {
+        bool found = false;
+        for (int32 j = nvisited-1; j >= 0; --j)
+        {
+            if (path[i] == visited[j])
+            {
+                furthestPath = i;
+                furthestVisited = j;
+                found = true;
+            }
+        }
+        if (found)
+            break;
+    }
+
+    // If no intersection found just return current path.
+    if (furthestPath == -1 || furthestVisited == -1)
+        return npath;
+
+    // Concatenate paths, the end of the path is replaced by the visited polygons.
+    uint32 ppos = furthestPath + 1;
+    uint32 vpos = furthestVisited + 1;
+    uint32 count = std::min(nvisited - vpos, maxPath - ppos);
+    if (count)
+        memcpy(path + ppos, visited + vpos, count * sizeof(dtPolyRef));
+
+    return ppos + count;
+}
+
+bool PathGenerator::MoveCorridorEnd(uint32 pathStartIndex, dtPolyRef endPoly, float const* endPoint)
+{
+    dtPolyRef lastPoly = _pathPolyRefs[_polyLength - 1];
+
+    float lastPoint[VERTEX_SIZE];
+    if (dtStatusFailed(_navMeshQuery->closestPointOnPoly(lastPoly, endPoint, lastPoint, nullptr)))
+        return false;
+
+    static uint32 const MAX_VISIT_POLY = 16;
+    dtPolyRef visited[MAX_VISIT_POLY];
+    uint32 nvisited = 0;
+    float result[VERTEX_SIZE];
+    if (dtStatusFailed(_navMeshQuery->moveAlongSurface(lastPoly, lastPoint, endPoint, &_filter, result, visited, (int*)&nvisited, MAX_VISIT_POLY)))
+        return false;
+
+    // the target must be reachable in a straight walk from the old corridor end, otherwise search
+    if (!nvisited || visited[nvisited - 1] != endPoly || dtVdist2DSqr(result, endPoint) > SMOOTH_PATH_SLOP * SMOOTH_PATH_SLOP)
+        return false;
+
+    _polyLength -= pathStartIndex;
+    memmove(_pathPolyRefs, _pathPolyRefs + pathStartIndex, _polyLength * sizeof(dtPolyRef));
+    _polyLength = MergeCorridorEndMoved(_pathPolyRefs, _polyLength, MAX_PATH_LENGTH, visited, nvisited);
+    return true;
+}
+
 // This function checks if the path has a small U-turn, that is,
 // a polygon further in the path is adjacent to the first polygon
 // in the path. If that happens, a shortcut is taken.
@@ -52,6 +52,32 @@ enum PathType
     PATHFIND_FARFROMPOLY       = PATHFIND_FARFROMPOLY_START | PATHFIND_FARFROMPOLY_END, // start or end positions are far from the mmap poligon  
 };
 
+enum PathPrepareResult
+{
+    PATH_PREPARE_INVALID,   // start or destination is not a valid map coordinate
+    PATH_PREPARE_DONE,      // path was built without searching the navmesh
+    PATH_PREPARE_SEARCH     // SearchPath must be called to build the path
+};
+
+// state of the moving object needed by the search, captured on its map thread
+// the search never touches the map, terrain and liquids are looked up here beforehand
+struct PathSourceState
+{
+    uint32 mapId = 0;
+    uint32 instanceId = 0;
+    uint32 phaseMask = 0;
+    float collisionHeight = 0.0f;
+    bool isCreature = false;
+    bool canFly = false;
+    bool canSwim = false;
+    bool isFalling = false;
+    bool onTransport = false;
+    bool startInLiquid = false;     // any liquid status at the start and end position
+    bool endInLiquid = false;
+    bool startInWater = false;      // in or under water at the start and end position
+    bool endInWater = false;
+};
+
 class TC_GAME_API PathGenerator
 {
     public:
@@ -61,6 +87,13 @@ class TC_GAME_API PathGenerator
         // Calculate the path from owner to given destination
         // return: true if new path was calculated, false otherwise (no change needed)
         bool CalculatePath(float destX, float destY, float destZ, bool forceDest = false, bool straightLine = false, bool assumeSourceOnGround = false);
+
+        // CalculatePath split in steps, so the navmesh search can run away from the owner's map thread
+        // PreparePath and FinishPath must be called from the owner's map thread, SearchPath from any thread
+        PathPrepareResult PreparePath(float destX, float destY, float destZ, bool forceDest = false, bool assumeSourceOnGround = false);
+        void SearchPath(bool deferNormalize = false);
+        void FinishPath();
+        PathSourceState const& GetSourceState() const { return _sourceState; }
         bool IsInvalidDestinationZ(Unit const* target) const;
         static bool IsWalkableClimb(float x, float y, float z, float destX, float destY, float destZ, float sourceHeight);
         static float GetRequiredHeightToClimb(float x, float y, float z, float destX, float destY, float destZ, float sourceHeight);
@@ -135,15 +168,22 @@ class TC_GAME_API PathGenerator
         G3D::Vector3 _actualEndPosition;    // {x, y, z} of the closest possible point to given destination
 
         WorldObject const* const _source;       // the object that is moving
+        PathSourceState _sourceState;           // snapshot of _source used while searching
         dtNavMesh const* _navMesh;              // the nav mesh
-        dtNavMeshQuery const* _navMeshQuery;    // the nav mesh query used to find the path
+        dtNavMeshQuery const* _navMeshQuery;    // the nav mesh query used to find the path, owned by the thread running CalculatePath
 
         dtQueryFilter _filter;  // use single filter for all movements, update it when needed
 
+        bool _deferNormalize;   // searching off the map thread, leave height adjustments to FinishPath
+        bool _normalizePending; // path points still need their heights adjusted
+        bool _actualEndOnPath;  // actual end position is the last path point
+
         void SetStartPosition(G3D::Vector3 const& point) { _startPosition = point; }
         void SetEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; _endPosition = point; }
         void SetActualEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; }
         void NormalizePath();
+        void CaptureSourceState();
+        void CaptureLiquidState();
 
         void Clear()
         {
@@ -169,6 +209,8 @@ class TC_GAME_API PathGenerator
 
         // smooth path aux functions
         uint32 FixupCorridor(dtPolyRef* path, uint32 npath, uint32 maxPath, dtPolyRef const* visited, uint32 nvisited);
+        uint32 MergeCorridorEndMoved(dtPolyRef* path, uint32 npath, uint32 maxPath, dtPolyRef const* visited, uint32 nvisited);
+        bool MoveCorridorEnd(uint32 pathStartIndex, dtPolyRef endPoly, float const* endPoint);
         uint32 FixupShortcuts(dtPolyRef* path, int npath);
         bool GetSteerTarget(float const* startPos, float const* endPos, float minTargetDist, dtPolyRef const* path, uint32 pathSize, float* steerPos,
                             unsigned char& steerPosFlag, dtPolyRef& steerPosRef);
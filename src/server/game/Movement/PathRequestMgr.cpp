@@ -0,0 +1,196 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PathRequestMgr.h"
+#include "PathGenerator.h"
+#include "Log.h"
+#include "Map.h"
+#include "World.h"
+
+PathRequestMgr* PathRequestMgr::instance()
+{
+    static PathRequestMgr instance;
+    return &instance;
+}
+
+void PathRequestMgr::Initialize()
+{
+    if (!sWorld->getBoolConfig(CONFIG_ENABLE_MMAPS) || !sWorld->getBoolConfig(CONFIG_PATHFINDING_ASYNC))
+        return;
+
+    _maxRequestsPerMap = sWorld->getIntConfig(CONFIG_PATHFINDING_ASYNC_MAP_LIMIT);
+
+    uint32 numThreads = std::max<uint32>(1, sWorld->getIntConfig(CONFIG_PATHFINDING_ASYNC_THREADS));
+    for (uint32 i = 0; i < numThreads; ++i)
+        _workerThreads.push_back(std::thread(&PathRequestMgr::WorkerThread, this));
+
+    TC_LOG_INFO("server.loading", "Asynchronous pathfinding enabled with %u threads, %u requests per map", numThreads, _maxRequestsPerMap);
+}
+
+void PathRequestMgr::Shutdown()
+{
+    if (!IsEnabled())
+        return;
+
+    _cancelationToken = true;
+
+    // the queue drops what is left in it, finish those requests as cancelled so their map is not waited for forever
+    PathRequestPtr request;
+    while (_queue.Pop(request))
+        CancelQueued(*request);
+
+    _queue.Cancel();
+
+    for (auto& thread : _workerThreads)
+        thread.join();
+
+    _workerThreads.clear();
+}
+
+PathRequestPtr PathRequestMgr::Submit(PathGenerator* generator, Map const* map)
+{
+    std::unique_lock<std::mutex> lock(_lock);
+
+    PathRequestStats& mapStats = _mapStats[map->GetId()];
+    uint32& instanceInFlight = _instanceInFlight[map];
+    if (_maxRequestsPerMap && instanceInFlight >= _maxRequestsPerMap)
+    {
+        ++mapStats.Rejected;
+        ++_stats.Rejected;
+        return nullptr;
+    }
+
+    ++instanceInFlight;
+    ++mapStats.Submitted;
+    ++mapStats.InFlight;
+    ++_stats.Submitted;
+    ++_stats.InFlight;
+    lock.unlock();
+
+    PathRequestPtr request = std::make_shared<PathRequest>(generator, map, map->GetId());
+    _queue.Push(request);
+    return request;
+}
+
+void PathRequestMgr::Cancel(PathRequestPtr const& request)
+{
+    PathRequestState expected = PATH_REQUEST_QUEUED;
+    if (request->State.compare_exchange_strong(expected, PATH_REQUEST_CANCELLED))
+        return;
+
+    // the search is already running and uses the generator, it has to end before the caller may free it
+    std::unique_lock<std::mutex> lock(_lock);
+    while (request->State.load() == PATH_REQUEST_RUNNING)
+        _condition.wait(lock);
+}
+
+void PathRequestMgr::WaitForMap(Map const* map)
+{
+    if (!IsEnabled())
+        return;
+
+    // the counter is erased once it drops to zero
+    std::unique_lock<std::mutex> lock(_lock);
+    while (_instanceInFlight.find(map) != _instanceInFlight.end())
+        _condition.wait(lock);
+}
+
+PathRequestStats PathRequestMgr::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return _stats;
+}
+
+PathRequestStats PathRequestMgr::GetMapStats(uint32 mapId) const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    auto itr = _mapStats.find(mapId);
+    return itr != _mapStats.end() ? itr->second : PathRequestStats();
+}
+
+void PathRequestMgr::RequestFinished(PathRequest const& request, uint64 queueTimeUs, uint64 computeTimeUs, bool cancelled)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    auto itr = _instanceInFlight.find(request.Owner);
+    if (itr != _instanceInFlight.end() && !--itr->second)
+        _instanceInFlight.erase(itr);
+
+    for (PathRequestStats* stats : { &_stats, &_mapStats[request.MapId] })
+    {
+        --stats->InFlight;
+        stats->QueueTimeUs += queueTimeUs;
+        if (cancelled)
+        {
+            ++stats->Cancelled;
+            continue;
+        }
+
+        ++stats->Completed;
+        stats->ComputeTimeUs += computeTimeUs;
+        stats->MaxComputeTimeUs = std::max(stats->MaxComputeTimeUs, computeTimeUs);
+    }
+
+    _condition.notify_all();
+}
+
+void PathRequestMgr::CancelQueued(PathRequest& request)
+{
+    request.State.store(PATH_REQUEST_CANCELLED);
+    RequestFinished(request, (TimeValue::Now() - request.SubmitTime).ToMicroseconds(), 0, true);
+}
+
+void PathRequestMgr::WorkerThread()
+{
+    while (true)
+    {
+        PathRequestPtr request;
+
+        _queue.WaitAndPop(request);
+
+        if (_cancelationToken)
+        {
+            if (request)
+                CancelQueued(*request);
+            return;
+        }
+
+        if (!request)
+            continue;
+
+        uint64 queueTimeUs = (TimeValue::Now() - request->SubmitTime).ToMicroseconds();
+
+        PathRequestState expected = PATH_REQUEST_QUEUED;
+        if (!request->State.compare_exchange_strong(expected, PATH_REQUEST_RUNNING))
+        {
+            RequestFinished(*request, queueTimeUs, 0, true);
+            continue;
+        }
+
+        TimeValue searchStart = TimeValue::Now();
+        request->Generator->SearchPath(true);
+        uint64 computeTimeUs = (TimeValue::Now() - searchStart).ToMicroseconds();
+
+        {
+            // published under the lock so Cancel can not miss the wakeup
+            std::lock_guard<std::mutex> lock(_lock);
+            request->State.store(PATH_REQUEST_DONE, std::memory_order_release);
+        }
+
+        RequestFinished(*request, queueTimeUs, computeTimeUs, false);
+    }
+}
@@ -0,0 +1,119 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TRINITY_PATHREQUESTMGR_H
+#define TRINITY_PATHREQUESTMGR_H
+
+#include "Define.h"
+#include "ProducerConsumerQueue.h"
+#include "TimeValue.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class Map;
+class PathGenerator;
+
+enum PathRequestState : uint8
+{
+    PATH_REQUEST_QUEUED,
+    PATH_REQUEST_RUNNING,
+    PATH_REQUEST_DONE,
+    PATH_REQUEST_CANCELLED
+};
+
+// a navmesh search handed to the path workers
+// the generator is owned by the submitter and must not be touched until the request is done or cancelled
+struct PathRequest
+{
+    PathRequest(PathGenerator* generator, Map const* map, uint32 mapId) : Generator(generator), Owner(map), MapId(mapId),
+        State(PATH_REQUEST_QUEUED), SubmitTime(TimeValue::Now()) { }
+
+    bool IsDone() const { return State.load(std::memory_order_acquire) == PATH_REQUEST_DONE; }
+
+    PathGenerator* const Generator;
+    Map const* const Owner;     // only used as key, the search never touches the map
+    uint32 const MapId;
+    std::atomic<PathRequestState> State;
+    TimeValue const SubmitTime;
+};
+
+typedef std::shared_ptr<PathRequest> PathRequestPtr;
+
+struct PathRequestStats
+{
+    uint64 Submitted = 0;
+    uint64 Completed = 0;
+    uint64 Cancelled = 0;
+    uint64 Rejected = 0;        // map limit reached, caller calculated the path itself
+    uint64 QueueTimeUs = 0;     // total time spent waiting for a worker
+    uint64 ComputeTimeUs = 0;   // total time spent searching
+    uint64 MaxComputeTimeUs = 0;
+    uint32 InFlight = 0;        // of all instances of the map
+};
+
+class TC_GAME_API PathRequestMgr
+{
+    public:
+        static PathRequestMgr* instance();
+
+        void Initialize();
+        void Shutdown();
+
+        bool IsEnabled() const { return !_workerThreads.empty(); }
+
+        // queues the navmesh search of a generator that returned PATH_PREPARE_SEARCH
+        // returns nullptr when the map instance already has too many searches in flight
+        PathRequestPtr Submit(PathGenerator* generator, Map const* map);
+
+        // drops a request that was not picked up yet, or waits for the running search to end
+        void Cancel(PathRequestPtr const& request);
+
+        // blocks until no search submitted by the given map instance is queued or running
+        void WaitForMap(Map const* map);
+
+        PathRequestStats GetStats() const;
+        PathRequestStats GetMapStats(uint32 mapId) const;
+
+    private:
+        PathRequestMgr() : _maxRequestsPerMap(0) { }
+        ~PathRequestMgr() { }
+
+        void WorkerThread();
+        void RequestFinished(PathRequest const& request, uint64 queueTimeUs, uint64 computeTimeUs, bool cancelled);
+        // accounts a request that was taken off the queue at shutdown and will never be searched
+        void CancelQueued(PathRequest& request);
+
+        ProducerConsumerQueue<PathRequestPtr> _queue;
+        std::vector<std::thread> _workerThreads;
+        std::atomic<bool> _cancelationToken{ false };
+        uint32 _maxRequestsPerMap;
+
+        mutable std::mutex _lock;
+        std::condition_variable _condition;
+        PathRequestStats _stats;
+        std::unordered_map<uint32, PathRequestStats> _mapStats;
+        std::unordered_map<Map const*, uint32> _instanceInFlight;
+};
+
+#define sPathRequestMgr PathRequestMgr::instance()
+
+#endif
@@ -83,7 +83,7 @@ PlayerbotScript::PlayerbotScript(const char* name) : ScriptObject(name)
     ScriptRegistry<PlayerbotScript>::AddScript(this);
 }
 
-ScriptObject::ScriptObject(char const* name) : _name(name)
+ScriptObject::ScriptObject(char const* name) : _name(name), _unimplementedHooks(0)
 {
     sScriptMgr->IncreaseScriptCount();
 }
@@ -93,8 +93,15 @@ ScriptObject::~ScriptObject()
     sScriptMgr->DecreaseScriptCount();
 }
 
+void ScriptObject::SetHookBit(uint8 bit)
+{
+    uint64 mask = UI64LIT(1) << bit;
+    if (!(_unimplementedHooks.fetch_or(mask, std::memory_order_relaxed) & mask))
+        sScriptMgr->MarkHookListsDirty();
+}
+
 ScriptMgr::ScriptMgr()
-    : _scriptCount(0), _scheduledScripts(0) { }
+    : _scriptCount(0), _hookListsDirty(false), _hookProfiling(false), _scheduledScripts(0) { }
 
 ScriptMgr::~ScriptMgr() { }
 
@@ -125,6 +132,7 @@ void ScriptMgr::Initialize()
 #endif
 
     UnloadUnusedScripts();
+    RebuildHookLists();
 
     TC_LOG_INFO("server.loading", ">> Loaded %u C++ scripts in %u ms", GetScriptCount(), GetMSTimeDiffToNow(oldMSTime));
     /* Eluna [Lua Engine] */
@@ -138,7 +146,9 @@ void ScriptMgr::Unload()
 #define SCR_CLEAR(T) \
         for (SCR_REG_ITR(T) itr = SCR_REG_LST(T).begin(); itr != SCR_REG_LST(T).end(); ++itr) \
             delete itr->second; \
-        SCR_REG_LST(T).clear();
+        SCR_REG_LST(T).clear(); \
+        for (auto& hookList : ScriptRegistry<T>::EnabledHooks) \
+            hookList.clear();
 
     // Clear scripts for every script type.
     SCR_CLEAR(SpellScriptLoader);
@@ -412,7 +422,11 @@ void ScriptMgr::OnShutdownCancel()
 
 void ScriptMgr::OnWorldUpdate(uint32 diff)
 {
-    FOREACH_SCRIPT(WorldScript)->OnUpdate(diff);
+    // maps are not updated at this point of the world tick
+    if (_hookListsDirty)
+        RebuildHookLists();
+
+    CALL_ENABLED_HOOKS(WorldScript, WORLDHOOK_ON_UPDATE, script->OnUpdate(diff));
 }
 
 void ScriptMgr::OnHonorCalculation(float& honor, uint8 level, float multiplier)
@@ -1385,7 +1399,7 @@ void ScriptMgr::OnCreatureKill(Player* killer, Creature* killed)
 #ifdef ELUNA
     sHookMgr->OnCreatureKill(killer, killed);
 #endif
-    FOREACH_SCRIPT(PlayerScript)->OnCreatureKill(killer, killed);
+    CALL_ENABLED_HOOKS(PlayerScript, PLAYERHOOK_ON_CREATURE_KILL, script->OnCreatureKill(killer, killed));
 }
 
 void ScriptMgr::OnPlayerKilledByCreature(Creature* killer, Player* killed)
@@ -1430,7 +1444,7 @@ void ScriptMgr::OnPlayerMoneyChanged(Player* player, int64& amount)
 #ifdef ELUNA
     sHookMgr->OnMoneyChanged(player, amount);
 #endif
-    FOREACH_SCRIPT(PlayerScript)->OnMoneyChanged(player, amount);
+    CALL_ENABLED_HOOKS(PlayerScript, PLAYERHOOK_ON_MONEY_CHANGED, script->OnMoneyChanged(player, amount));
 }
 
 void ScriptMgr::OnGivePlayerXP(Player* player, uint32& amount, Unit* victim)
@@ -1438,7 +1452,7 @@ void ScriptMgr::OnGivePlayerXP(Player* player, uint32& amount, Unit* victim)
 #ifdef ELUNA
     sHookMgr->OnGiveXP(player, amount, victim);
 #endif
-    FOREACH_SCRIPT(PlayerScript)->OnGiveXP(player, amount, victim);
+    CALL_ENABLED_HOOKS(PlayerScript, PLAYERHOOK_ON_GIVE_XP, script->OnGiveXP(player, amount, victim));
 }
 
 void ScriptMgr::OnPlayerReputationChange(Player* player, uint32 factionID, float& standing, bool incremental)
@@ -1446,7 +1460,7 @@ void ScriptMgr::OnPlayerReputationChange(Player* player, uint32 factionID, float
     //#ifdef ELUNA
     //    sHookMgr->OnReputationChange(player, factionID, standing, incremental);
     //#endif
-    FOREACH_SCRIPT(PlayerScript)->OnReputationChange(player, factionID, standing, incremental);
+    CALL_ENABLED_HOOKS(PlayerScript, PLAYERHOOK_ON_REPUTATION_CHANGE, script->OnReputationChange(player, factionID, standing, incremental));
 }
 
 void ScriptMgr::OnPlayerQuestAdded(Player* player, const Quest* quest)
@@ -1559,7 +1573,7 @@ void ScriptMgr::OnPlayerSpellCast(Player* player, Spell* spell, bool skipCheck)
 #ifdef ELUNA
     sHookMgr->OnSpellCast(player, spell, skipCheck);
 #endif
-    FOREACH_SCRIPT(PlayerScript)->OnSpellCast(player, spell, skipCheck);
+    CALL_ENABLED_HOOKS(PlayerScript, PLAYERHOOK_ON_SPELL_CAST, script->OnSpellCast(player, spell, skipCheck));
 }
 
 void ScriptMgr::OnPlayerLogin(Player* player)
@@ -1615,7 +1629,7 @@ void ScriptMgr::OnUpdate(Player* player, uint32 diff)
     //#ifdef ELUNA
     //    sHookMgr->OnUpdate(player, diff);
     //#endif
-    FOREACH_SCRIPT(PlayerScript)->OnUpdate(player, diff);
+    CALL_ENABLED_HOOKS(PlayerScript, PLAYERHOOK_ON_UPDATE, script->OnUpdate(player, diff));
 }
 
 void ScriptMgr::OnPlayerUpdateZone(Player* player, uint32 newZone, uint32 newArea)
@@ -1623,20 +1637,20 @@ void ScriptMgr::OnPlayerUpdateZone(Player* player, uint32 newZone, uint32 newAre
 #ifdef ELUNA
     sHookMgr->OnUpdateZone(player, newZone, newArea);
 #endif
-    FOREACH_SCRIPT(PlayerScript)->OnUpdateZone(player, newZone, newArea);
+    CALL_ENABLED_HOOKS(PlayerScript, PLAYERHOOK_ON_UPDATE_ZONE, script->OnUpdateZone(player, newZone, newArea));
 }
 
 void ScriptMgr::OnPlayerBeforeUpdate(Player* player, uint32 p_time)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnBeforeUpdate(player, p_time);
+    CALL_ENABLED_HOOKS(PlayerScript, PLAYERHOOK_ON_BEFORE_UPDATE, script->OnBeforeUpdate(player, p_time));
 }
 void ScriptMgr::OnPlayerUpdate(Player* player, uint32 p_time)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnUpdate(player, p_time);
+    CALL_ENABLED_HOOKS(PlayerScript, PLAYERHOOK_ON_UPDATE, script->OnUpdate(player, p_time));
 }
 void ScriptMgr::OnPlayerAfterUpdate(Player* player, uint32 diff)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnAfterUpdate(player, diff);
+    CALL_ENABLED_HOOKS(PlayerScript, PLAYERHOOK_ON_AFTER_UPDATE, script->OnAfterUpdate(player, diff));
 }
 
 // Guild
@@ -1840,27 +1854,100 @@ void ScriptMgr::OnGlobalMirrorImageDisplayItem(const Item* item, uint32& display
 // Unit
 void ScriptMgr::OnHeal(Unit* healer, Unit* reciever, uint32& gain)
 {
-    FOREACH_SCRIPT(UnitScript)->OnHeal(healer, reciever, gain);
+    CALL_ENABLED_HOOKS(UnitScript, UNITHOOK_ON_HEAL, script->OnHeal(healer, reciever, gain));
 }
 
 void ScriptMgr::OnDamage(Unit* attacker, Unit* victim, uint32& damage)
 {
-    FOREACH_SCRIPT(UnitScript)->OnDamage(attacker, victim, damage);
+    CALL_ENABLED_HOOKS(UnitScript, UNITHOOK_ON_DAMAGE, script->OnDamage(attacker, victim, damage));
 }
 
 void ScriptMgr::ModifyPeriodicDamageAurasTick(Unit* target, Unit* attacker, int32& damage)
 {
-    FOREACH_SCRIPT(UnitScript)->ModifyPeriodicDamageAurasTick(target, attacker, damage);
+    CALL_ENABLED_HOOKS(UnitScript, UNITHOOK_MODIFY_PERIODIC_DAMAGE_AURAS_TICK, script->ModifyPeriodicDamageAurasTick(target, attacker, damage));
 }
 
 void ScriptMgr::ModifyMeleeDamage(Unit* target, Unit* attacker, uint32& damage)
 {
-    FOREACH_SCRIPT(UnitScript)->ModifyMeleeDamage(target, attacker, damage);
+    CALL_ENABLED_HOOKS(UnitScript, UNITHOOK_MODIFY_MELEE_DAMAGE, script->ModifyMeleeDamage(target, attacker, damage));
 }
 
 void ScriptMgr::ModifySpellDamageTaken(Unit* target, Unit* attacker, int32& damage)
 {
-    FOREACH_SCRIPT(UnitScript)->ModifySpellDamageTaken(target, attacker, damage);
+    CALL_ENABLED_HOOKS(UnitScript, UNITHOOK_MODIFY_SPELL_DAMAGE_TAKEN, script->ModifySpellDamageTaken(target, attacker, damage));
+}
+
+// Hook dispatch
+static char const* const WorldHookNames[WORLDHOOK_END] =
+{
+    "OnUpdate"
+};
+
+static char const* const UnitHookNames[UNITHOOK_END] =
+{
+    "OnHeal",
+    "OnDamage",
+    "ModifyPeriodicDamageAurasTick",
+    "ModifyMeleeDamage",
+    "ModifySpellDamageTaken"
+};
+
+static char const* const PlayerHookNames[PLAYERHOOK_END] =
+{
+    "OnCreatureKill",
+    "OnMoneyChanged",
+    "OnGiveXP",
+    "OnReputationChange",
+    "OnSpellCast",
+    "OnUpdateZone",
+    "OnUpdate",
+    "OnBeforeUpdate",
+    "OnAfterUpdate"
+};
+
+template<class TScript>
+static void ResetRegistryHookStats(uint8 hookCount)
+{
+    for (uint8 hook = 0; hook < hookCount; ++hook)
+    {
+        ScriptRegistry<TScript>::HookStats[hook].Calls = 0;
+        ScriptRegistry<TScript>::HookStats[hook].TotalNs = 0;
+    }
+}
+
+template<class TScript>
+static void AddRegistryHookReport(std::vector<ScriptMgr::HookReport>& report, char const* scriptType, char const* const* hookNames, uint8 hookCount)
+{
+    for (uint8 hook = 0; hook < hookCount; ++hook)
+    {
+        ScriptHookStats const& stats = ScriptRegistry<TScript>::HookStats[hook];
+        report.push_back({ scriptType, hookNames[hook], uint32(ScriptRegistry<TScript>::EnabledHooks[hook].size()), stats.Calls.load(), stats.TotalNs.load() });
+    }
+}
+
+void ScriptMgr::RebuildHookLists()
+{
+    _hookListsDirty = false;
+
+    ScriptRegistry<WorldScript>::RebuildEnabledHooks(WORLDHOOK_END);
+    ScriptRegistry<UnitScript>::RebuildEnabledHooks(UNITHOOK_END);
+    ScriptRegistry<PlayerScript>::RebuildEnabledHooks(PLAYERHOOK_END);
+}
+
+void ScriptMgr::ResetHookStats()
+{
+    ResetRegistryHookStats<WorldScript>(WORLDHOOK_END);
+    ResetRegistryHookStats<UnitScript>(UNITHOOK_END);
+    ResetRegistryHookStats<PlayerScript>(PLAYERHOOK_END);
+}
+
+std::vector<ScriptMgr::HookReport> ScriptMgr::GetHookReport() const
+{
+    std::vector<HookReport> report;
+    AddRegistryHookReport<WorldScript>(report, "WorldScript", WorldHookNames, WORLDHOOK_END);
+    AddRegistryHookReport<UnitScript>(report, "UnitScript", UnitHookNames, UNITHOOK_END);
+    AddRegistryHookReport<PlayerScript>(report, "PlayerScript", PlayerHookNames, PLAYERHOOK_END);
+    return report;
 }
 
 // Scene
@@ -2116,6 +2203,8 @@ GlobalScript::GlobalScript(const char* name)
 // Instantiate static members of ScriptRegistry.
 template<class TScript> std::map<uint32, TScript*> ScriptRegistry<TScript>::ScriptPointerList;
 template<class TScript> uint32 ScriptRegistry<TScript>::_scriptIdCounter = 100000000;
+template<class TScript> std::array<std::vector<TScript*>, MAX_HOOKS_PER_SCRIPT_TYPE> ScriptRegistry<TScript>::EnabledHooks;
+template<class TScript> std::array<ScriptHookStats, MAX_HOOKS_PER_SCRIPT_TYPE> ScriptRegistry<TScript>::HookStats;
 
 // Specialize for each script type class like so:
 template class ScriptRegistry<SpellScriptLoader>;
@@ -20,6 +20,7 @@
 
 #include "Common.h"
 #include "ObjectGuid.h"
+#include <array>
 #include <atomic>
 
 #include "DBCStores.h"
@@ -157,6 +158,44 @@ struct QuestObjective;
     event on all registered scripts of that type.
 */
 
+// Hooks that are dispatched through ScriptRegistry<T>::EnabledHooks, numbered per script type.
+// Their default implementations report themselves, so overrides must not call the base implementation.
+enum WorldHook : uint8
+{
+    WORLDHOOK_ON_UPDATE,
+    WORLDHOOK_END
+};
+
+enum UnitHook : uint8
+{
+    UNITHOOK_ON_HEAL,
+    UNITHOOK_ON_DAMAGE,
+    UNITHOOK_MODIFY_PERIODIC_DAMAGE_AURAS_TICK,
+    UNITHOOK_MODIFY_MELEE_DAMAGE,
+    UNITHOOK_MODIFY_SPELL_DAMAGE_TAKEN,
+    UNITHOOK_END
+};
+
+enum PlayerHook : uint8
+{
+    PLAYERHOOK_ON_CREATURE_KILL,
+    PLAYERHOOK_ON_MONEY_CHANGED,
+    PLAYERHOOK_ON_GIVE_XP,
+    PLAYERHOOK_ON_REPUTATION_CHANGE,
+    PLAYERHOOK_ON_SPELL_CAST,
+    PLAYERHOOK_ON_UPDATE_ZONE,
+    PLAYERHOOK_ON_UPDATE,
+    PLAYERHOOK_ON_BEFORE_UPDATE,
+    PLAYERHOOK_ON_AFTER_UPDATE,
+    PLAYERHOOK_END
+};
+
+uint8 const MAX_HOOKS_PER_SCRIPT_TYPE = 64;
+
+static_assert(WORLDHOOK_END <= MAX_HOOKS_PER_SCRIPT_TYPE && UNITHOOK_END <= MAX_HOOKS_PER_SCRIPT_TYPE && PLAYERHOOK_END <= MAX_HOOKS_PER_SCRIPT_TYPE,
+    "ScriptRegistry keeps one list per hook");
+static_assert(WORLDHOOK_END <= 64 && UNITHOOK_END + PLAYERHOOK_END <= 64, "ScriptObject keeps one bit per hook");
+
 class ScriptObject
 {
     friend class ScriptMgr;
@@ -165,14 +204,28 @@ public:
 
     const std::string& GetName() const { return _name; }
 
+    // False once the default implementation of the hook was reached, the script is then dropped from that hook's dispatch list.
+    bool IsHookImplemented(WorldHook hook) const { return !IsHookBitSet(hook); }
+    bool IsHookImplemented(UnitHook hook) const { return !IsHookBitSet(hook); }
+    // PlayerScript derives from UnitScript, its hooks take the bits after the unit hooks
+    bool IsHookImplemented(PlayerHook hook) const { return !IsHookBitSet(UNITHOOK_END + hook); }
+
 protected:
 
         explicit ScriptObject(char const* name);
         virtual ~ScriptObject();
 
+        void SetHookUnimplemented(WorldHook hook) { SetHookBit(hook); }
+        void SetHookUnimplemented(UnitHook hook) { SetHookBit(hook); }
+        void SetHookUnimplemented(PlayerHook hook) { SetHookBit(UNITHOOK_END + hook); }
+
 private:
 
+    bool IsHookBitSet(uint8 bit) const { return (_unimplementedHooks.load(std::memory_order_relaxed) & (UI64LIT(1) << bit)) != 0; }
+    void SetHookBit(uint8 bit);
+
     const std::string _name;
+    std::atomic<uint64> _unimplementedHooks;
 };
 
 template<class TObject> class UpdatableScript
@@ -259,7 +312,7 @@ public:
     virtual void OnShutdownCancel() { }
 
     // Called on every world tick (don't execute too heavy code here).
-    virtual void OnUpdate(uint32 /*diff*/) { }
+    virtual void OnUpdate(uint32 /*diff*/) { SetHookUnimplemented(WORLDHOOK_ON_UPDATE); }
 
     // Called when the world is started.
     virtual void OnStartup() { }
@@ -405,19 +458,19 @@ protected:
 
 public:
     // Called when a unit deals healing to another unit
-    virtual void OnHeal(Unit* /*healer*/, Unit* /*reciever*/, uint32& /*gain*/) { }
+    virtual void OnHeal(Unit* /*healer*/, Unit* /*reciever*/, uint32& /*gain*/) { SetHookUnimplemented(UNITHOOK_ON_HEAL); }
 
     // Called when a unit deals damage to another unit
-    virtual void OnDamage(Unit* /*attacker*/, Unit* /*victim*/, uint32& /*damage*/) { }
+    virtual void OnDamage(Unit* /*attacker*/, Unit* /*victim*/, uint32& /*damage*/) { SetHookUnimplemented(UNITHOOK_ON_DAMAGE); }
 
     // Called when DoT's Tick Damage is being Dealt
-    virtual void ModifyPeriodicDamageAurasTick(Unit* /*target*/, Unit* /*attacker*/, int32& /*damage*/) { }
+    virtual void ModifyPeriodicDamageAurasTick(Unit* /*target*/, Unit* /*attacker*/, int32& /*damage*/) { SetHookUnimplemented(UNITHOOK_MODIFY_PERIODIC_DAMAGE_AURAS_TICK); }
 
     // Called when Melee Damage is being Dealt
-    virtual void ModifyMeleeDamage(Unit* /*target*/, Unit* /*attacker*/, uint32& /*damage*/) { }
+    virtual void ModifyMeleeDamage(Unit* /*target*/, Unit* /*attacker*/, uint32& /*damage*/) { SetHookUnimplemented(UNITHOOK_MODIFY_MELEE_DAMAGE); }
 
     // Called when Spell Damage is being Dealt
-    virtual void ModifySpellDamageTaken(Unit* /*target*/, Unit* /*attacker*/, int32& /*damage*/) { }
+    virtual void ModifySpellDamageTaken(Unit* /*target*/, Unit* /*attacker*/, int32& /*damage*/) { SetHookUnimplemented(UNITHOOK_MODIFY_SPELL_DAMAGE_TAKEN); }
 };
 
 class CreatureScript : public ScriptObject
@@ -702,7 +755,7 @@ public:
     virtual void OnPVPKill(Player* /*killer*/, Player* /*killed*/) { }
 
     // Called when a player kills a creature
-    virtual void OnCreatureKill(Player* /*killer*/, Creature* /*killed*/) { }
+    virtual void OnCreatureKill(Player* /*killer*/, Creature* /*killed*/) { SetHookUnimplemented(PLAYERHOOK_ON_CREATURE_KILL); }
 
     // Called when a player is killed by a creature
     virtual void OnPlayerKilledByCreature(Creature* /*killer*/, Player* /*killed*/) { }
@@ -720,13 +773,13 @@ public:
     virtual void OnTalentsReset(Player* /*player*/, bool /*noCost*/) { }
 
     // Called when a player's money is modified (before the modification is done)
-    virtual void OnMoneyChanged(Player* /*player*/, int64& /*amount*/) { }
+    virtual void OnMoneyChanged(Player* /*player*/, int64& /*amount*/) { SetHookUnimplemented(PLAYERHOOK_ON_MONEY_CHANGED); }
 
     // Called when a player gains XP (before anything is given)
-    virtual void OnGiveXP(Player* /*player*/, uint32& /*amount*/, Unit* /*victim*/) { }
+    virtual void OnGiveXP(Player* /*player*/, uint32& /*amount*/, Unit* /*victim*/) { SetHookUnimplemented(PLAYERHOOK_ON_GIVE_XP); }
 
     // Called when a player's reputation changes (before it is actually changed)
-    virtual void OnReputationChange(Player* /*player*/, uint32 /*factionId*/, float& /*standing*/, bool /*incremental*/) { }
+    virtual void OnReputationChange(Player* /*player*/, uint32 /*factionId*/, float& /*standing*/, bool /*incremental*/) { SetHookUnimplemented(PLAYERHOOK_ON_REPUTATION_CHANGE); }
 
     // Called when a player accepts a new quest
     virtual void OnQuestAdded(Player* /*player*/, const Quest* /*quest*/) { }
@@ -769,7 +822,7 @@ public:
     virtual void OnTextEmote(Player* /*player*/, uint32 /*textEmote*/, uint32 /*emoteNum*/, ObjectGuid /*guid*/) { }
 
     // Called in Spell::Cast.
-    virtual void OnSpellCast(Player* /*player*/, Spell* /*spell*/, bool /*skipCheck*/) { }
+    virtual void OnSpellCast(Player* /*player*/, Spell* /*spell*/, bool /*skipCheck*/) { SetHookUnimplemented(PLAYERHOOK_ON_SPELL_CAST); }
 
     // Called when a player logs in.
     virtual void OnLogin(Player* /*player*/) { }
@@ -790,12 +843,12 @@ public:
     virtual void OnBindToInstance(Player* /*player*/, Difficulty /*difficulty*/, uint32 /*mapId*/, bool /*permanent*/) { }
 
     // Called when a player switches to a new zone
-    virtual void OnUpdateZone(Player* /*player*/, uint32 /*newZone*/, uint32 /*newArea*/) { }
+    virtual void OnUpdateZone(Player* /*player*/, uint32 /*newZone*/, uint32 /*newArea*/) { SetHookUnimplemented(PLAYERHOOK_ON_UPDATE_ZONE); }
 
     // Called when a player changes to a new map (after moving to new map)
     virtual void OnMapChanged(Player* /*player*/) { }
 
-    virtual void OnUpdate(Player* /*player*/, uint32 /*diff*/) { }
+    virtual void OnUpdate(Player* /*player*/, uint32 /*diff*/) { SetHookUnimplemented(PLAYERHOOK_ON_UPDATE); }
 
     // Called when a player selects an option in a player gossip window
     virtual void OnGossipSelect(Player* /*player*/, uint32 /*menu_id*/, uint32 /*sender*/, uint32 /*action*/) { }
@@ -804,8 +857,8 @@ public:
     virtual void OnGossipSelectCode(Player* /*player*/, uint32 /*menu_id*/, uint32 /*sender*/, uint32 /*action*/, const char* /*code*/) { }
 
     // Called for player::update
-    virtual void OnBeforeUpdate(Player* /*player*/, uint32 /*p_time*/) { }
-    virtual void OnAfterUpdate(Player* /*player*/, uint32 /*diff*/) {}
+    virtual void OnBeforeUpdate(Player* /*player*/, uint32 /*p_time*/) { SetHookUnimplemented(PLAYERHOOK_ON_BEFORE_UPDATE); }
+    virtual void OnAfterUpdate(Player* /*player*/, uint32 /*diff*/) { SetHookUnimplemented(PLAYERHOOK_ON_AFTER_UPDATE); }
 };
 
 class PlayerbotScript : public ScriptObject
@@ -1286,6 +1339,26 @@ public: /* PlayerbotScript */
     void OnPlayerbotLogout(Player* player);
     void OnPlayerbotLogoutBots();
 
+public: /* Hook dispatch */
+
+    // Drops scripts from the dispatch lists of hooks they do not implement, must not run while maps are updated.
+    void RebuildHookLists();
+    void MarkHookListsDirty() { _hookListsDirty = true; }
+
+    struct HookReport
+    {
+        char const* ScriptType;
+        char const* Hook;
+        uint32 Scripts;
+        uint64 Calls;
+        uint64 TotalNs;
+    };
+
+    void SetHookProfiling(bool enable) { _hookProfiling = enable; }
+    bool IsHookProfiling() const { return _hookProfiling.load(std::memory_order_relaxed); }
+    void ResetHookStats();
+    std::vector<HookReport> GetHookReport() const;
+
 public:
     static bool CanHavePetAI(Creature* creature);
 
@@ -1293,6 +1366,9 @@ private:
 
     uint32 _scriptCount;
 
+    std::atomic<bool> _hookListsDirty;
+    std::atomic<bool> _hookProfiling;
+
     //atomic op counter for active scripts amount
     std::atomic_long _scheduledScripts;
 };
@@ -1422,6 +1498,12 @@ namespace
 }
 
 // This is the global static registry of scripts.
+struct ScriptHookStats
+{
+    std::atomic<uint64> Calls{ 0 };
+    std::atomic<uint64> TotalNs{ 0 };
+};
+
 template<class TScript>
 class ScriptRegistry
 {
@@ -1434,6 +1516,22 @@ public:
     // after server startup.
     static ScriptMap ScriptPointerList;
 
+    // Per hook, the scripts that implement it, in ScriptPointerList order.
+    static std::array<std::vector<TScript*>, MAX_HOOKS_PER_SCRIPT_TYPE> EnabledHooks;
+    static std::array<ScriptHookStats, MAX_HOOKS_PER_SCRIPT_TYPE> HookStats;
+
+    template<typename Hook>
+    static void RebuildEnabledHooks(Hook hookCount)
+    {
+        for (uint8 hook = 0; hook < hookCount; ++hook)
+        {
+            EnabledHooks[hook].clear();
+            for (auto const& [id, script] : ScriptPointerList)
+                if (script->IsHookImplemented(Hook(hook)))
+                    EnabledHooks[hook].push_back(script);
+        }
+    }
+
     static ScriptRegistry* Instance()
     {
         static ScriptRegistry instance;
@@ -1444,6 +1542,9 @@ public:
     {
         ASSERT(script);
 
+        // scripts added after ScriptMgr::Initialize, like the Eluna world script, join the hook lists on the next world update
+        sScriptMgr->MarkHookListsDirty();
+
         // See if the script is using the same memory as another script. If this happens, it means that
         // someone forgot to allocate new memory for a script.
         for (ScriptMapIterator it = ScriptPointerList.begin(); it != ScriptPointerList.end(); ++it)
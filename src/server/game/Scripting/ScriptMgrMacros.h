@@ -20,6 +20,7 @@
 
 #include "ScriptMgr.h"
 
+#include <chrono>
 #include <optional>
 
 template<typename T>
@@ -74,9 +75,39 @@ inline bool ReturnValidBool(Optional<bool> ret, bool need = false)
     return ret && *ret ? need : !need;
 }
 
+// times one dispatch of a hook while hook profiling is enabled
+class ScriptHookTimer
+{
+public:
+    explicit ScriptHookTimer(ScriptHookStats& stats) : _stats(sScriptMgr->IsHookProfiling() ? &stats : nullptr)
+    {
+        if (_stats)
+            _start = std::chrono::steady_clock::now();
+    }
+
+    ~ScriptHookTimer()
+    {
+        if (!_stats)
+            return;
+
+        _stats->Calls.fetch_add(1, std::memory_order_relaxed);
+        _stats->TotalNs.fetch_add(uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start).count()), std::memory_order_relaxed);
+    }
+
+    ScriptHookTimer(ScriptHookTimer const&) = delete;
+    ScriptHookTimer& operator=(ScriptHookTimer const&) = delete;
+
+private:
+    ScriptHookStats* _stats;
+    std::chrono::steady_clock::time_point _start;
+};
+
 #define CALL_ENABLED_HOOKS(scriptType, hookType, action) \
     if (!ScriptRegistry<scriptType>::EnabledHooks[hookType].empty()) \
-        for (auto const& script : ScriptRegistry<scriptType>::EnabledHooks[hookType]) { action; }
+    { \
+        ScriptHookTimer hookTimer(ScriptRegistry<scriptType>::HookStats[hookType]); \
+        for (auto const& script : ScriptRegistry<scriptType>::EnabledHooks[hookType]) { action; } \
+    }
 
 #define CALL_ENABLED_BOOLEAN_HOOKS(scriptType, hookType, action) \
     if (ScriptRegistry<scriptType>::EnabledHooks[hookType].empty()) \
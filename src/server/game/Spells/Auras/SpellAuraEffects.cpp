@@ -549,6 +549,7 @@ void AuraEffect::SetAmount(int32 amount)
         m_amount = amount;
         GetBase()->SetNeedClientUpdateForTargets();
         m_floatAmount = amount;
+        InvalidateTargetModifierCache();
     }
     m_canBeRecalculated = false;
 }
@@ -558,9 +559,16 @@ void AuraEffect::SetFloatAmount(float amount)
     m_floatAmount = amount;
     m_amount = int32(amount);
     GetBase()->SetNeedClientUpdateForTargets();
+    InvalidateTargetModifierCache();
     m_canBeRecalculated = false;
 }
 
+void AuraEffect::InvalidateTargetModifierCache()
+{
+    for (auto&& itr : GetBase()->GetApplicationMap())
+        itr.second->GetTarget()->InvalidateAuraModifierCache(GetAuraType());
+}
+
 static float GetMixologyBonus(uint32 id, uint32 effect)
 {
     if (effect >= EFFECT_3)
@@ -1040,6 +1048,7 @@ void AuraEffect::ChangeAmount(float newAmount, bool mark, bool onStackOrReapply)
         {
             m_amount = int32(newAmount);
             m_floatAmount = newAmount;
+            InvalidateTargetModifierCache();
         }
         else
             SetFloatAmount(newAmount);
@@ -64,6 +64,7 @@ class AuraEffect
         float GetFloatAmount() const { return m_floatAmount; }
         void SetAmount(int32 amount);
         void SetFloatAmount(float amount);
+        void InvalidateTargetModifierCache();
 
         template <class T>
         T GetUserData() const { return m_userData.Get<T>(); }
@@ -56,6 +56,7 @@
 #include "Battlefield.h"
 #include "BattlefieldMgr.h"
 #include "SpellHistory.h"
+#include "SpellProfiler.h"
 #include "LootLockoutMap.h"
 #include "BattlePetMgr.h"
 #include "TradeData.h"
@@ -561,6 +562,7 @@ m_spellValue(new SpellValue(m_spellInfo)), m_researchData(NULL)
 {
     m_customError = SPELL_CUSTOM_ERROR_NONE;
     m_skipCheck = skipCheck;
+    m_profiled = sSpellProfiler->ShouldProfileCast();
     m_selfContainer = NULL;
     m_referencedFromCurrentSpell = false;
     m_executedCurrently = false;
@@ -791,6 +793,8 @@ void Spell::SelectExplicitTargets()
 
 void Spell::SelectSpellTargets()
 {
+    SpellProfileScope profileScope(GetProfiledSpellId(), SPELL_PROFILE_SELECT_TARGETS);
+
     // select targets for cast phase
     SelectExplicitTargets();
 
@@ -2179,48 +2183,91 @@ void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTar
         }
     }
 
+    // nothing moves while the targets of one cast are selected, so the candidates are read once into flat arrays
+    // and each jump runs a plain distance pass over them instead of walking the list through IsWithinDist
+    std::vector<WorldObject*> chainObjects(tempTargets.begin(), tempTargets.end());
+    std::size_t const count = chainObjects.size();
+    std::vector<float> posX(count), posY(count), posZ(count), objectSize(count), distSq(count);
+    std::vector<uint8> taken(count, 0);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        posX[i] = chainObjects[i]->GetPositionX();
+        posY[i] = chainObjects[i]->GetPositionY();
+        posZ[i] = chainObjects[i]->GetPositionZ();
+        objectSize[i] = chainObjects[i]->GetObjectSize();
+    }
+
+    // candidates for one jump, best first; line of sight is checked in this order until a visible one is found
+    std::vector<std::pair<double, std::size_t>> candidates;
+    candidates.reserve(count);
+
     while (chainTargets)
     {
-        // try to get unit for next chain jump
-        std::list<WorldObject*>::iterator foundItr = tempTargets.end();
+        float const targetX = target->GetPositionX();
+        float const targetY = target->GetPositionY();
+        float const targetZ = target->GetPositionZ();
+        float const targetSize = target->GetObjectSize();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float const dx = targetX - posX[i];
+            float const dy = targetY - posY[i];
+            float const dz = targetZ - posZ[i];
+            distSq[i] = dx * dx + dy * dy + dz * dz;
+        }
+
+        // gameobjects have their own size rules and units on a shared transport compare transport offsets, let IsWithinDist handle those
+        bool const exactJumpCheck = target->GetTypeId() == TYPEID_GAMEOBJECT || target->GetTransport();
+        auto isInJumpRange = [&](std::size_t i) -> bool
+        {
+            if (exactJumpCheck)
+                return target->IsWithinDist(chainObjects[i], jumpRadius);
+
+            float const maxDist = jumpRadius + (targetSize + objectSize[i]);
+            return distSq[i] < maxDist * maxDist;
+        };
+
+        candidates.clear();
         // get unit with highest hp deficit in dist
         if (isChainHeal)
         {
-            uint32 maxHPDeficit = 0;
-            for (std::list<WorldObject*>::iterator itr = tempTargets.begin(); itr != tempTargets.end(); ++itr)
-            {
-                if (Unit* unitTarget = (*itr)->ToUnit())
-                {
-                    uint32 deficit = unitTarget->GetMaxHealth() - unitTarget->GetHealth();
-                    if ((deficit > maxHPDeficit || foundItr == tempTargets.end()) && target->IsWithinDist(unitTarget, jumpRadius) && target->IsWithinLOSInMap(unitTarget))
-                    {
-                        foundItr = itr;
-                        maxHPDeficit = deficit;
-                    }
-                }
-            }
+            for (std::size_t i = 0; i < count; ++i)
+                if (!taken[i])
+                    if (Unit* unitTarget = chainObjects[i]->ToUnit())
+                        if (isInJumpRange(i))
+                            candidates.emplace_back(-double(unitTarget->GetMaxHealth() - unitTarget->GetHealth()), i);
         }
         // get closest object
         else
         {
-            for (std::list<WorldObject*>::iterator itr = tempTargets.begin(); itr != tempTargets.end(); ++itr)
+            for (std::size_t i = 0; i < count; ++i)
+                if (!taken[i] && (!isBouncingFar || isInJumpRange(i)))
+                    candidates.emplace_back(distSq[i], i);
+        }
+
+        // stable, the first one in the list wins a tie
+        std::stable_sort(candidates.begin(), candidates.end(), [](std::pair<double, std::size_t> const& left, std::pair<double, std::size_t> const& right)
+        {
+            return left.first < right.first;
+        });
+
+        // try to get unit for next chain jump
+        WorldObject* found = nullptr;
+        for (auto&& candidate : candidates)
+        {
+            if (target->IsWithinLOSInMap(chainObjects[candidate.second]))
             {
-                if (foundItr == tempTargets.end())
-                {
-                    if ((!isBouncingFar || target->IsWithinDist(*itr, jumpRadius)) && target->IsWithinLOSInMap(*itr))
-                        foundItr = itr;
-                }
-                else if (target->GetDistanceOrder(*itr, *foundItr) && target->IsWithinLOSInMap(*itr))
-                    foundItr = itr;
+                found = chainObjects[candidate.second];
+                taken[candidate.second] = 1;
+                break;
             }
         }
+
         // not found any valid target - chain ends
-        if (foundItr == tempTargets.end())
+        if (!found)
             break;
         if (!searchNearTarget)
-            target = *foundItr;
-        tempTargets.erase(foundItr);
-        targets.push_back(*foundItr);
+            target = found;
+        targets.push_back(found);
         --chainTargets;
     }
 }
@@ -2661,6 +2708,8 @@ void Spell::DoAllEffectOnTarget(TargetInfo* target)
     if (!target || target->processed)
         return;
 
+    SpellProfileScope profileScope(GetProfiledSpellId(), SPELL_PROFILE_EFFECT_ON_TARGET);
+
     target->processed = true;                               // Target checked in apply effects procedure
 
     // Get mask of effects for target
@@ -3412,6 +3461,8 @@ bool Spell::UpdateChanneledTargetList()
 
 void Spell::prepare(SpellCastTargets const* targets, AuraEffect const* triggeredByAura)
 {
+    SpellProfileScope profileScope(GetProfiledSpellId(), SPELL_PROFILE_PREPARE);
+
     if (m_CastItem)
         m_castItemGUID = m_CastItem->GetGUID();
     else
@@ -3685,6 +3736,8 @@ void Spell::cancel()
 
 void Spell::cast(bool skipCheck)
 {
+    SpellProfileScope profileScope(GetProfiledSpellId(), SPELL_PROFILE_CAST);
+
     // update pointers base at GUIDs to prevent access to non-existed already object
     UpdatePointers();
 
@@ -3915,6 +3968,8 @@ void Spell::cast(bool skipCheck)
 
 void Spell::handle_immediate()
 {
+    SpellProfileScope profileScope(GetProfiledSpellId(), SPELL_PROFILE_HANDLE_IMMEDIATE);
+
     Unit* target = GetExplTargetUnit();
     bool explicitTarget = target && m_originalCaster && (
         (m_UniqueTargetInfo.size() == 1 && target != m_caster && GetTargetInfo(target->GetGUID())) ||
@@ -4006,6 +4061,8 @@ void Spell::handle_immediate()
 
 uint64 Spell::handle_delayed(uint64 t_offset)
 {
+    SpellProfileScope profileScope(GetProfiledSpellId(), SPELL_PROFILE_HANDLE_DELAYED);
+
     UpdatePointers();
 
     if (m_caster->GetTypeId() == TYPEID_PLAYER)
@@ -6206,6 +6263,8 @@ void Spell::HandleThreatSpells()
 
 void Spell::HandleEffects(Unit* pUnitTarget, Item* pItemTarget, GameObject* pGOTarget, Corpse* corpse, uint32 i, SpellEffectHandleMode mode)
 {
+    SpellProfileScope profileScope(GetProfiledSpellId(), SPELL_PROFILE_EFFECT_HANDLER);
+
     effectHandleMode = mode;
     unitTarget = pUnitTarget;
     itemTarget = pItemTarget;
@@ -6238,6 +6297,8 @@ void Spell::HandleEffects(Unit* pUnitTarget, Item* pItemTarget, GameObject* pGOT
 
 SpellCastResult Spell::CheckCast(bool strict)
 {
+    SpellProfileScope profileScope(GetProfiledSpellId(), SPELL_PROFILE_CHECK_CAST);
+
     // check death state
     if (!m_caster->IsAlive() && !m_spellInfo->HasAttribute(SPELL_ATTR0_PASSIVE) && !m_spellInfo->HasAttribute(SPELL_ATTR0_CASTABLE_WHILE_DEAD) &&
         !(_triggeredCastFlags & TRIGGERED_IGNORE_CASTER_DEATH_STATE && !m_triggeredByAuraSpell))
@@ -9285,12 +9346,16 @@ namespace Trinity
 
 WorldObjectSpellTargetCheck::WorldObjectSpellTargetCheck(Unit* caster, Unit* referer, SpellInfo const* spellInfo,
     SpellTargetSelectionCategories category, SpellTargetCheckTypes selectionType, ConditionContainer* condList) : _caster(caster), _referer(referer), _spellInfo(spellInfo),
-    _targetSelectionType(selectionType), _condList(condList), _category(category)
+    _targetSelectionType(selectionType), _condList(condList), _category(category), _dispelCharm(false)
 {
     if (condList)
         _condSrcInfo = new ConditionSourceInfo(NULL, caster);
     else
         _condSrcInfo = NULL;
+
+    for (auto&& effect : spellInfo->Effects)
+        if (effect.Effect == SPELL_EFFECT_DISPEL_MECHANIC && effect.MiscValue == MECHANIC_CHARM)
+            _dispelCharm = true;
 }
 
 WorldObjectSpellTargetCheck::~WorldObjectSpellTargetCheck()
@@ -9353,14 +9418,9 @@ bool WorldObjectSpellTargetCheck::operator()(WorldObject* target)
                 if (unitTarget->IsTotem())
                     return false;
 
-                bool dispelCharm = false;
-                for (auto&& effect : _spellInfo->Effects)
-                    if (effect.Effect == SPELL_EFFECT_DISPEL_MECHANIC && effect.MiscValue == MECHANIC_CHARM)
-                        dispelCharm = true;
-
-                if (!dispelCharm && !_caster->_IsValidAssistTarget(unitTarget, _spellInfo) && target->GetTypeId() != TYPEID_CORPSE) // Mass Resurrection
+                if (!_dispelCharm && !_caster->_IsValidAssistTarget(unitTarget, _spellInfo) && target->GetTypeId() != TYPEID_CORPSE) // Mass Resurrection
                     return false;
-                if (!_referer->IsInRaidWith(unitTarget, dispelCharm))
+                if (!_referer->IsInRaidWith(unitTarget, _dispelCharm))
                     return false;
                 if (unitTarget->IsPetGuardianStuff() && (_spellInfo->AttributesEx7 & SPELL_ATTR7_CONSOLIDATED_RAID_BUFF || _spellInfo->AttributesEx9 & SPELL_ATTR9_NOT_USABLE_IN_ARENA))
                     return false;
@@ -9400,9 +9460,14 @@ WorldObjectSpellAreaTargetCheck::WorldObjectSpellAreaTargetCheck(float range, Po
     Unit* referer, SpellInfo const* spellInfo, SpellTargetSelectionCategories category, SpellTargetCheckTypes selectionType, ConditionContainer* condList)
     : WorldObjectSpellTargetCheck(caster, referer, spellInfo, category, selectionType, condList), _range(range), _position(position) { }
 
+bool WorldObjectSpellAreaTargetCheck::IsInRange(WorldObject* target) const
+{
+    return target->IsWithinDist3d(_position, _range) || (target->ToGameObject() && target->ToGameObject()->IsAtInteractDistance(*_position, _range));
+}
+
 bool WorldObjectSpellAreaTargetCheck::operator()(WorldObject* target)
 {
-    if (!target->IsWithinDist3d(_position, _range) && !(target->ToGameObject() && target->ToGameObject()->IsAtInteractDistance(*_position, _range)))
+    if (!IsInRange(target))
         return false;
     return WorldObjectSpellTargetCheck::operator ()(target);
 }
@@ -9413,6 +9478,10 @@ WorldObjectSpellConeTargetCheck::WorldObjectSpellConeTargetCheck(float coneAngle
 
 bool WorldObjectSpellConeTargetCheck::operator()(WorldObject* target)
 {
+    // most objects of the visited cells are out of range, test that before the angles
+    if (!IsInRange(target))
+        return false;
+
     float originalOrientation = _caster->GetOrientation();
     if (_coneOffset)
         _caster->SetOrientation(originalOrientation+_coneOffset);
@@ -9449,7 +9518,7 @@ bool WorldObjectSpellConeTargetCheck::operator()(WorldObject* target)
     }
     if (_coneOffset)
         _caster->SetOrientation(originalOrientation);
-    return WorldObjectSpellAreaTargetCheck::operator ()(target);
+    return WorldObjectSpellTargetCheck::operator ()(target);
 }
 
 WorldObjectSpellTrajTargetCheck::WorldObjectSpellTrajTargetCheck(float range, Position const* position, Unit* caster, SpellInfo const* spellInfo)
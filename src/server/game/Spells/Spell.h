@@ -511,6 +511,7 @@ class TC_GAME_API Spell
         Unit* GetCaster() const { return m_caster; }
         Unit* GetOriginalCaster() const { return m_originalCaster; }
         SpellInfo const* GetSpellInfo() const { return m_spellInfo; }
+        uint32 GetProfiledSpellId() const { return m_profiled ? m_spellInfo->Id : 0; }
         int32 GetPowerCost() const { return m_powerCost; }
         int32 GetPowerEntryIndex() const { return m_powerEntryIndex; }
         Powers GetPowerType() const { return m_powerType; }
@@ -780,6 +781,7 @@ class TC_GAME_API Spell
         SpellInfo const* m_triggeredByAuraSpell;
 
         bool m_skipCheck;
+        bool m_profiled;                                    // stages of this cast are timed by the spell profiler
         uint32 m_auraScaleMask;
         std::unique_ptr<PathGenerator> m_preGeneratedPath;
 
@@ -814,6 +816,7 @@ namespace Trinity
         SpellTargetCheckTypes _targetSelectionType;
         ConditionSourceInfo* _condSrcInfo;
         ConditionContainer* _condList;
+        bool _dispelCharm;      // raid checks also accept charmed raid members
 
         WorldObjectSpellTargetCheck(Unit* caster, Unit* referer, SpellInfo const* spellInfo,
             SpellTargetSelectionCategories category, SpellTargetCheckTypes selectionType, ConditionContainer* condList);
@@ -836,6 +839,7 @@ namespace Trinity
         Position const* _position;
         WorldObjectSpellAreaTargetCheck(float range, Position const* position, Unit* caster,
             Unit* referer, SpellInfo const* spellInfo, SpellTargetSelectionCategories category, SpellTargetCheckTypes selectionType, ConditionContainer* condList);
+        bool IsInRange(WorldObject* target) const;
         bool operator()(WorldObject* target);
     };
 
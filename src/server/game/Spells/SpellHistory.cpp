@@ -62,6 +62,10 @@ void SpellHistory::LoadFromDB(PreparedQueryResult&& result, PreparedQueryResult&
             if (entry.CategoryId)
                 _categoryCooldowns[entry.CategoryId] = entry;
 
+            TimeValue expiry = std::max(end, categoryEnd);
+            if (!_nextCooldownExpiry || expiry < _nextCooldownExpiry)
+                _nextCooldownExpiry = expiry;
+
         } while (result->NextRow());
     }
 
@@ -100,7 +104,7 @@ void SpellHistory::SaveToDB<Player>(CharacterDatabaseTransaction trans)
     {
         auto& entry = it->second;
         if (entry.CooldownEnd <= now && entry.CategoryEnd <= now)
-            _cooldowns.erase(it++);
+            it = _cooldowns.erase(it);
         else
         {
             if (!entry.OnHold)
@@ -153,7 +157,7 @@ void SpellHistory::SaveToDB<Pet>(CharacterDatabaseTransaction trans)
     {
         auto& entry = itr->second;
         if (entry.CooldownEnd <= now && entry.CategoryEnd <= now)
-            _cooldowns.erase(itr++);
+            itr = _cooldowns.erase(itr);
         else
         {
             if (!entry.OnHold)
@@ -288,7 +292,7 @@ void SpellHistory::StartCooldown(SpellInfo const* spellInfo, uint32 itemId, Spel
         {
             //if (category->MaxCharges || _owner->HasAuraTypeWithMiscvalue(SPELL_AURA_MOD_CHARGES, category->Id))
             {
-                auto res = _spellCharges.insert({ category->Id, ChargeData() });
+                auto res = _spellCharges.try_emplace(category->Id);
                 auto& chargeData = res.first->second;
                 ++chargeData.ConsumedCharges;
                 if (res.second)
@@ -404,6 +408,9 @@ void SpellHistory::AddCooldown(uint32 spellId, uint32 itemId, int64 cooldown, ui
 {
     auto now = TimeValue::Now();
 
+    if (_nextCooldownExpiry && _nextCooldownExpiry <= now)
+        PruneExpiredCooldowns(now);
+
     auto& entry = _cooldowns[spellId];
     entry.SpellId = spellId;
     entry.OnHold = false;
@@ -416,34 +423,64 @@ void SpellHistory::AddCooldown(uint32 spellId, uint32 itemId, int64 cooldown, ui
         entry.CategoryEnd = now + Milliseconds(categoryCooldown);
         _categoryCooldowns[categroy] = entry;
     }
+
+    TimeValue expiry = std::max(entry.CooldownEnd, entry.CategoryEnd);
+    if (!_nextCooldownExpiry || expiry < _nextCooldownExpiry)
+        _nextCooldownExpiry = expiry;
+}
+
+void SpellHistory::PruneExpiredCooldowns(TimeValue const& now)
+{
+    auto expired = [&now](CooldownStorage::value_type const& itr)
+    {
+        return !itr.second.OnHold && itr.second.CooldownEnd <= now && itr.second.CategoryEnd <= now;
+    };
+
+    _cooldowns.erase_if(expired);
+    _categoryCooldowns.erase_if(expired);
+
+    _nextCooldownExpiry = TimeValue::zero();
+    for (auto&& itr : _cooldowns)
+    {
+        if (itr.second.OnHold)
+            continue;
+
+        TimeValue expiry = std::max(itr.second.CooldownEnd, itr.second.CategoryEnd);
+        if (!_nextCooldownExpiry || expiry < _nextCooldownExpiry)
+            _nextCooldownExpiry = expiry;
+    }
 }
 
 void SpellHistory::RemoveCooldown(uint32 spellId, bool send)
 {
-    if (auto const* spellInfo = sSpellMgr->GetSpellInfo(spellId))
+    if (ClearCooldown(spellId) && send)
+        GetPlayer()->SendClearCooldown(spellId, _owner);
+}
+
+// returns true when the client has to be told the cooldown is gone
+bool SpellHistory::ClearCooldown(uint32 spellId)
+{
+    auto const* spellInfo = sSpellMgr->GetSpellInfo(spellId);
+    if (!spellInfo)
+        return false;
+
+    uint32 category = spellInfo->GetCategory();
+    auto itr = _cooldowns.find(spellId);
+    if (itr != _cooldowns.end())
     {
-        uint32 category = spellInfo->GetCategory();
+        if (itr->second.ProhibitionEnd)
         {
-            auto itr = _cooldowns.find(spellId);
-            if (itr != _cooldowns.end())
-            {
-                if (itr->second.ProhibitionEnd)
-                {
-                    if (itr->second.ProhibitionEnd < itr->second.CooldownEnd)
-                        ModifyCooldown(spellId, -(itr->second.CooldownEnd - itr->second.ProhibitionEnd).ToMilliseconds());
-                    return;
-                }
-
-                auto cooldown = GetCooldownInfo(spellInfo, itr->second.ItemId);
-                category = cooldown.Category;
-                _cooldowns.erase(itr);
-            }
+            if (itr->second.ProhibitionEnd < itr->second.CooldownEnd)
+                ModifyCooldown(spellId, -(itr->second.CooldownEnd - itr->second.ProhibitionEnd).ToMilliseconds());
+            return false;
         }
-        _categoryCooldowns.erase(category);
 
-        if (send)
-            GetPlayer()->SendClearCooldown(spellId, _owner);
+        auto cooldown = GetCooldownInfo(spellInfo, itr->second.ItemId);
+        category = cooldown.Category;
+        _cooldowns.erase(itr);
     }
+    _categoryCooldowns.erase(category);
+    return true;
 }
 
 void SpellHistory::RemoveArenaSpellCooldowns(bool removeActivePetCooldowns)
@@ -451,31 +488,22 @@ void SpellHistory::RemoveArenaSpellCooldowns(bool removeActivePetCooldowns)
     ASSERT(_owner->GetTypeId() == TYPEID_PLAYER);
 
     // remove cooldowns on spells that have <= 10 min CD
-    auto it = _cooldowns.begin();
-    auto next = it;
-    for (; it != _cooldowns.end(); it = next)
+    RemoveCooldowns([](CooldownEntry const& cooldown)
     {
-        next = it;
-        ++next;
-
         // skip items cooldownd
-        auto item = sObjectMgr->GetItemTemplate(it->second.ItemId);
+        auto item = sObjectMgr->GetItemTemplate(cooldown.ItemId);
         if (item && item->InventoryType != INVTYPE_TRINKET)
-            continue;
+            return false;
 
-        SpellInfo const* entry = sSpellMgr->GetSpellInfo(it->first);
+        SpellInfo const* entry = sSpellMgr->GetSpellInfo(cooldown.SpellId);
         // check if spellentry is present and if the cooldown is less or equal to 10 min
-        if (entry &&
-            entry->RecoveryTime <= 10 * MINUTE * IN_MILLISECONDS &&
-            entry->CategoryRecoveryTime <= 10 * MINUTE * IN_MILLISECONDS)
-        {
-            if (entry->CategoryEntry && entry->CategoryEntry->Flags & SPELL_CATEGORY_FLAG_COOLDOWN_EXPIRES_AT_MIDNIGHT)
-                continue;
+        if (!entry ||
+            entry->RecoveryTime > 10 * MINUTE * IN_MILLISECONDS ||
+            entry->CategoryRecoveryTime > 10 * MINUTE * IN_MILLISECONDS)
+            return false;
 
-            // remove & notify
-            RemoveCooldown(it->first, true);
-        }
-    }
+        return !(entry->CategoryEntry && entry->CategoryEntry->Flags & SPELL_CATEGORY_FLAG_COOLDOWN_EXPIRES_AT_MIDNIGHT);
+    });
 
     for (auto it = _spellCharges.begin(); it != _spellCharges.end();)
     {
@@ -483,7 +511,7 @@ void SpellHistory::RemoveArenaSpellCooldowns(bool removeActivePetCooldowns)
         if (it->second.BaseRegenTime < Minutes(10))
         {
             ClearChargesForSpell(it->first);
-            _spellCharges.erase(it++);
+            it = _spellCharges.erase(it);
         }
         else
             ++it;
@@ -544,6 +572,7 @@ void SpellHistory::RemoveAllCooldowns()
 
     _cooldowns.clear();
     _categoryCooldowns.clear();
+    _nextCooldownExpiry = TimeValue::zero();
 }
 
 void SpellHistory::ModifyCooldown(uint32 spellId, int32 cooldown)
@@ -724,46 +753,22 @@ TimeValue SpellHistory::GetChargeCooldown(uint32 spellId)
 
 void SpellHistory::RppmProcAttempt(uint32 spellId, WeaponAttackType attackType)
 {
-    auto bound = _procHistory.equal_range(spellId);
-    for (auto itr = bound.first; itr != bound.second; ++itr)
-    {
-        if (itr->second.AttackTyep == attackType)
-        {
-            itr->second.LastAttempt = TimeValue::Now();
-            return;
-        }
-    }
-    RppmProcEntry entry;
+    RppmProcEntry& entry = _procHistory[{ spellId, attackType }];
     entry.LastAttempt = TimeValue::Now();
     entry.AttackTyep = attackType;
-    _procHistory.emplace(spellId, entry);
 }
 
 void SpellHistory::RppmPorcSuccess(uint32 spellId, WeaponAttackType attackType)
 {
-    auto bound = _procHistory.equal_range(spellId);
-    for (auto itr = bound.first; itr != bound.second; ++itr)
-    {
-        if (itr->second.AttackTyep == attackType)
-        {
-            itr->second.LastSuccess = TimeValue::Now();
-            return;
-        }
-    }
-    RppmProcEntry entry;
+    RppmProcEntry& entry = _procHistory[{ spellId, attackType }];
     entry.LastSuccess = TimeValue::Now();
     entry.AttackTyep = attackType;
-    _procHistory.emplace(spellId, entry);
 }
 
 SpellHistory::RppmProcEntry const* SpellHistory::GetRppmProcEntry(uint32 spellId, WeaponAttackType attackType)
 {
-    auto bound = _procHistory.equal_range(spellId);
-    for (auto itr = bound.first; itr != bound.second; ++itr)
-        if (itr->second.AttackTyep == attackType)
-            return &itr->second;
-
-    return nullptr;
+    auto itr = _procHistory.find({ spellId, attackType });
+    return itr != _procHistory.end() ? &itr->second : nullptr;
 }
 
 void SpellHistory::UpdateCharges()
@@ -787,7 +792,7 @@ void SpellHistory::UpdateCharges()
         if (erase)
         {
             ClearChargesForSpell(it->first);
-            _spellCharges.erase(it++);
+            it = _spellCharges.erase(it);
         }
         else
             ++it;
@@ -18,6 +18,7 @@
 #ifndef SPELL_HISTORY_H
 #define SPELL_HISTORY_H
 
+#include "FlatMap.h"
 #include "QueryResult.h"
 #include "Transaction.h"
 #include "TimeValue.h"
@@ -59,6 +60,9 @@ public:
         WeaponAttackType AttackTyep = BASE_ATTACK;
     };
 
+    // a unit rarely has more than a few dozen entries, sorted vectors beat hashing for lookups from every cast check
+    typedef Trinity::Containers::FlatMap<uint32, CooldownEntry> CooldownStorage;
+
 public:
     SpellHistory(Unit* owner);
 
@@ -114,7 +118,7 @@ public:
 
     Player* GetPlayer() const;
 
-    std::unordered_map<uint32, CooldownEntry> const& GetCooldowns() const { return _cooldowns; }
+    CooldownStorage const& GetCooldowns() const { return _cooldowns; }
 
     void ClearAllSpellCharges();
     void ClearChargesForSpell(uint32 spell);
@@ -123,30 +127,37 @@ private:
     bool HasCooldown(SpellInfo const* spellInfo) const;
     bool HasCharge(uint32 categoryId) const;
     bool HasCategoryCooldown(uint32 categoryId) const;
+    bool ClearCooldown(uint32 spellId);
+    void PruneExpiredCooldowns(TimeValue const& now);
     void SendClearCooldowns(std::vector<uint32> const& cooldowns);
     void SendSpellCharges() const;
     CooldownInfo GetCooldownInfo(SpellInfo const* spellInfo, uint32 itemId) const;
 
 private:
     Unit* _owner;
-    std::unordered_map<uint32, CooldownEntry> _cooldowns;
-    std::unordered_map<uint32, CooldownEntry> _categoryCooldowns;
-    std::unordered_map<uint32, ChargeData> _spellCharges;
-    std::unordered_map<uint32, TimeValue> _procCooldowns;
-    std::multimap<uint32, RppmProcEntry> _procHistory;
+    CooldownStorage _cooldowns;
+    CooldownStorage _categoryCooldowns;
+    Trinity::Containers::FlatMap<uint32, ChargeData> _spellCharges;
+    Trinity::Containers::FlatMap<uint32, TimeValue> _procCooldowns;
+    Trinity::Containers::FlatMap<std::pair<uint32, WeaponAttackType>, RppmProcEntry> _procHistory;
+    TimeValue _nextCooldownExpiry;      // earliest end of the stored cooldowns, expired entries are dropped once it passed
 };
 
 template <typename Pred>
 inline void SpellHistory::RemoveCooldowns(Pred pred)
 {
+    std::vector<uint32> toRemove;
+    for (auto&& itr : _cooldowns)
+        if (pred(itr.second))
+            toRemove.push_back(itr.first);
+
     std::vector<uint32> toClear;
-    for (auto it = _cooldowns.begin(); it != _cooldowns.end();)
-    {
-        auto& entry = it->second;
-        ++it;
-        if (pred(entry))
-            RemoveCooldown(entry.SpellId, true);
-    }
+    for (uint32 spellId : toRemove)
+        if (ClearCooldown(spellId))
+            toClear.push_back(spellId);
+
+    if (!toClear.empty())
+        SendClearCooldowns(toClear);
 }
 
 #endif // !SPELL_HISTORY_H
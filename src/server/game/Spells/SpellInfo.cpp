@@ -2182,7 +2182,7 @@ SpellSchoolMask SpellInfo::GetSchoolMask() const
     return SpellSchoolMask(SchoolMask);
 }
 
-uint32 SpellInfo::GetAllEffectsMechanicMask() const
+void SpellInfo::_LoadAllEffectsMechanicMask()
 {
     uint32 mask = 0;
     if (Mechanic)
@@ -2190,7 +2190,7 @@ uint32 SpellInfo::GetAllEffectsMechanicMask() const
     for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         if (Effects[i].IsEffect() && Effects[i].Mechanic)
             mask |= 1 << Effects[i].Mechanic;
-    return mask;
+    _allEffectsMechanicMask = mask;
 }
 
 uint32 SpellInfo::GetEffectMechanicMask(uint8 effIndex) const
@@ -2250,227 +2250,233 @@ uint32 SpellInfo::GetExplicitTargetMask() const
     return ExplicitTargetMask;
 }
 
-AuraStateType SpellInfo::GetAuraState() const
+void SpellInfo::_LoadAuraState()
 {
-    // Seals
-    if (GetSpellSpecific() == SPELL_SPECIFIC_SEAL)
-        return AURA_STATE_JUDGEMENT;
+    _auraState = [this]() -> AuraStateType
+    {
+        // Seals
+        if (GetSpellSpecific() == SPELL_SPECIFIC_SEAL)
+            return AURA_STATE_JUDGEMENT;
 
-    // Faerie Fire & Faerie Swarm
-    if (SpellFamilyName == SPELLFAMILY_DRUID && SpellFamilyFlags[0] & 0x500)
-        return AURA_STATE_FAERIE_FIRE;
+        // Faerie Fire & Faerie Swarm
+        if (SpellFamilyName == SPELLFAMILY_DRUID && SpellFamilyFlags[0] & 0x500)
+            return AURA_STATE_FAERIE_FIRE;
 
-    // Sting (hunter's pet ability)
-    if (GetCategory() == 1133)
-        return AURA_STATE_FAERIE_FIRE;
+        // Sting (hunter's pet ability)
+        if (GetCategory() == 1133)
+            return AURA_STATE_FAERIE_FIRE;
 
-    // In the Rumpus (q29637)
-    if (Id == 102953)
-        return AURA_STATE_FAERIE_FIRE;
+        // In the Rumpus (q29637)
+        if (Id == 102953)
+            return AURA_STATE_FAERIE_FIRE;
 
-    // Primordius and Siegecrafter Blackfuse
-    if (Id == 140544 || Id == 143387)
-        return AURA_STATE_DAMAGE_TAKEN_14;
+        // Primordius and Siegecrafter Blackfuse
+        if (Id == 140544 || Id == 143387)
+            return AURA_STATE_DAMAGE_TAKEN_14;
 
-    // Victorious
-    if (SpellFamilyName == SPELLFAMILY_WARRIOR && SpellFamilyFlags[1] & 0x00040000 || Id == 138279)
-        return AURA_STATE_WARRIOR_VICTORY_RUSH;
+        // Victorious
+        if (SpellFamilyName == SPELLFAMILY_WARRIOR && SpellFamilyFlags[1] & 0x00040000 || Id == 138279)
+            return AURA_STATE_WARRIOR_VICTORY_RUSH;
 
-    // Swiftmend state on Regrowth & Rejuvenation
-    if (SpellFamilyName == SPELLFAMILY_DRUID && SpellFamilyFlags[0] & 0x50)
-        return AURA_STATE_SWIFTMEND;
+        // Swiftmend state on Regrowth & Rejuvenation
+        if (SpellFamilyName == SPELLFAMILY_DRUID && SpellFamilyFlags[0] & 0x50)
+            return AURA_STATE_SWIFTMEND;
 
-    // Deadly poison aura state
-    if (SpellFamilyName == SPELLFAMILY_ROGUE && SpellFamilyFlags[0] & 0x10000)
-        return AURA_STATE_DEADLY_POISON;
+        // Deadly poison aura state
+        if (SpellFamilyName == SPELLFAMILY_ROGUE && SpellFamilyFlags[0] & 0x10000)
+            return AURA_STATE_DEADLY_POISON;
 
-    // Enrage aura state
-    if (Dispel == DISPEL_ENRAGE)
-        return AURA_STATE_ENRAGE;
+        // Enrage aura state
+        if (Dispel == DISPEL_ENRAGE)
+            return AURA_STATE_ENRAGE;
 
-    // Bleeding aura state
-    if (GetAllEffectsMechanicMask() & 1<<MECHANIC_BLEED)
-        return AURA_STATE_BLEEDING;
+        // Bleeding aura state
+        if (GetAllEffectsMechanicMask() & 1<<MECHANIC_BLEED)
+            return AURA_STATE_BLEEDING;
 
-    if (GetSchoolMask() & SPELL_SCHOOL_MASK_FROST)
-        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-            if (Effects[i].IsAura() && (Effects[i].ApplyAuraName == SPELL_AURA_MOD_STUN
-                || Effects[i].ApplyAuraName == SPELL_AURA_MOD_ROOT))
-                return AURA_STATE_FROZEN;
+        if (GetSchoolMask() & SPELL_SCHOOL_MASK_FROST)
+            for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+                if (Effects[i].IsAura() && (Effects[i].ApplyAuraName == SPELL_AURA_MOD_STUN
+                    || Effects[i].ApplyAuraName == SPELL_AURA_MOD_ROOT))
+                    return AURA_STATE_FROZEN;
 
-    switch (Id)
-    {
-        case 71465: // Divine Surge
-        case 50241: // Evasive Charges
-        case 120289: // Dread Expanse
-        case 143458: // Sha Slime
-        case 145118: // Amalgam
-        case 141623: // Blindside
-            return AURA_STATE_UNKNOWN22;
-        case 122757: // Weak Points
-        case 123424: // Weak Points
-        case 123425: // Weak Points
-        case 123427: // Weak Points
-            if (SpellInfo const* tirggering = sSpellMgr->GetSpellInfo(Effects[EFFECT_0].TriggerSpell))
-                return AuraStateType(tirggering->Effects[EFFECT_0].MiscValue);
-            break;
-        case 132951: // Flare
-            return AURA_STATE_FAERIE_FIRE;
-        default:
-            break;
-    }
+        switch (Id)
+        {
+            case 71465: // Divine Surge
+            case 50241: // Evasive Charges
+            case 120289: // Dread Expanse
+            case 143458: // Sha Slime
+            case 145118: // Amalgam
+            case 141623: // Blindside
+                return AURA_STATE_UNKNOWN22;
+            case 122757: // Weak Points
+            case 123424: // Weak Points
+            case 123425: // Weak Points
+            case 123427: // Weak Points
+                if (SpellInfo const* tirggering = sSpellMgr->GetSpellInfo(Effects[EFFECT_0].TriggerSpell))
+                    return AuraStateType(tirggering->Effects[EFFECT_0].MiscValue);
+                break;
+            case 132951: // Flare
+                return AURA_STATE_FAERIE_FIRE;
+            default:
+                break;
+        }
 
-    return AURA_STATE_NONE;
+        return AURA_STATE_NONE;
+    }();
 }
 
-SpellSpecificType SpellInfo::GetSpellSpecific() const
+void SpellInfo::_LoadSpellSpecific()
 {
-    switch (SpellFamilyName)
+    _spellSpecific = [this]() -> SpellSpecificType
     {
-        case SPELLFAMILY_GENERIC:
+        switch (SpellFamilyName)
         {
-            // Food / Drinks (mostly)
-            if (HasAuraInterruptFlag(AURA_INTERRUPT_FLAG_NOT_SEATED))
+            case SPELLFAMILY_GENERIC:
             {
-                bool food = false;
-                bool drink = false;
-                for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+                // Food / Drinks (mostly)
+                if (HasAuraInterruptFlag(AURA_INTERRUPT_FLAG_NOT_SEATED))
                 {
-                    if (!Effects[i].IsAura())
-                        continue;
-                    switch (Effects[i].ApplyAuraName)
+                    bool food = false;
+                    bool drink = false;
+                    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
                     {
-                        // Food
-                        case SPELL_AURA_MOD_REGEN:
-                        case SPELL_AURA_OBS_MOD_HEALTH:
-                            food = true;
-                            break;
-                        // Drink
-                        case SPELL_AURA_MOD_POWER_REGEN:
-                        case SPELL_AURA_OBS_MOD_POWER:
-                            drink = true;
-                            break;
-                        default:
-                            break;
+                        if (!Effects[i].IsAura())
+                            continue;
+                        switch (Effects[i].ApplyAuraName)
+                        {
+                            // Food
+                            case SPELL_AURA_MOD_REGEN:
+                            case SPELL_AURA_OBS_MOD_HEALTH:
+                                food = true;
+                                break;
+                            // Drink
+                            case SPELL_AURA_MOD_POWER_REGEN:
+                            case SPELL_AURA_OBS_MOD_POWER:
+                                drink = true;
+                                break;
+                            default:
+                                break;
+                        }
                     }
-                }
 
-                if (food && drink)
-                    return SPELL_SPECIFIC_FOOD_AND_DRINK;
-                else if (food)
-                    return SPELL_SPECIFIC_FOOD;
-                else if (drink)
-                    return SPELL_SPECIFIC_DRINK;
-            }
-            // scrolls effects
-            else
-            {
-                SpellInfo const* firstRankSpellInfo = GetFirstRankSpell();
-                switch (firstRankSpellInfo->Id)
+                    if (food && drink)
+                        return SPELL_SPECIFIC_FOOD_AND_DRINK;
+                    else if (food)
+                        return SPELL_SPECIFIC_FOOD;
+                    else if (drink)
+                        return SPELL_SPECIFIC_DRINK;
+                }
+                // scrolls effects
+                else
                 {
-                    case 8118: // Strength
-                    case 8099: // Stamina
-                    case 8112: // Spirit
-                    case 8096: // Intellect
-                    case 8115: // Agility
-                    case 8091: // Armor
-                        return SPELL_SPECIFIC_SCROLL;
-                    case 12880: // Enrage (Enrage)
-                    case 57518: // Enrage (Wrecking Crew)
-                        return SPELL_SPECIFIC_WARRIOR_ENRAGE;
+                    SpellInfo const* firstRankSpellInfo = GetFirstRankSpell();
+                    switch (firstRankSpellInfo->Id)
+                    {
+                        case 8118: // Strength
+                        case 8099: // Stamina
+                        case 8112: // Spirit
+                        case 8096: // Intellect
+                        case 8115: // Agility
+                        case 8091: // Armor
+                            return SPELL_SPECIFIC_SCROLL;
+                        case 12880: // Enrage (Enrage)
+                        case 57518: // Enrage (Wrecking Crew)
+                            return SPELL_SPECIFIC_WARRIOR_ENRAGE;
+                    }
                 }
+                break;
             }
-            break;
-        }
-        case SPELLFAMILY_MAGE:
-        {
-            // family flags 18(Molten), 25(Frost/Ice), 28(Mage)
-            if (SpellFamilyFlags[0] & 0x12040000)
-                return SPELL_SPECIFIC_MAGE_ARMOR;
+            case SPELLFAMILY_MAGE:
+            {
+                // family flags 18(Molten), 25(Frost/Ice), 28(Mage)
+                if (SpellFamilyFlags[0] & 0x12040000)
+                    return SPELL_SPECIFIC_MAGE_ARMOR;
 
-            // Arcane brillance and Arcane intelect (normal check fails because of flags difference)
-            if (SpellFamilyFlags[0] & 0x400)
-                return SPELL_SPECIFIC_MAGE_ARCANE_BRILLANCE;
+                // Arcane brillance and Arcane intelect (normal check fails because of flags difference)
+                if (SpellFamilyFlags[0] & 0x400)
+                    return SPELL_SPECIFIC_MAGE_ARCANE_BRILLANCE;
 
-            if ((SpellFamilyFlags[0] & 0x1000000) && Effects[0].ApplyAuraName == SPELL_AURA_MOD_CONFUSE)
-                return SPELL_SPECIFIC_MAGE_POLYMORPH;
+                if ((SpellFamilyFlags[0] & 0x1000000) && Effects[0].ApplyAuraName == SPELL_AURA_MOD_CONFUSE)
+                    return SPELL_SPECIFIC_MAGE_POLYMORPH;
 
-            break;
-        }
-        case SPELLFAMILY_WARLOCK:
-        {
-            // Warlock (Bane of Doom | Bane of Agony | Bane of Havoc)
-            if (Id == 603 || Id ==  980 || Id == 80240)
-                return SPELL_SPECIFIC_BANE;
+                break;
+            }
+            case SPELLFAMILY_WARLOCK:
+            {
+                // Warlock (Bane of Doom | Bane of Agony | Bane of Havoc)
+                if (Id == 603 || Id ==  980 || Id == 80240)
+                    return SPELL_SPECIFIC_BANE;
 
-            // only warlock curses have this
-            if (Dispel == DISPEL_CURSE || Id == 116198 || Id == 116202)
-                return SPELL_SPECIFIC_CURSE;
-            break;
-        }
-        case SPELLFAMILY_PRIEST:
-        {
-            // Divine Spirit and Prayer of Spirit
-            if (SpellFamilyFlags[0] & 0x20)
-                return SPELL_SPECIFIC_PRIEST_DIVINE_SPIRIT;
+                // only warlock curses have this
+                if (Dispel == DISPEL_CURSE || Id == 116198 || Id == 116202)
+                    return SPELL_SPECIFIC_CURSE;
+                break;
+            }
+            case SPELLFAMILY_PRIEST:
+            {
+                // Divine Spirit and Prayer of Spirit
+                if (SpellFamilyFlags[0] & 0x20)
+                    return SPELL_SPECIFIC_PRIEST_DIVINE_SPIRIT;
 
-            if (SpellFamilyFlags[1] & 0x00001000)
-                return SPELL_SPECIFIC_CHAKRA;
+                if (SpellFamilyFlags[1] & 0x00001000)
+                    return SPELL_SPECIFIC_CHAKRA;
 
-            break;
-        }
-        case SPELLFAMILY_HUNTER:
-        {
-            // only hunter stings have this
-            if (Dispel == DISPEL_POISON)
-                return SPELL_SPECIFIC_STING;
+                break;
+            }
+            case SPELLFAMILY_HUNTER:
+            {
+                // only hunter stings have this
+                if (Dispel == DISPEL_POISON)
+                    return SPELL_SPECIFIC_STING;
 
-            // only hunter aspects have this (but not all aspects in hunter family)
-            if (SpellFamilyFlags.HasFlag(0x00300000, 0x00400000, 0x00000010))
-                return SPELL_SPECIFIC_ASPECT;
+                // only hunter aspects have this (but not all aspects in hunter family)
+                if (SpellFamilyFlags.HasFlag(0x00300000, 0x00400000, 0x00000010))
+                    return SPELL_SPECIFIC_ASPECT;
 
-            break;
-        }
-        case SPELLFAMILY_PALADIN:
-        {
-            // Seals: Truth, Righteousness, Justice, Insight, Command.
-            if (Id == 31801 ||  Id == 20154  || Id == 20164 || Id == 20165 || Id == 105361)
-                return SPELL_SPECIFIC_SEAL;
+                break;
+            }
+            case SPELLFAMILY_PALADIN:
+            {
+                // Seals: Truth, Righteousness, Justice, Insight, Command.
+                if (Id == 31801 ||  Id == 20154  || Id == 20164 || Id == 20165 || Id == 105361)
+                    return SPELL_SPECIFIC_SEAL;
 
-            if (SpellFamilyFlags[0] & 0x00002190)
-                return SPELL_SPECIFIC_HAND;
+                if (SpellFamilyFlags[0] & 0x00002190)
+                    return SPELL_SPECIFIC_HAND;
 
-            // Judgement of Wisdom, Judgement of Light, Judgement of Justice
-            if (Id == 20184 || Id == 20185 || Id == 20186)
-                return SPELL_SPECIFIC_JUDGEMENT;
+                // Judgement of Wisdom, Judgement of Light, Judgement of Justice
+                if (Id == 20184 || Id == 20185 || Id == 20186)
+                    return SPELL_SPECIFIC_JUDGEMENT;
 
-            // only paladin auras have this (for palaldin class family)
-            if (SpellFamilyFlags[2] & 0x00000020)
-                return SPELL_SPECIFIC_AURA;
+                // only paladin auras have this (for palaldin class family)
+                if (SpellFamilyFlags[2] & 0x00000020)
+                    return SPELL_SPECIFIC_AURA;
 
-            break;
+                break;
+            }
+            case SPELLFAMILY_DEATHKNIGHT:
+                if (Id == 48266 || Id == 48263 || Id == 48265)
+                    return SPELL_SPECIFIC_PRESENCE;
+                break;
         }
-        case SPELLFAMILY_DEATHKNIGHT:
-            if (Id == 48266 || Id == 48263 || Id == 48265)
-                return SPELL_SPECIFIC_PRESENCE;
-            break;
-    }
 
-    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-    {
-        if (Effects[i].Effect == SPELL_EFFECT_APPLY_AURA)
+        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
-            switch (Effects[i].ApplyAuraName)
+            if (Effects[i].Effect == SPELL_EFFECT_APPLY_AURA)
             {
-                case SPELL_AURA_MOD_CHARM:
-                case SPELL_AURA_MOD_POSSESS:
-                case SPELL_AURA_AOE_CHARM:
-                    return SPELL_SPECIFIC_CHARM;
+                switch (Effects[i].ApplyAuraName)
+                {
+                    case SPELL_AURA_MOD_CHARM:
+                    case SPELL_AURA_MOD_POSSESS:
+                    case SPELL_AURA_AOE_CHARM:
+                        return SPELL_SPECIFIC_CHARM;
+                }
             }
         }
-    }
 
-    return SPELL_SPECIFIC_NORMAL;
+        return SPELL_SPECIFIC_NORMAL;
+    }();
 }
 
 float SpellInfo::GetMinRange(bool positive) const
@@ -340,18 +340,9 @@ class SpellInfo
         SpellRangeEntry const* RangeEntry;
         float  Speed;
         uint32 StackAmount;
-        uint32 Totem[2];
-        int32  Reagent[MAX_SPELL_REAGENTS];
-        uint32 ReagentCount[MAX_SPELL_REAGENTS];
         int32  EquippedItemClass;
         int32  EquippedItemSubClassMask;
         int32  EquippedItemInventoryTypeMask;
-        uint32 TotemCategory[2];
-        uint32 SpellVisual[2];
-        uint32 SpellIconID;
-        uint32 ActiveIconID;
-        DbcStr SpellName;
-        DbcStr Rank;
         uint32 MaxTargetLevel;
         uint32 MaxAffectedTargets;
         uint32 SpellFamilyName;
@@ -360,6 +351,32 @@ class SpellInfo
         uint32 PreventionType;
         int32  AreaGroupId;
         uint32 SchoolMask;
+        // SpellScalingEntry
+        int32  CastTimeMin;
+        int32  CastTimeMax;
+        int32  CastTimeMaxLevel;
+        int32  ScalingClass;
+        float  CoefBase;
+        int32  CoefLevelBase;
+        SpellEffectInfo Effects[MAX_SPELL_EFFECTS];
+        uint32 ExplicitTargetMask;
+        SpellChainNode const* ChainEntry;
+
+        uint32 TalentId = 0;
+
+        uint32 NegativeEffectMask = 0;
+
+        // fields below are only read when loading, by packets or by a few scripts
+        // they are kept after the data used by cast checks so those stay in the first cache lines
+        uint32 Totem[2];
+        int32  Reagent[MAX_SPELL_REAGENTS];
+        uint32 ReagentCount[MAX_SPELL_REAGENTS];
+        uint32 TotemCategory[2];
+        uint32 SpellVisual[2];
+        uint32 SpellIconID;
+        uint32 ActiveIconID;
+        DbcStr SpellName;
+        DbcStr Rank;
         uint32 SpellDifficultyId;
         uint32 SpellScalingId;
         uint32 SpellAuraOptionsId;
@@ -376,26 +393,11 @@ class SpellInfo
         uint32 SpellTargetRestrictionsId;
         uint32 SpellTotemsId;
         uint32 ResearchProject;
-        // SpellScalingEntry
-        int32  CastTimeMin;
-        int32  CastTimeMax;
-        int32  CastTimeMaxLevel;
-        int32  ScalingClass;
-        float  CoefBase;
-        int32  CoefLevelBase;
-        SpellEffectInfo Effects[MAX_SPELL_EFFECTS];
-        uint32 ExplicitTargetMask;
-        SpellChainNode const* ChainEntry;
-        std::array<SpellEffectInfo, MAX_SPELL_EFFECTS> _effects;
 
         // SpecializationSpellsEntry
         std::list<uint32> SpecializationIdList;
         std::list<uint32> OverrideSpellList;
 
-        uint32 TalentId = 0;
-
-        uint32 NegativeEffectMask = 0;
-
         // struct access functions
         SpellTargetRestrictionsEntry const* GetSpellTargetRestrictions() const;
         SpellAuraOptionsEntry const* GetSpellAuraOptions() const;
@@ -481,7 +483,7 @@ class SpellInfo
         bool CheckTargetCreatureType(Unit const* target) const;
 
         SpellSchoolMask GetSchoolMask() const;
-        uint32 GetAllEffectsMechanicMask() const;
+        uint32 GetAllEffectsMechanicMask() const { return _allEffectsMechanicMask; }
         uint32 GetEffectMechanicMask(uint8 effIndex) const;
         uint32 GetSpellMechanicMaskByEffectMask(uint32 effectMask) const;
         Mechanics GetEffectMechanic(uint8 effIndex) const;
@@ -490,8 +492,8 @@ class SpellInfo
         static uint32 GetDispelMask(DispelType type);
         uint32 GetExplicitTargetMask() const;
 
-        AuraStateType GetAuraState() const;
-        SpellSpecificType GetSpellSpecific() const;
+        AuraStateType GetAuraState() const { return _auraState; }
+        SpellSpecificType GetSpellSpecific() const { return _spellSpecific; }
 
         float GetMinRange(bool positive = false) const;
         float GetMaxRange(bool positive = false, Unit* caster = NULL, Spell* spell = NULL) const;
@@ -519,8 +521,8 @@ class SpellInfo
         bool IsDifferentRankOf(SpellInfo const* spellInfo) const;
         bool IsHighRankOf(SpellInfo const* spellInfo) const;
 
-        std::array<SpellEffectInfo, MAX_SPELL_EFFECTS> const& GetEffects() const { return _effects; }
-        SpellEffectInfo const& GetEffect(SpellEffIndex index) const { ASSERT(index < _effects.size()); return _effects[index]; }
+        SpellEffectInfo const (&GetEffects() const)[MAX_SPELL_EFFECTS] { return Effects; }
+        SpellEffectInfo const& GetEffect(SpellEffIndex index) const { ASSERT(index < MAX_SPELL_EFFECTS); return Effects[index]; }
 
         bool IsRequireAdditionalTargetCheck() const;
 
@@ -528,6 +530,9 @@ class SpellInfo
 
         // loading helpers
         void _InitializeExplicitTargetMask();
+        void _LoadAllEffectsMechanicMask();
+        void _LoadSpellSpecific();
+        void _LoadAuraState();
         bool _IsPositiveEffect(uint8 effIndex, bool deep) const;
         bool _IsPositiveSpell() const;
         static bool _IsPositiveTarget(uint32 targetA, uint32 targetB);
@@ -561,8 +566,10 @@ class SpellInfo
         bool CanBeBlockedByAntiMagicShell(uint32 effectIndex) const;
 
     private:
-        std::array<SpellEffectInfo, MAX_SPELL_EFFECTS>& _GetEffects() { return _effects; }
-        SpellEffectInfo& _GetEffect(SpellEffIndex index) { ASSERT(index < _effects.size()); return _effects[index]; }
+        // derived from the fields above once all corrections and spell ranks are loaded
+        uint32 _allEffectsMechanicMask = 0;
+        SpellSpecificType _spellSpecific = SPELL_SPECIFIC_NORMAL;
+        AuraStateType _auraState = AURA_STATE_NONE;
 };
 
 #endif // _SPELLINFO_H
@@ -2636,10 +2636,21 @@ void SpellMgr::LoadSpellInfoStore()
         return targetRestrictions ? targetRestrictions : spell->SpellTargetRestrictionsId;
     };
 
-    for (uint32 i = 0; i < sSpellStore.GetNumRows(); ++i)
-        if (SpellEntry const* spellEntry = sSpellStore.LookupEntry(i))
-            for (auto&& difficulty : spellDifficultyList[i])
-                mSpellInfoMap[difficulty][i] = new SpellInfo(spellEntry, difficulty, getTargetRestrictionsId(spellEntry, difficulty));
+    for (auto&& spell : spellDifficultyList)
+        if (sSpellStore.LookupEntry(spell.first))
+            mSpellInfoStorageSize += spell.second.size();
+
+    // cast checks of consecutive spell ids, and of the same spell in different difficulties, touch neighbouring memory
+    mSpellInfoStorage = std::allocator<SpellInfo>().allocate(mSpellInfoStorageSize);
+
+    uint32 count = 0;
+    for (uint32 difficulty = 0; difficulty < MAX_DIFFICULTY; ++difficulty)
+        for (auto&& spell : spellDifficultyList)
+            if (spell.second.count(Difficulty(difficulty)))
+                if (SpellEntry const* spellEntry = sSpellStore.LookupEntry(spell.first))
+                    mSpellInfoMap[difficulty][spell.first] = new (&mSpellInfoStorage[count++]) SpellInfo(spellEntry, difficulty, getTargetRestrictionsId(spellEntry, Difficulty(difficulty)));
+
+    ASSERT(count == mSpellInfoStorageSize);
 
     for (uint32 i = 0; i < sTalentStore.GetNumRows(); i++)
     {
@@ -2674,17 +2685,40 @@ void SpellMgr::LoadSpellInfoStore()
     AddSpellOverride(105361, 31801 ); // Seal of Command -> Seal of Truth
     AddSpellOverride(686,    112092); // Shadow Bolt -> Glyphed Shadow Bolt (3 hits)
 
-    TC_LOG_INFO("server.loading", ">> Loaded SpellInfo store in %u ms", GetMSTimeDiffToNow(oldMSTime));
+    TC_LOG_INFO("server.loading", ">> Loaded %u SpellInfo entries (%u with difficulty data, " SZFMTD " KB) in %u ms", mSpellInfoStorageSize,
+        mSpellInfoStorageSize - uint32(std::count_if(mSpellInfoMap[REGULAR_DIFFICULTY].begin(), mSpellInfoMap[REGULAR_DIFFICULTY].end(), [](SpellInfo const* spellInfo) { return spellInfo != nullptr; })),
+        mSpellInfoStorageSize * sizeof(SpellInfo) / 1024, GetMSTimeDiffToNow(oldMSTime));
 }
 
 void SpellMgr::UnloadSpellInfoStore()
 {
     for (auto&& spells : mSpellInfoMap)
-    {
-        for (auto&& it : spells)
-            delete it;
         spells.clear();
+
+    if (!mSpellInfoStorage)
+        return;
+
+    std::destroy_n(mSpellInfoStorage, mSpellInfoStorageSize);
+    std::allocator<SpellInfo>().deallocate(mSpellInfoStorage, mSpellInfoStorageSize);
+    mSpellInfoStorage = nullptr;
+    mSpellInfoStorageSize = 0;
+}
+
+void SpellMgr::LoadSpellInfoDerivedData()
+{
+    uint32 oldMSTime = getMSTime();
+
+    // spell specific depends on the first rank, aura state on the spell specific
+    for (uint32 i = 0; i < mSpellInfoStorageSize; ++i)
+    {
+        mSpellInfoStorage[i]._LoadAllEffectsMechanicMask();
+        mSpellInfoStorage[i]._LoadSpellSpecific();
     }
+
+    for (uint32 i = 0; i < mSpellInfoStorageSize; ++i)
+        mSpellInfoStorage[i]._LoadAuraState();
+
+    TC_LOG_INFO("server.loading", ">> Loaded SpellInfo derived data in %u ms", GetMSTimeDiffToNow(oldMSTime));
 }
 
 void SpellMgr::UnloadSpellInfoImplicitTargetConditionLists()
@@ -752,6 +752,7 @@ class SpellMgr
         void UnloadSpellInfoImplicitTargetConditionLists();
         void LoadSpellInfoCustomAttributes();
         void LoadSpellInfoCorrections();
+        void LoadSpellInfoDerivedData();
         void LoadItemSpellsCorrections();
 
     private:
@@ -780,6 +781,8 @@ class SpellMgr
         SkillLineAbilityMap        mSkillLineAbilityMap;
         PetLevelupSpellMap         mPetSpellMap;
         SpellInfoMap               mSpellInfoMap[MAX_DIFFICULTY];
+        SpellInfo*                 mSpellInfoStorage = nullptr;     // every SpellInfo in one block, regular difficulty first, by spell id
+        uint32                     mSpellInfoStorageSize = 0;
         std::vector<uint32>        mGlyphSpells[MAX_CLASSES];
 };
 
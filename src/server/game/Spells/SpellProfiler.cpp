@@ -0,0 +1,252 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SpellProfiler.h"
+#include "Log.h"
+#include "SpellMgr.h"
+#include "World.h"
+#include <algorithm>
+#include <fstream>
+
+// bounds the memory of a trace, a busy realm produces a few hundred thousand stages per second
+static size_t const MaxTraceEventsPerThread = 1000000;
+
+void SpellProfileStats::Add(SpellProfileStats const& other)
+{
+    Calls += other.Calls;
+    TotalNs += other.TotalNs;
+    SelfNs += other.SelfNs;
+    MaxNs = std::max(MaxNs, other.MaxNs);
+}
+
+uint64 SpellProfileEntry::GetSelfNs() const
+{
+    uint64 selfNs = 0;
+    for (SpellProfileStats const& stats : Stages)
+        selfNs += stats.SelfNs;
+    return selfNs;
+}
+
+SpellProfiler* SpellProfiler::instance()
+{
+    static SpellProfiler instance;
+    return &instance;
+}
+
+bool SpellProfiler::ShouldProfileCast()
+{
+    if (_running.load(std::memory_order_relaxed) || _tracing.load(std::memory_order_relaxed))
+        return true;
+
+    uint32 interval = sWorld->getIntConfig(CONFIG_SPELL_PROFILER_SAMPLE_INTERVAL);
+    if (!interval)
+        return false;
+
+    return ++_threads.Local().SampleCounter % interval == 0;
+}
+
+void SpellProfiler::Record(uint32 spellId, SpellProfileStage stage, Clock::time_point start, Clock::time_point end, uint64 childNs)
+{
+    uint64 totalNs = uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+    ThreadData& data = _threads.Local();
+    std::lock_guard<std::mutex> lock(data.Lock);
+
+    SpellProfileEntry& entry = data.Spells[spellId];
+    entry.SpellId = spellId;
+
+    SpellProfileStats& stats = entry.Stages[stage];
+    ++stats.Calls;
+    stats.TotalNs += totalNs;
+    stats.SelfNs += totalNs > childNs ? totalNs - childNs : 0;
+    stats.MaxNs = std::max(stats.MaxNs, totalNs);
+
+    if (_tracing.load(std::memory_order_relaxed) && data.Trace.size() < MaxTraceEventsPerThread)
+    {
+        int64 startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count();
+        if (startNs < _traceEndNs.load(std::memory_order_relaxed))
+            data.Trace.push_back({ spellId, stage, startNs, int64(totalNs) });
+    }
+}
+
+void SpellProfiler::Reset()
+{
+    _threads.ForEach([](ThreadData& data, uint32 /*index*/)
+    {
+        std::lock_guard<std::mutex> dataLock(data.Lock);
+        data.Spells.clear();
+    });
+}
+
+std::vector<SpellProfileEntry> SpellProfiler::GetTopSpells(uint32 count) const
+{
+    std::unordered_map<uint32, SpellProfileEntry> merged;
+    _threads.ForEach([&merged](ThreadData& data, uint32 /*index*/)
+    {
+        std::lock_guard<std::mutex> dataLock(data.Lock);
+        for (auto const& itr : data.Spells)
+        {
+            SpellProfileEntry& entry = merged[itr.first];
+            entry.SpellId = itr.first;
+            for (uint32 i = 0; i < MAX_SPELL_PROFILE_STAGES; ++i)
+                entry.Stages[i].Add(itr.second.Stages[i]);
+        }
+    });
+
+    std::vector<SpellProfileEntry> result;
+    result.reserve(merged.size());
+    for (auto const& itr : merged)
+        result.push_back(itr.second);
+
+    std::sort(result.begin(), result.end(), [](SpellProfileEntry const& left, SpellProfileEntry const& right)
+    {
+        return left.GetSelfNs() > right.GetSelfNs();
+    });
+
+    if (result.size() > count)
+        result.resize(count);
+
+    return result;
+}
+
+SpellProfileEntry SpellProfiler::GetTotals() const
+{
+    SpellProfileEntry totals;
+    _threads.ForEach([&totals](ThreadData& data, uint32 /*index*/)
+    {
+        std::lock_guard<std::mutex> dataLock(data.Lock);
+        for (auto const& itr : data.Spells)
+            for (uint32 i = 0; i < MAX_SPELL_PROFILE_STAGES; ++i)
+                totals.Stages[i].Add(itr.second.Stages[i]);
+    });
+
+    return totals;
+}
+
+bool SpellProfiler::StartTrace(uint32 seconds, std::string const& fileName)
+{
+    if (_tracing)
+        return false;
+
+    if (_traceWriter.valid() && _traceWriter.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return false;
+
+    _threads.ForEach([](ThreadData& data, uint32 /*index*/)
+    {
+        std::lock_guard<std::mutex> dataLock(data.Lock);
+        data.Trace.clear();
+    });
+
+    _traceFile = fileName;
+    _traceEndNs = std::chrono::duration_cast<std::chrono::nanoseconds>((Clock::now() + std::chrono::seconds(seconds)).time_since_epoch()).count();
+    _tracing = true;
+    return true;
+}
+
+void SpellProfiler::Update()
+{
+    if (!_tracing.load(std::memory_order_relaxed))
+        return;
+
+    if (std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count() < _traceEndNs)
+        return;
+
+    _tracing = false;
+
+    // the buffers are only moved out under the locks, formatting and writing up to a million events per thread
+    // would stall the world thread for seconds
+    std::vector<ThreadTrace> traces;
+    _threads.ForEach([&traces](ThreadData& data, uint32 index)
+    {
+        std::lock_guard<std::mutex> dataLock(data.Lock);
+        if (!data.Trace.empty())
+            traces.push_back({ index, std::move(data.Trace) });
+        data.Trace = std::vector<TraceEvent>();
+    });
+
+    // spell names are resolved here, the writer does not touch the spell store
+    std::unordered_map<uint32, std::string> names;
+    for (ThreadTrace const& trace : traces)
+    {
+        for (TraceEvent const& event : trace.Events)
+        {
+            if (names.find(event.SpellId) != names.end())
+                continue;
+
+            std::string& name = names[event.SpellId];
+            if (SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(event.SpellId))
+                for (char const* c = spellInfo->SpellName[sWorld->GetDefaultDbcLocale()]; c && *c; ++c)
+                    if (*c != '"' && *c != '\\')
+                        name += *c;
+        }
+    }
+
+    _traceWriter = std::async(std::launch::async, [fileName = _traceFile, traces = std::move(traces), names = std::move(names)]()
+    {
+        WriteTrace(fileName, traces, names);
+    });
+}
+
+void SpellProfiler::WriteTrace(std::string const& fileName, std::vector<ThreadTrace> const& traces, std::unordered_map<uint32, std::string> const& names)
+{
+    std::ofstream file(fileName);
+    if (!file)
+    {
+        TC_LOG_ERROR("misc", "SpellProfiler: can not open trace file %s", fileName.c_str());
+        return;
+    }
+
+    uint64 events = 0;
+    bool first = true;
+    file << "{\"traceEvents\":[";
+
+    for (ThreadTrace const& trace : traces)
+    {
+        for (TraceEvent const& event : trace.Events)
+        {
+            if (!first)
+                file << ",";
+            first = false;
+
+            file << "\n{\"name\":\"" << event.SpellId << " " << names.at(event.SpellId) << "\",\"cat\":\"" << GetStageName(event.Stage)
+                << "\",\"ph\":\"X\",\"ts\":" << event.StartNs / 1000 << "." << event.StartNs / 100 % 10
+                << ",\"dur\":" << event.DurationNs / 1000 << "." << event.DurationNs / 100 % 10
+                << ",\"pid\":1,\"tid\":" << trace.Index << ",\"args\":{\"stage\":\"" << GetStageName(event.Stage) << "\"}}";
+            ++events;
+        }
+    }
+
+    file << "\n]}\n";
+
+    TC_LOG_INFO("misc", "SpellProfiler: wrote " UI64FMTD " trace events to %s", events, fileName.c_str());
+}
+
+char const* SpellProfiler::GetStageName(SpellProfileStage stage)
+{
+    switch (stage)
+    {
+        case SPELL_PROFILE_PREPARE:             return "prepare";
+        case SPELL_PROFILE_CHECK_CAST:          return "CheckCast";
+        case SPELL_PROFILE_SELECT_TARGETS:      return "SelectSpellTargets";
+        case SPELL_PROFILE_CAST:                return "cast";
+        case SPELL_PROFILE_HANDLE_IMMEDIATE:    return "handle_immediate";
+        case SPELL_PROFILE_HANDLE_DELAYED:      return "handle_delayed";
+        case SPELL_PROFILE_EFFECT_ON_TARGET:    return "DoAllEffectOnTarget";
+        case SPELL_PROFILE_EFFECT_HANDLER:      return "HandleEffects";
+        default:                                return "unknown";
+    }
+}
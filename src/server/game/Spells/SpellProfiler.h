@@ -0,0 +1,175 @@
+/*
+* This file is part of the Pandaria 5.4.8 Project. See THANKS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TRINITY_SPELLPROFILER_H
+#define TRINITY_SPELLPROFILER_H
+
+#include "Define.h"
+#include "PerThreadRegistry.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum SpellProfileStage : uint8
+{
+    SPELL_PROFILE_PREPARE,
+    SPELL_PROFILE_CHECK_CAST,
+    SPELL_PROFILE_SELECT_TARGETS,
+    SPELL_PROFILE_CAST,
+    SPELL_PROFILE_HANDLE_IMMEDIATE,
+    SPELL_PROFILE_HANDLE_DELAYED,
+    SPELL_PROFILE_EFFECT_ON_TARGET,
+    SPELL_PROFILE_EFFECT_HANDLER,
+    MAX_SPELL_PROFILE_STAGES
+};
+
+struct SpellProfileStats
+{
+    uint64 Calls = 0;
+    uint64 TotalNs = 0;     // including nested stages
+    uint64 SelfNs = 0;      // without nested stages and nested casts
+    uint64 MaxNs = 0;
+
+    void Add(SpellProfileStats const& other);
+};
+
+struct SpellProfileEntry
+{
+    uint32 SpellId = 0;
+    std::array<SpellProfileStats, MAX_SPELL_PROFILE_STAGES> Stages;
+
+    uint64 GetSelfNs() const;
+};
+
+// time spent in the stages of the cast pipeline, per spell id
+// all casts are timed while started, otherwise one of every SpellProfiler.SampleInterval casts
+class TC_GAME_API SpellProfiler
+{
+    typedef std::chrono::steady_clock Clock;
+
+    struct TraceEvent
+    {
+        uint32 SpellId;
+        SpellProfileStage Stage;
+        int64 StartNs;
+        int64 DurationNs;
+    };
+
+    struct ThreadData
+    {
+        std::mutex Lock;
+        std::unordered_map<uint32, SpellProfileEntry> Spells;
+        std::vector<TraceEvent> Trace;
+        uint32 SampleCounter = 0;
+    };
+
+    struct ThreadTrace
+    {
+        uint32 Index;
+        std::vector<TraceEvent> Events;
+    };
+
+    public:
+        static SpellProfiler* instance();
+
+        void Start() { _running = true; }
+        void Stop() { _running = false; }
+        bool IsRunning() const { return _running; }
+        void Reset();
+
+        // decided once per cast, scopes of casts that are not profiled cost a branch
+        bool ShouldProfileCast();
+        void Record(uint32 spellId, SpellProfileStage stage, Clock::time_point start, Clock::time_point end, uint64 childNs);
+
+        std::vector<SpellProfileEntry> GetTopSpells(uint32 count) const;
+        SpellProfileEntry GetTotals() const;
+
+        // records every timed stage for the given time, once it ended Update hands the events to a task writing the chrome trace file
+        // fails while a trace is recorded or still being written
+        bool StartTrace(uint32 seconds, std::string const& fileName);
+        bool IsTracing() const { return _tracing; }
+        void Update();
+
+        static char const* GetStageName(SpellProfileStage stage);
+
+    private:
+        SpellProfiler() : _running(false), _tracing(false), _traceEndNs(0) { }
+        ~SpellProfiler() { }
+
+        static void WriteTrace(std::string const& fileName, std::vector<ThreadTrace> const& traces, std::unordered_map<uint32, std::string> const& names);
+
+        Trinity::PerThreadRegistry<ThreadData> _threads;
+
+        std::atomic<bool> _running;
+        std::atomic<bool> _tracing;
+        std::atomic<int64> _traceEndNs;
+        std::string _traceFile;
+        std::future<void> _traceWriter;
+};
+
+#define sSpellProfiler SpellProfiler::instance()
+
+// times the enclosing block as one stage of a cast, spellId 0 disables it
+class SpellProfileScope
+{
+    public:
+        SpellProfileScope(uint32 spellId, SpellProfileStage stage) : _spellId(spellId), _stage(stage), _childNs(0), _parent(nullptr)
+        {
+            if (!_spellId)
+                return;
+
+            _parent = Current();
+            Current() = this;
+            _start = std::chrono::steady_clock::now();
+        }
+
+        ~SpellProfileScope()
+        {
+            if (!_spellId)
+                return;
+
+            std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+            Current() = _parent;
+            if (_parent)
+                _parent->_childNs += uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(end - _start).count());
+
+            sSpellProfiler->Record(_spellId, _stage, _start, end, _childNs);
+        }
+
+        SpellProfileScope(SpellProfileScope const&) = delete;
+        SpellProfileScope& operator=(SpellProfileScope const&) = delete;
+
+    private:
+        static SpellProfileScope*& Current()
+        {
+            thread_local SpellProfileScope* current = nullptr;
+            return current;
+        }
+
+        uint32 _spellId;
+        SpellProfileStage _stage;
+        uint64 _childNs;
+        SpellProfileScope* _parent;
+        std::chrono::steady_clock::time_point _start;
+};
+
+#endif
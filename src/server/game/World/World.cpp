@@ -73,6 +73,8 @@
 #include "ScriptMgr.h"
 #include "AddonMgr.h"
 #include "LFGMgr.h"
+#include "SpellProfiler.h"
+#include "AIProfiler.h"
 #include "ConditionMgr.h"
 #include "DisableMgr.h"
 #include "CharacterDatabaseCleaner.h"
@@ -579,6 +581,9 @@ void World::LoadConfigSettings(bool reload)
     if (reload)
         sMapMgr->SetGridCleanUpDelay(m_int_configs[CONFIG_INTERVAL_GRIDCLEAN]);
 
+    m_int_configs[CONFIG_GRID_DORMANT_MAX_GRIDS] = sConfigMgr->GetIntDefault("GridUnload.DormantGrids", 8);
+    m_int_configs[CONFIG_GRID_DORMANT_MAX_MEMORY] = sConfigMgr->GetIntDefault("GridUnload.DormantMemory", 16);
+
     m_int_configs[CONFIG_INTERVAL_MAPUPDATE] = 200; // Don't mess around with mapupdate cause of the issues with the mmaps.
 
     m_int_configs[CONFIG_INTERVAL_CHANGEWEATHER] = sConfigMgr->GetIntDefault("ChangeWeatherInterval", 10 * MINUTE * IN_MILLISECONDS);
@@ -1302,6 +1307,10 @@ void World::LoadConfigSettings(bool reload)
     }
 
     m_bool_configs[CONFIG_ENABLE_MMAPS] = sConfigMgr->GetBoolDefault("mmap.enablePathFinding", false);
+    m_bool_configs[CONFIG_PATHFINDING_ASYNC] = sConfigMgr->GetBoolDefault("mmap.asyncPathFinding", false);
+    m_int_configs[CONFIG_PATHFINDING_ASYNC_THREADS] = sConfigMgr->GetIntDefault("mmap.asyncPathFinding.Threads", 2);
+    m_int_configs[CONFIG_PATHFINDING_ASYNC_MAP_LIMIT] = sConfigMgr->GetIntDefault("mmap.asyncPathFinding.MaxRequestsPerMap", 64);
+    m_int_configs[CONFIG_PATHFINDING_CACHE_SIZE] = sConfigMgr->GetIntDefault("mmap.pathCache.MaxEntriesPerMap", 256);
 
     TC_LOG_INFO("server.loading", "WORLD: MMap data directory is: %smmaps", m_dataPath.c_str());
 
@@ -1338,6 +1347,12 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_SHOW_KICK_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowKickInWorld", false);
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] = sConfigMgr->GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE] = sConfigMgr->GetIntDefault("MinRecordUpdateTimeDiff", 100);
+    m_int_configs[CONFIG_SPELL_PROFILER_SAMPLE_INTERVAL] = sConfigMgr->GetIntDefault("SpellProfiler.SampleInterval", 0);
+    m_bool_configs[CONFIG_AI_PROFILER_ENABLE] = sConfigMgr->GetBoolDefault("AIProfiler.Enable", false);
+    m_int_configs[CONFIG_AI_PROFILER_LOG_INTERVAL] = sConfigMgr->GetIntDefault("AIProfiler.LogInterval", 300);
+    m_int_configs[CONFIG_AI_PROFILER_LOG_COUNT] = sConfigMgr->GetIntDefault("AIProfiler.LogCount", 20);
+    if (m_bool_configs[CONFIG_AI_PROFILER_ENABLE])
+        sAIProfiler->Start();
     m_int_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 1);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetIntDefault("Command.LookupMaxResults", 0);
 
@@ -1533,6 +1548,8 @@ void World::LoadConfigSettings(bool reload)
 
     m_int_configs[CONFIG_CREATURE_PICKPOCKET_REFILL] = sConfigMgr->GetIntDefault("Creature.PickPocketRefillDelay", 10 * MINUTE);
     m_int_configs[CONFIG_CREATURE_STOP_FOR_PLAYER] = sConfigMgr->GetIntDefault("Creature.MovingStopTimeForPlayer", 3 * MINUTE * IN_MILLISECONDS);
+    m_int_configs[CONFIG_CREATURE_REDUCED_UPDATE_INTERVAL] = sConfigMgr->GetIntDefault("Creature.ReducedUpdateInterval", 500);
+    m_float_configs[CONFIG_CREATURE_REDUCED_UPDATE_RANGE] = sConfigMgr->GetFloatDefault("Creature.ReducedUpdateRange", 60.0f);
 
     m_bool_configs[CONFIG_AUCTIONHOUSE_ALLOW_SORTING]        = sConfigMgr->GetBoolDefault("AuctionHouse.AllowSorting", true);
     m_bool_configs[CONFIG_AUCTIONHOUSE_FORCE_MAIN_THREAD]    = sConfigMgr->GetBoolDefault("AuctionHouse.ForceMainThread", false);
@@ -1561,6 +1578,7 @@ void World::LoadConfigSettings(bool reload)
 #ifdef ELUNA
 	//eluna
 	m_bool_configs[CONFIG_BOOL_ELUNA_ENABLED] = sConfigMgr->GetBoolDefault("Eluna.Enabled", true);
+    m_bool_configs[CONFIG_BOOL_ELUNA_PER_MAP_STATES] = sConfigMgr->GetBoolDefault("Eluna.PerMapStates", false);
 #endif    
     // Loading of Locales
     m_bool_configs[CONFIG_LOAD_LOCALES] = sConfigMgr->GetBoolDefault("Load.Locales", true);
@@ -1898,6 +1916,9 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading Spell Rank Data...");
     sSpellMgr->LoadSpellRanks();
 
+    TC_LOG_INFO("server.loading", "Loading SpellInfo derived data...");
+    sSpellMgr->LoadSpellInfoDerivedData();                       // must be after LoadSpellRanks
+
     TC_LOG_INFO("server.loading", "Loading Spell Required Data...");
     sSpellMgr->LoadSpellRequired();
 
@@ -2574,6 +2595,10 @@ void World::LoadAutobroadcasts()
 /// Update the World !
 void World::Update(uint32 diff)
 {
+#ifdef ELUNA
+    ElunaWorldScope elunaScope;
+#endif
+
     m_updateTime = diff;
 
     ///- Update the different timers
@@ -2705,7 +2730,13 @@ void World::Update(uint32 diff)
 
     /// <li> Handle all other objects
     ///- Update objects when the timer has passed (maps, transport, creatures, ...)
+#ifdef ELUNA
+    elunaScope.Release();
+#endif
     sMapMgr->Update(diff);
+#ifdef ELUNA
+    elunaScope.Reacquire();
+#endif
 
     if (sWorld->getBoolConfig(CONFIG_AUTOBROADCAST))
     {
@@ -2737,6 +2768,9 @@ void World::Update(uint32 diff)
     sLFGMgr->Update(diff);
     RecordTimeDiff("UpdateLFGMgr");
 
+    sSpellProfiler->Update();
+    sAIProfiler->Update(diff);
+
     // execute callbacks from sql queries that were queued recently
     ProcessQueryCallbacks();
     RecordTimeDiff("ProcessQueryCallbacks");
@@ -164,6 +164,7 @@ enum WorldBoolConfigs
     CONFIG_PVP_TOKEN_ENABLE,
     CONFIG_NO_RESET_TALENT_COST,
     CONFIG_SHOW_KICK_IN_WORLD,
+    CONFIG_AI_PROFILER_ENABLE,
     CONFIG_CHATLOG_CHANNEL,
     CONFIG_CHATLOG_WHISPER,
     CONFIG_CHATLOG_SYSCHAN,
@@ -187,6 +188,7 @@ enum WorldBoolConfigs
     CONFIG_QUEST_IGNORE_AUTO_COMPLETE,
     CONFIG_WARDEN_ENABLED,
     CONFIG_ENABLE_MMAPS,
+    CONFIG_PATHFINDING_ASYNC,
     CONFIG_WINTERGRASP_ENABLE,
     CONFIG_GUILD_LEVELING_ENABLED,
     CONFIG_UI_QUESTLEVELS_IN_DIALOGS,     // Should we add quest levels to the title in the NPC dialogs?
@@ -252,6 +254,7 @@ enum WorldBoolConfigs
     CONFIG_DISABLE_RESTART,   
 #ifdef ELUNA
 	CONFIG_BOOL_ELUNA_ENABLED,
+    CONFIG_BOOL_ELUNA_PER_MAP_STATES,
 #endif 
     CONFIG_LOAD_LOCALES,
     BOOL_CONFIG_VALUE_COUNT
@@ -268,6 +271,7 @@ enum WorldFloatConfigs
     CONFIG_LISTEN_RANGE_YELL,
     CONFIG_CREATURE_FAMILY_FLEE_ASSISTANCE_RADIUS,
     CONFIG_CREATURE_FAMILY_ASSISTANCE_RADIUS,
+    CONFIG_CREATURE_REDUCED_UPDATE_RANGE,
     CONFIG_THREAT_RADIUS,
     CONFIG_CHANCE_OF_GM_SURVEY,
     CONFIG_STATS_LIMITS_DODGE,
@@ -370,6 +374,8 @@ enum WorldIntConfigs
     CONFIG_COMPRESSION = 0,
     CONFIG_INTERVAL_SAVE,
     CONFIG_INTERVAL_GRIDCLEAN,
+    CONFIG_GRID_DORMANT_MAX_GRIDS,
+    CONFIG_GRID_DORMANT_MAX_MEMORY,
     CONFIG_INTERVAL_MAPUPDATE,
     CONFIG_INTERVAL_CHANGEWEATHER,
     CONFIG_INTERVAL_DISCONNECT_TOLERANCE,
@@ -489,9 +495,15 @@ enum WorldIntConfigs
     CONFIG_PVP_TOKEN_COUNT,
     CONFIG_INTERVAL_LOG_UPDATE,
     CONFIG_MIN_LOG_UPDATE,
+    CONFIG_SPELL_PROFILER_SAMPLE_INTERVAL,
+    CONFIG_AI_PROFILER_LOG_INTERVAL,
+    CONFIG_AI_PROFILER_LOG_COUNT,
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_PATHFINDING_ASYNC_THREADS,
+    CONFIG_PATHFINDING_ASYNC_MAP_LIMIT,
+    CONFIG_PATHFINDING_CACHE_SIZE,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_CLIENTCACHE_VERSION,
@@ -602,6 +614,7 @@ enum WorldIntConfigs
     CONFIG_DELETING_ITEM_MAX_QUALITY,
     CONFIG_CREATURE_PICKPOCKET_REFILL,
     CONFIG_CREATURE_STOP_FOR_PLAYER,
+    CONFIG_CREATURE_REDUCED_UPDATE_INTERVAL,
     CONFIG_AHBOT_UPDATE_INTERVAL,
     CONFIG_AUCTIONHOUSE_MIN_DIFF_FOR_LOG,
     CONFIG_AUCTIONHOUSE_MIN_DIFF_FOR_THROTTLE,
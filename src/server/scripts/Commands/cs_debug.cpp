@@ -33,6 +33,14 @@ EndScriptData */
 #include "GossipDef.h"
 #include "Transport.h"
 #include "Language.h"
+#include "Log.h"
+#include "MapManager.h"
+#include "SmartScriptMgr.h"
+#include "SpellProfiler.h"
+#include "AIProfiler.h"
+#ifdef ELUNA
+#include "LuaEngine.h"
+#endif
 
 #include <fstream>
 
@@ -105,6 +113,40 @@ public:
                 { "digsite",    SEC_ADMINISTRATOR,  false,  &HandleDebugArchaeologyDigsite          },
             } },
             { "vignette",       SEC_ADMINISTRATOR,  false,  &HandleDebugVignette,                   },
+            { "spellprofile",   SEC_ADMINISTRATOR,  true,   {
+                { "start",      SEC_ADMINISTRATOR,  true,   &HandleDebugSpellProfileStartCommand    },
+                { "stop",       SEC_ADMINISTRATOR,  true,   &HandleDebugSpellProfileStopCommand     },
+                { "reset",      SEC_ADMINISTRATOR,  true,   &HandleDebugSpellProfileResetCommand    },
+                { "top",        SEC_ADMINISTRATOR,  true,   &HandleDebugSpellProfileTopCommand      },
+                { "trace",      SEC_ADMINISTRATOR,  true,   &HandleDebugSpellProfileTraceCommand    },
+            } },
+            { "aiprofile",      SEC_ADMINISTRATOR,  true,   {
+                { "start",      SEC_ADMINISTRATOR,  true,   &HandleDebugAIProfileStartCommand       },
+                { "stop",       SEC_ADMINISTRATOR,  true,   &HandleDebugAIProfileStopCommand        },
+                { "reset",      SEC_ADMINISTRATOR,  true,   &HandleDebugAIProfileResetCommand       },
+                { "top",        SEC_ADMINISTRATOR,  true,   &HandleDebugAIProfileTopCommand         },
+            } },
+            { "smartprofile",   SEC_ADMINISTRATOR,  true,   {
+                { "start",      SEC_ADMINISTRATOR,  true,   &HandleDebugSmartProfileStartCommand    },
+                { "stop",       SEC_ADMINISTRATOR,  true,   &HandleDebugSmartProfileStopCommand     },
+                { "reset",      SEC_ADMINISTRATOR,  true,   &HandleDebugSmartProfileResetCommand    },
+                { "top",        SEC_ADMINISTRATOR,  true,   &HandleDebugSmartProfileTopCommand      },
+            } },
+            { "scripthooks",    SEC_ADMINISTRATOR,  true,   {
+                { "start",      SEC_ADMINISTRATOR,  true,   &HandleDebugScriptHooksStartCommand     },
+                { "stop",       SEC_ADMINISTRATOR,  true,   &HandleDebugScriptHooksStopCommand      },
+                { "reset",      SEC_ADMINISTRATOR,  true,   &HandleDebugScriptHooksResetCommand     },
+                { "",           SEC_ADMINISTRATOR,  true,   &HandleDebugScriptHooksCommand          },
+            } },
+            { "creatureupdates", SEC_ADMINISTRATOR, true,   &HandleDebugCreatureUpdatesCommand      },
+            { "dormantgrids",   SEC_ADMINISTRATOR,  true,   &HandleDebugDormantGridsCommand         },
+#ifdef ELUNA
+            { "eluna",          SEC_ADMINISTRATOR,  true,   {
+                { "bench",      SEC_ADMINISTRATOR,  false,  &HandleDebugElunaBenchCommand           },
+                { "reset",      SEC_ADMINISTRATOR,  true,   &HandleDebugElunaResetCommand           },
+                { "",           SEC_ADMINISTRATOR,  true,   &HandleDebugElunaCommand                },
+            } },
+#endif
             { "value",          SEC_ADMINISTRATOR,  true,   &HandleDebugValueCommand,               },
             { "",               SEC_ADMINISTRATOR,  true,   &HandleDebugValueCommand,               },
         };
@@ -1714,6 +1756,327 @@ public:
 
         return true;
     }
+
+    static bool HandleDebugSpellProfileStartCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sSpellProfiler->Start();
+        handler->SendSysMessage("Spell profiler started, every cast is timed.");
+        return true;
+    }
+
+    static bool HandleDebugSpellProfileStopCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sSpellProfiler->Stop();
+        handler->SendSysMessage("Spell profiler stopped.");
+        return true;
+    }
+
+    static bool HandleDebugSpellProfileResetCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sSpellProfiler->Reset();
+        handler->SendSysMessage("Spell profiler counters cleared.");
+        return true;
+    }
+
+    // .debug spellprofile top [count]
+    static bool HandleDebugSpellProfileTopCommand(ChatHandler* handler, char const* args)
+    {
+        uint32 count = *args ? std::min<uint32>(std::max(atoi(args), 1), 100) : 10;
+
+        SpellProfileEntry totals = sSpellProfiler->GetTotals();
+        handler->PSendSysMessage("Spell profiler (%s), self time per stage:", sSpellProfiler->IsRunning() ? "running" : "sampling");
+        for (uint32 i = 0; i < MAX_SPELL_PROFILE_STAGES; ++i)
+        {
+            SpellProfileStats const& stats = totals.Stages[i];
+            if (stats.Calls)
+                handler->PSendSysMessage("  %s: " UI64FMTD " calls, " UI64FMTD " us self, " UI64FMTD " us total, " UI64FMTD " us max",
+                    SpellProfiler::GetStageName(SpellProfileStage(i)), stats.Calls, stats.SelfNs / 1000, stats.TotalNs / 1000, stats.MaxNs / 1000);
+        }
+
+        std::vector<SpellProfileEntry> top = sSpellProfiler->GetTopSpells(count);
+        if (top.empty())
+        {
+            handler->SendSysMessage("No casts recorded.");
+            return true;
+        }
+
+        handler->PSendSysMessage("Top %u spells by self time:", uint32(top.size()));
+        for (SpellProfileEntry const& entry : top)
+        {
+            SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(entry.SpellId);
+            SpellProfileStage heaviest = SPELL_PROFILE_PREPARE;
+            for (uint32 i = 0; i < MAX_SPELL_PROFILE_STAGES; ++i)
+                if (entry.Stages[i].SelfNs > entry.Stages[heaviest].SelfNs)
+                    heaviest = SpellProfileStage(i);
+
+            handler->PSendSysMessage("  %u %s: " UI64FMTD " us, " UI64FMTD " casts, mostly %s",
+                entry.SpellId, spellInfo ? spellInfo->SpellName[handler->GetSessionDbcLocale()] : "<unknown>",
+                entry.GetSelfNs() / 1000, entry.Stages[SPELL_PROFILE_PREPARE].Calls, SpellProfiler::GetStageName(heaviest));
+        }
+
+        return true;
+    }
+
+    // .debug spellprofile trace #seconds
+    static bool HandleDebugSpellProfileTraceCommand(ChatHandler* handler, char const* args)
+    {
+        uint32 seconds = *args ? atoi(args) : 0;
+        if (!seconds || seconds > 60)
+        {
+            handler->SendSysMessage("Usage: .debug spellprofile trace #seconds (1-60)");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        std::string fileName = Trinity::StringFormat("%sspell_trace_%u.json", sLog->GetLogsDir().c_str(), uint32(time(nullptr)));
+        if (!sSpellProfiler->StartTrace(seconds, fileName))
+        {
+            handler->SendSysMessage("A spell trace is already being recorded or written.");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        handler->PSendSysMessage("Recording every cast for %u seconds into %s (chrome://tracing format).", seconds, fileName.c_str());
+        return true;
+    }
+
+    static bool HandleDebugAIProfileStartCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sAIProfiler->Start();
+        handler->SendSysMessage("AI profiler started.");
+        return true;
+    }
+
+    static bool HandleDebugAIProfileStopCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sAIProfiler->Stop();
+        handler->SendSysMessage("AI profiler stopped.");
+        return true;
+    }
+
+    static bool HandleDebugAIProfileResetCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sAIProfiler->Reset();
+        handler->SendSysMessage("AI profiler counters cleared.");
+        return true;
+    }
+
+    // .debug aiprofile top [count]
+    static bool HandleDebugAIProfileTopCommand(ChatHandler* handler, char const* args)
+    {
+        uint32 count = *args ? std::min<uint32>(std::max(atoi(args), 1), 100) : 10;
+
+        std::vector<AIProfileEntry> top = sAIProfiler->GetTopEntries(count);
+        if (top.empty())
+        {
+            handler->SendSysMessage("No AI updates recorded.");
+            return true;
+        }
+
+        handler->PSendSysMessage("Top %u AI entries by self time (profiler %s):", uint32(top.size()), sAIProfiler->IsRunning() ? "running" : "stopped");
+        for (AIProfileEntry const& entry : top)
+        {
+            AIProfileStage heaviest = AI_PROFILE_UPDATE_AI;
+            for (uint32 i = 0; i < MAX_AI_PROFILE_STAGES; ++i)
+                if (entry.Stages[i].SelfNs > entry.Stages[heaviest].SelfNs)
+                    heaviest = AIProfileStage(i);
+
+            handler->PSendSysMessage("  map %u %s: " UI64FMTD " us, " UI64FMTD " updates, " UI64FMTD " us max, mostly %s",
+                entry.MapId, entry.GetName().c_str(), entry.GetSelfNs() / 1000, entry.Stages[AI_PROFILE_UPDATE_AI].Calls,
+                entry.Stages[heaviest].MaxNs / 1000, AIProfiler::GetStageName(heaviest));
+        }
+
+        return true;
+    }
+
+    static bool HandleDebugSmartProfileStartCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sSmartScriptMgr->SetProfiling(true);
+        handler->SendSysMessage("SmartAI profiler started.");
+        return true;
+    }
+
+    static bool HandleDebugSmartProfileStopCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sSmartScriptMgr->SetProfiling(false);
+        handler->SendSysMessage("SmartAI profiler stopped.");
+        return true;
+    }
+
+    static bool HandleDebugSmartProfileResetCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sSmartScriptMgr->ResetCosts();
+        handler->SendSysMessage("SmartAI profiler counters cleared.");
+        return true;
+    }
+
+    // .debug smartprofile top [count]
+    static bool HandleDebugSmartProfileTopCommand(ChatHandler* handler, char const* args)
+    {
+        uint32 count = *args ? std::min<uint32>(std::max(atoi(args), 1), 100) : 10;
+
+        std::vector<SmartScriptCost> top = sSmartScriptMgr->GetTopCosts(count);
+        if (top.empty())
+        {
+            handler->SendSysMessage("No SmartAI updates recorded.");
+            return true;
+        }
+
+        static char const* const sourceTypeNames[] = { "creature", "gameobject", "areatrigger" };
+
+        handler->PSendSysMessage("Top %u SmartAI scripts by time (profiler %s):", uint32(top.size()), sSmartScriptMgr->IsProfiling() ? "running" : "stopped");
+        for (SmartScriptCost const& cost : top)
+            handler->PSendSysMessage("  %s %d: " UI64FMTD " us, " UI64FMTD " updates, " UI64FMTD " events, " UI64FMTD " us max",
+                cost.SourceType < 3 ? sourceTypeNames[cost.SourceType] : "timed actionlist", cost.EntryOrGuid,
+                cost.TotalNs / 1000, cost.Updates, cost.Events, cost.MaxNs / 1000);
+
+        return true;
+    }
+
+    static bool HandleDebugScriptHooksStartCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sScriptMgr->SetHookProfiling(true);
+        handler->SendSysMessage("Script hook dispatches are timed.");
+        return true;
+    }
+
+    static bool HandleDebugScriptHooksStopCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sScriptMgr->SetHookProfiling(false);
+        handler->SendSysMessage("Script hook dispatches are no longer timed.");
+        return true;
+    }
+
+    static bool HandleDebugScriptHooksResetCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sScriptMgr->ResetHookStats();
+        handler->SendSysMessage("Script hook counters cleared.");
+        return true;
+    }
+
+    // .debug scripthooks, scripts dispatched per hook and the time spent in them
+    static bool HandleDebugScriptHooksCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        handler->PSendSysMessage("Script hooks (profiling %s):", sScriptMgr->IsHookProfiling() ? "on" : "off");
+        for (ScriptMgr::HookReport const& hook : sScriptMgr->GetHookReport())
+            handler->PSendSysMessage("  %s::%s: %u scripts, " UI64FMTD " calls, " UI64FMTD " us",
+                hook.ScriptType, hook.Hook, hook.Scripts, hook.Calls, hook.TotalNs / 1000);
+
+        return true;
+    }
+
+    // .debug creatureupdates [reset]
+    static bool HandleDebugCreatureUpdatesCommand(ChatHandler* handler, char const* args)
+    {
+        if (*args && strncmp(args, "reset", strlen(args)) == 0)
+        {
+            sMapMgr->DoForAllMaps([](Map* map) { map->ResetCreatureUpdateCounters(); });
+            handler->SendSysMessage("Creature update counters cleared.");
+            return true;
+        }
+
+        handler->SendSysMessage("Creature updates per map (updated / skipped):");
+        sMapMgr->DoForAllMaps([handler](Map* map)
+        {
+            uint64 updates = map->GetCreatureUpdateCount();
+            uint64 skipped = map->GetSkippedCreatureUpdateCount();
+            if (!updates && !skipped)
+                return;
+
+            handler->PSendSysMessage("  map %u instance %u: " UI64FMTD " / " UI64FMTD " (%.1f%% skipped)",
+                map->GetId(), map->GetInstanceId(), updates, skipped, float(skipped) * 100.0f / float(updates + skipped));
+        });
+
+        return true;
+    }
+
+    static bool HandleDebugDormantGridsCommand(ChatHandler* handler, char const* args)
+    {
+        if (*args && strncmp(args, "reset", strlen(args)) == 0)
+        {
+            sMapMgr->DoForAllMaps([](Map* map) { map->ResetDormantGridCounters(); });
+            handler->SendSysMessage("Dormant grid counters cleared.");
+            return true;
+        }
+
+        handler->SendSysMessage("Dormant grids per map (kept / hits / misses / evicted):");
+        sMapMgr->DoForAllMaps([handler](Map* map)
+        {
+            uint32 count = map->GetDormantGridCount();
+            uint64 hits = map->GetDormantGridHits();
+            uint64 misses = map->GetDormantGridMisses();
+            uint64 evictions = map->GetDormantGridEvictions();
+            if (!count && !hits && !misses && !evictions)
+                return;
+
+            handler->PSendSysMessage("  map %u instance %u: %u (" UI64FMTD " KB) / " UI64FMTD " / " UI64FMTD " / " UI64FMTD " (%.1f%% hit rate)",
+                map->GetId(), map->GetInstanceId(), count, map->GetDormantGridMemory() / 1024, hits, misses, evictions,
+                hits + misses ? float(hits) * 100.0f / float(hits + misses) : 0.0f);
+        });
+
+        return true;
+    }
+
+#ifdef ELUNA
+    static bool HandleDebugElunaResetCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        Eluna::ResetStateStats();
+        handler->SendSysMessage("Lua state counters cleared.");
+        return true;
+    }
+
+    // .debug eluna bench [count] - times synthetic hooks with the player and the selected unit in the state of the player's map
+    static bool HandleDebugElunaBenchCommand(ChatHandler* handler, char const* args)
+    {
+        uint32 count = *args ? uint32(atoi(args)) : 100000;
+        if (!count)
+            return false;
+
+        Player* player = handler->GetSession()->GetPlayer();
+        Unit* target = handler->getSelectedUnit();
+        if (!target)
+            target = player;
+
+        Eluna::BenchmarkResult result;
+        {
+            ElunaMapScope elunaScope(player->GetMap());
+            if (!sEluna->Benchmark(player, target, count, result))
+            {
+                handler->SendSysMessage("Lua engine is not running.");
+                handler->SetSentErrorMessage(true);
+                return false;
+            }
+        }
+
+        handler->PSendSysMessage("Lua hooks, %u calls:", count);
+        handler->PSendSysMessage("  push arguments: " UI64FMTD " ns per call", result.PushNs / count);
+        handler->PSendSysMessage("  kill creature: " UI64FMTD " ns per call", result.KillNs / count);
+        handler->PSendSysMessage("  chat: " UI64FMTD " ns per call", result.ChatNs / count);
+        return true;
+    }
+
+    static bool HandleDebugElunaCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        std::vector<Eluna::StateStats> states = Eluna::GetStateStats();
+        std::sort(states.begin(), states.end(), [](Eluna::StateStats const& left, Eluna::StateStats const& right)
+        {
+            return left.TotalNs > right.TotalNs;
+        });
+
+        handler->PSendSysMessage("Lua states: %u", uint32(states.size()));
+        for (Eluna::StateStats const& state : states)
+        {
+            if (state.MapId < 0)
+                handler->PSendSysMessage("  world: " UI64FMTD " calls, " UI64FMTD " ms, max " UI64FMTD " us, " UI64FMTD " errors",
+                    state.Calls, state.TotalNs / 1000000, state.MaxNs / 1000, state.Errors);
+            else
+                handler->PSendSysMessage("  map %d instance %u: " UI64FMTD " calls, " UI64FMTD " ms, max " UI64FMTD " us, " UI64FMTD " errors",
+                    state.MapId, state.InstanceId, state.Calls, state.TotalNs / 1000000, state.MaxNs / 1000, state.Errors);
+        }
+
+        return true;
+    }
+#endif
 };
 
 void AddSC_debug_commandscript()
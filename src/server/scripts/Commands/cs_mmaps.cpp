@@ -30,6 +30,8 @@
 #include "Player.h"
 #include "PointMovementGenerator.h"
 #include "PathGenerator.h"
+#include "PathCache.h"
+#include "PathRequestMgr.h"
 #include "MMapFactory.h"
 #include "Map.h"
 #include "TargetedMovementGenerator.h"
@@ -270,6 +272,25 @@ public:
 
         MMAP::MMapManager* manager = MMAP::MMapFactory::createOrGetMMapManager();
         handler->PSendSysMessage(" %u maps loaded with %u tiles overall", manager->getLoadedMapsCount(), manager->getLoadedTilesCount());
+        handler->PSendSysMessage(" %u navmesh queries allocated across all threads", manager->getNavMeshQueriesCount());
+
+        if (sPathCache->IsEnabled())
+            handler->PSendSysMessage(" path cache: %u routes, " UI64FMTD " hits, " UI64FMTD " misses",
+                sPathCache->GetRouteCount(), sPathCache->GetHits(), sPathCache->GetMisses());
+
+        if (sPathRequestMgr->IsEnabled())
+        {
+            PathRequestStats stats = sPathRequestMgr->GetStats();
+            PathRequestStats mapStats = sPathRequestMgr->GetMapStats(mapId);
+            uint64 finished = std::max<uint64>(1, stats.Completed + stats.Cancelled);
+            uint64 completed = std::max<uint64>(1, stats.Completed);
+            handler->PSendSysMessage(" async paths: " UI64FMTD " submitted, " UI64FMTD " completed, " UI64FMTD " cancelled, " UI64FMTD " rejected, %u in flight",
+                stats.Submitted, stats.Completed, stats.Cancelled, stats.Rejected, stats.InFlight);
+            handler->PSendSysMessage(" async paths: avg queue " UI64FMTD " us, avg compute " UI64FMTD " us, max compute " UI64FMTD " us",
+                stats.QueueTimeUs / finished, stats.ComputeTimeUs / completed, stats.MaxComputeTimeUs);
+            handler->PSendSysMessage(" async paths in map %u: " UI64FMTD " submitted, " UI64FMTD " rejected, %u in flight",
+                mapId, mapStats.Submitted, mapStats.Rejected, mapStats.InFlight);
+        }
 
         dtNavMesh const* navmesh = manager->GetNavMesh(mapId);
         if (!navmesh)
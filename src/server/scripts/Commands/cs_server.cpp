@@ -75,6 +75,7 @@ public:
         static std::vector<ChatCommand> serverStatsCommandTable =
         {
             { "mapupdate",      SEC_ADMINISTRATOR,      true,   &HandleServerStatsMapUpdateCommand, },
+            { "periodic",       SEC_ADMINISTRATOR,      true,   &HandleServerStatsPeriodicCommand,  },
         };
 
         static std::vector<ChatCommand> serverCommandTable =
@@ -551,6 +552,12 @@ public:
 
         return true;
     }
+
+    static bool HandleServerStatsPeriodicCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        handler->PSendSysMessage("Periodic aura ticks logged: " UI64FMTD, Unit::GetPeriodicAuraLogTickCount());
+        return true;
+    }
 };
 
 void AddSC_server_commandscript()
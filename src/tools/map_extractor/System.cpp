@@ -25,8 +25,12 @@
 #include <cstdlib>
 #include <vector>
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <chrono>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #ifdef _WIN32
 #include "direct.h"
@@ -93,6 +97,7 @@ float CONF_use_minHeight = -500.0f;
 
 // This option allow use float to int conversion
 bool  CONF_allow_float_to_int   = false;
+uint32 CONF_threads = 0;                                    // 0 - one per hardware thread
 float CONF_float_to_int8_limit  = 2.0f;      // Max accuracy = val/256
 float CONF_float_to_int16_limit = 2048.0f;   // Max accuracy = val/65536
 float CONF_flat_height_delta_limit = 0.005f; // If max - min less this value - surface is flat
@@ -174,6 +179,7 @@ void Usage(char const* prg)
         "-e extract only MAP(1)/DBC(2) - standard: both(3)\n"\
         "-f height stored as int (less map size but lost some accuracy) 1 by default\n"\
         "-b target build (default %u)\n"\
+        "-t number of threads converting map tiles (default: all cores)\n"\
         "Example: %s -f 0 -i \"c:\\games\\game\"", prg, CONF_TargetBuild, prg);
     exit(1);
 }
@@ -188,6 +194,7 @@ void HandleArgs(int argc, char* arg[])
         // f - use float to int conversion
         // h - limit minimum height
         // b - target client build
+        // t - number of extraction threads
         if (arg[c][0] != '-')
             Usage(arg[0]);
 
@@ -227,6 +234,12 @@ void HandleArgs(int argc, char* arg[])
                 else
                     Usage(arg[0]);
                 break;
+            case 't':
+                if (c + 1 < argc)                            // all ok
+                    CONF_threads = atoi(arg[c++ + 1]);
+                else
+                    Usage(arg[0]);
+                break;
             default:
                 break;
         }
@@ -422,23 +435,23 @@ float selectUInt16StepStore(float maxDiff)
 {
     return 65535 / maxDiff;
 }
-// Temporary grid data store
-uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+// Temporary grid data store, one per extraction thread
+thread_local uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
 
-float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint16 uint16_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint8  uint8_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint16 uint16_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint8  uint8_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
 
-uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
 
-int16 flight_box_max[3][3];
-int16 flight_box_min[3][3];
+thread_local int16 flight_box_max[3][3];
+thread_local int16 flight_box_min[3][3];
 
 bool ConvertADT(char *filename, char *filename2, int /*cell_y*/, int /*cell_x*/, uint32 build)
 {
@@ -1002,6 +1015,14 @@ bool ConvertADT(char *filename, char *filename2, int /*cell_y*/, int /*cell_x*/,
     return true;
 }
 
+struct MapTileJob
+{
+    std::string MpqFileName;
+    std::string OutputFileName;
+    int CellY;
+    int CellX;
+};
+
 void ExtractMapsFromMpq(uint32 build)
 {
     char mpq_filename[1024];
@@ -1018,10 +1039,10 @@ void ExtractMapsFromMpq(uint32 build)
     path += "/maps/";
     CreateDir(path);
 
-    printf("Convert map files\n");
+    // collect the tiles of all maps first so small maps don't leave threads idle
+    std::vector<MapTileJob> jobs;
     for (uint32 z = 0; z < map_count; ++z)
     {
-        printf("Extract %s (%d/%u)                  \n", map_ids[z].name, z+1, map_count);
         // Loadup map grid data
         sprintf(mpq_map_name, "World\\Maps\\%s\\%s.wdt", map_ids[z].name, map_ids[z].name);
         WDT_file wdt;
@@ -1037,15 +1058,61 @@ void ExtractMapsFromMpq(uint32 build)
 
                 sprintf(mpq_filename, "World\\Maps\\%s\\%s_%u_%u.adt", map_ids[z].name, map_ids[z].name, x, y);
                 sprintf(output_filename, "%s/maps/%04u_%02u_%02u.map", output_path, map_ids[z].id, y, x);
-                ConvertADT(mpq_filename, output_filename, y, x, build);
+                jobs.push_back({ mpq_filename, output_filename, int(y), int(x) });
             }
-
-            // draw progress bar
-            printf("Processing........................%d%%\r", (100 * (y+1)) / WDT_MAP_SIZE);
         }
     }
 
+    uint32 threadCount = CONF_threads ? CONF_threads : std::max(1u, std::thread::hardware_concurrency());
+    printf("Convert %u map tiles of %u maps using %u threads\n", uint32(jobs.size()), map_count, threadCount);
+
+    std::atomic<size_t> nextJob(0);
+    std::atomic<uint32> converted(0);
+    std::atomic<uint32> processed(0);
+    std::atomic<uint64> bytesWritten(0);
+    std::mutex progressLock;
+
+    auto start = std::chrono::steady_clock::now();
+
+    auto worker = [&]()
+    {
+        for (size_t i = nextJob++; i < jobs.size(); i = nextJob++)
+        {
+            MapTileJob& job = jobs[i];
+            if (ConvertADT(&job.MpqFileName[0], &job.OutputFileName[0], job.CellY, job.CellX, build))
+            {
+                ++converted;
+                std::error_code error;
+                uintmax_t size = std::filesystem::file_size(job.OutputFileName, error);
+                if (!error)
+                    bytesWritten += size;
+            }
+
+            uint32 done = ++processed;
+            if (done % 64 == 0 || done == jobs.size())
+            {
+                // draw progress bar
+                std::lock_guard<std::mutex> lock(progressLock);
+                printf("Processing........................%u%%\r", uint32((100 * uint64(done)) / jobs.size()));
+                fflush(stdout);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32 i = 1; i < threadCount; ++i)
+        threads.emplace_back(worker);
+    worker();
+    for (std::thread& thread : threads)
+        thread.join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double mbWritten = double(bytesWritten) / (1024.0 * 1024.0);
     printf("\n");
+    printf("Converted %u of %u tiles in %.2f s (%.1f tiles/s, %.2f MB written, %.2f MB/s)\n",
+        uint32(converted), uint32(jobs.size()), seconds,
+        seconds > 0.0 ? converted / seconds : 0.0, mbWritten, seconds > 0.0 ? mbWritten / seconds : 0.0);
+
     delete [] map_ids;
 }
 
@@ -21,9 +21,13 @@
 
 #include "loadlib.h"
 #include <cstdio>
+#include <mutex>
 
 u_map_fcc MverMagic = { {'R','E','V','M'} };
 
+// StormLib archive handles are not thread safe, only one thread reads from the archives at a time
+static std::mutex MpqReadLock;
+
 FileLoader::FileLoader()
 {
     data = 0;
@@ -39,28 +43,27 @@ FileLoader::~FileLoader()
 bool FileLoader::loadFile(HANDLE mpq, char* filename, bool log)
 {
     free();
-    HANDLE file;
-    if (!SFileOpenFileEx(mpq, filename, SFILE_OPEN_PATCHED_FILE, &file))
-    {
-        if (log)
-            printf("No such file %s\n", filename);
-        return false;
-    }
-
-    data_size = SFileGetFileSize(file, NULL);
-    data = new uint8[data_size];
-    if (data)
     {
-        SFileReadFile(file, data, data_size, NULL/*bytesRead*/, NULL);
-        if (prepareLoadedData())
+        std::lock_guard<std::mutex> lock(MpqReadLock);
+        HANDLE file;
+        if (!SFileOpenFileEx(mpq, filename, SFILE_OPEN_PATCHED_FILE, &file))
         {
-            SFileCloseFile(file);
-            return true;
+            if (log)
+                printf("No such file %s\n", filename);
+            return false;
         }
+
+        data_size = SFileGetFileSize(file, NULL);
+        data = new uint8[data_size];
+        SFileReadFile(file, data, data_size, NULL/*bytesRead*/, NULL);
+        SFileCloseFile(file);
     }
 
+    // parsing runs outside the lock, on the thread converting the file
+    if (prepareLoadedData())
+        return true;
+
     printf("Error loading %s\n", filename);
-    SFileCloseFile(file);
     free();
     return false;
 }
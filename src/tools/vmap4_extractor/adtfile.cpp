@@ -197,6 +197,7 @@ bool ADTFile::init(uint32 map_num, uint32 tileX, uint32 tileY)
         {
             if (size)
             {
+                std::lock_guard<std::mutex> lock(DirFileLock);
                 uint32 doodadCount = size / sizeof(ADT::MDDF);
                 for (uint32 i = 0; i < doodadCount; ++i)
                 {
@@ -204,20 +205,23 @@ bool ADTFile::init(uint32 map_num, uint32 tileX, uint32 tileY)
                     _file.read(&doodadDef, sizeof(ADT::MDDF));
                     Doodad::Extract(doodadDef, ModelInstanceNames[doodadDef.Id].c_str(), map_num, tileX, tileY, dirfile);
                 }
+                fflush(dirfile);
             }
         }
         else if (!strcmp(fourcc,"MODF"))
         {
             if (size)
             {
+                std::lock_guard<std::mutex> lock(DirFileLock);
                 uint32 mapObjectCount = size / sizeof(ADT::MODF);
                 for (uint32 i = 0; i < mapObjectCount; ++i)
                 {
                     ADT::MODF mapObjDef;
                     _file.read(&mapObjDef, sizeof(ADT::MODF));
                     MapObject::Extract(mapObjDef, WmoInstanceNames[mapObjDef.Id].c_str(), map_num, tileX, tileY, dirfile);
-                    Doodad::ExtractSet(WmoDoodads[WmoInstanceNames[mapObjDef.Id]], mapObjDef, map_num, tileX, tileY, dirfile);
+                    Doodad::ExtractSet(GetWmoDoodads(WmoInstanceNames[mapObjDef.Id]), mapObjDef, map_num, tileX, tileY, dirfile);
                 }
+                fflush(dirfile);
             }
         }
 
@@ -48,14 +48,17 @@ bool ExtractSingleModel(std::string& fname)
     output += "/";
     output += name;
 
-    if (FileExists(output.c_str()))
-        return true;
+    return ExtractModelOnce(output, [&]()
+    {
+        if (FileExists(output.c_str()))
+            return true;
 
-    Model mdl(originalName);
-    if (!mdl.open())
-        return false;
+        Model mdl(originalName);
+        if (!mdl.open())
+            return false;
 
-    return mdl.ConvertToVMAPModel(output.c_str());
+        return mdl.ConvertToVMAPModel(output.c_str());
+    });
 }
 
 extern HANDLE LocaleMpq;
@@ -20,14 +20,20 @@
 #include "mpqfile.h"
 #include <deque>
 #include <cstdio>
+#include <mutex>
 #include "StormLib.h"
 
+// StormLib archive handles are not thread safe, files are read one at a time and parsed by the caller in parallel
+static std::mutex MpqReadLock;
+
 MPQFile::MPQFile(HANDLE mpq, const char* filename, bool warnNoExist /*= true*/) :
     eof(false),
     buffer(0),
     pointer(0),
     size(0)
 {
+    std::lock_guard<std::mutex> lock(MpqReadLock);
+
     HANDLE file;
     if (!SFileOpenFileEx(mpq, filename, SFILE_OPEN_PATCHED_FILE, &file))
     {
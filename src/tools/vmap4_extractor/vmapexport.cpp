@@ -22,6 +22,12 @@
 #include <iostream>
 #include <vector>
 #include <list>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <unordered_map>
 #include <errno.h>
 
 #ifdef WIN32
@@ -114,19 +120,59 @@ uint16 *LiqType = 0;
 char output_path[128]=".";
 char input_path[1024]=".";
 bool preciseVectorData = false;
+uint32 threadCount = 0;     // 0 - one per hardware thread
+
+std::mutex WmoDoodadsLock;
 std::unordered_map<std::string, WMODoodadData> WmoDoodads;
 
 // Constants
 
 const char* szWorkDirWmo = "./Buildings";
 
+std::mutex DirFileLock;
+
+std::mutex UniqueObjectIdsLock;
 std::map<std::pair<uint32, uint16>, uint32> uniqueObjectIds;
 
+std::mutex ExtractedModelsLock;
+std::unordered_map<std::string, std::shared_future<bool>> ExtractedModels;
+std::atomic<uint32> ExtractedModelCount(0);
+
+WMODoodadData& GetWmoDoodads(std::string const& wmoName)
+{
+    std::lock_guard<std::mutex> lock(WmoDoodadsLock);
+    return WmoDoodads[wmoName];
+}
+
 uint32 GenerateUniqueObjectId(uint32 clientId, uint16 clientDoodadId)
 {
+    std::lock_guard<std::mutex> lock(UniqueObjectIdsLock);
     return uniqueObjectIds.emplace(std::make_pair(clientId, clientDoodadId), uniqueObjectIds.size() + 1).first->second;
 }
 
+bool ExtractModelOnce(std::string const& outputName, std::function<bool()> const& extract)
+{
+    std::promise<bool> promise;
+    {
+        std::unique_lock<std::mutex> lock(ExtractedModelsLock);
+        auto itr = ExtractedModels.find(outputName);
+        if (itr != ExtractedModels.end())
+        {
+            std::shared_future<bool> result = itr->second;
+            lock.unlock();
+            return result.get();
+        }
+
+        ExtractedModels.emplace(outputName, promise.get_future().share());
+    }
+
+    bool result = extract();
+    if (result)
+        ++ExtractedModelCount;
+    promise.set_value(result);
+    return result;
+}
+
 bool LoadLocaleMPQFile(int locale)
 {
     TCHAR buff[512];
@@ -335,17 +381,8 @@ void ReadLiquidTypeTableDBC()
 //     return success;
 // }
 
-bool ExtractSingleWmo(std::string& fname)
+bool ExtractSingleWmoFile(std::string const& originalName, char const* plain_name, char const* szLocalFile)
 {
-    // Copy files from archive
-    std::string originalName = fname;
-
-    char szLocalFile[1024];
-    char* plain_name = GetPlainName(&fname[0]);
-    fixnamen(plain_name, strlen(plain_name));
-    fixname2(plain_name, strlen(plain_name));    
-    sprintf(szLocalFile, "%s/%s", szWorkDirWmo, plain_name);
-
     if (FileExists(szLocalFile))
         return true;
 
@@ -382,7 +419,7 @@ bool ExtractSingleWmo(std::string& fname)
         return false;
     }
     froot.ConvertToVMAPRootWmo(output);
-    WMODoodadData& doodads = WmoDoodads[plain_name];
+    WMODoodadData& doodads = GetWmoDoodads(plain_name);
     std::swap(doodads, froot.DoodadData);
     int Wmo_nVertices = 0;
     uint32 groupCount = 0;
@@ -392,8 +429,8 @@ bool ExtractSingleWmo(std::string& fname)
         for (uint32 i = 0; i < froot.nGroups; ++i)
         {
             char temp[1024];
-            strncpy(temp, fname.c_str(), 1024);
-            temp[fname.length()-4] = 0;
+            strncpy(temp, originalName.c_str(), 1024);
+            temp[originalName.length()-4] = 0;
 
             WMOGroup fgroup(Trinity::StringFormat("%s_%03u.wmo", temp, i));
             if (!fgroup.open(&froot))
@@ -434,34 +471,90 @@ bool ExtractSingleWmo(std::string& fname)
     return true;
 }
 
+bool ExtractSingleWmo(std::string& fname)
+{
+    // Copy files from archive
+    std::string originalName = fname;
+
+    char szLocalFile[1024];
+    char* plain_name = GetPlainName(&fname[0]);
+    fixnamen(plain_name, strlen(plain_name));
+    fixname2(plain_name, strlen(plain_name));    
+    sprintf(szLocalFile, "%s/%s", szWorkDirWmo, plain_name);
+
+    return ExtractModelOnce(szLocalFile, [&]()
+    {
+        return ExtractSingleWmoFile(originalName, plain_name, szLocalFile);
+    });
+}
+
+struct MapTileJob
+{
+    uint32 MapIndex;
+    int X;
+    int Y;
+};
+
 void ParsMapFiles()
 {
     char fn[512];
-    //char id_filename[64];
+    std::vector<MapTileJob> jobs;
     for (unsigned int i=0; i<map_count; ++i)
     {
+        // global objects of the map are extracted here, before tiles referencing the same models start
         sprintf(fn,"World\\Maps\\%s\\%s.wdt", map_ids[i].name, map_ids[i].name);
         WDTFile WDT(fn,map_ids[i].name);
         if (WDT.init(map_ids[i].id))
         {
-            printf("Processing Map %u\n[", map_ids[i].id);
             for (int x=0; x<64; ++x)
-            {
                 for (int y=0; y<64; ++y)
-                {
-                    if (ADTFile *ADT = WDT.GetMap(x,y))
-                    {
-                        //sprintf(id_filename,"%02u %02u %03u",x,y,map_ids[i].id);//!!!!!!!!!
-                        ADT->init(map_ids[i].id, x, y);
-                        delete ADT;
-                    }
-                }
+                    jobs.push_back({ i, x, y });
+        }
+    }
+
+    uint32 threads = threadCount ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+    printf("Processing %u map tiles using %u threads\n[", uint32(jobs.size()), threads);
+
+    std::atomic<size_t> nextJob(0);
+    std::atomic<uint32> processed(0);
+    std::atomic<uint32> tilesFound(0);
+    std::mutex progressLock;
+
+    auto start = std::chrono::steady_clock::now();
+
+    auto worker = [&]()
+    {
+        for (size_t j = nextJob++; j < jobs.size(); j = nextJob++)
+        {
+            MapTileJob const& job = jobs[j];
+            char adtName[512];
+            sprintf(adtName, "World\\Maps\\%s\\%s_%d_%d_obj0.adt", map_ids[job.MapIndex].name, map_ids[job.MapIndex].name, job.X, job.Y);
+
+            ADTFile ADT(adtName);
+            if (ADT.init(map_ids[job.MapIndex].id, job.X, job.Y))
+                ++tilesFound;
+
+            uint32 done = ++processed;
+            if (done % 4096 == 0)
+            {
+                std::lock_guard<std::mutex> lock(progressLock);
                 printf("#");
                 fflush(stdout);
             }
-            printf("]\n");
         }
-    }
+    };
+
+    std::vector<std::thread> workers;
+    for (uint32 i = 1; i < threads; ++i)
+        workers.emplace_back(worker);
+    worker();
+    for (std::thread& thread : workers)
+        thread.join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("]\n");
+    printf("Processed %u tiles and extracted %u models in %.2f s (%.1f tiles/s)\n",
+        uint32(tilesFound), uint32(ExtractedModelCount), seconds, seconds > 0.0 ? tilesFound / seconds : 0.0);
 }
 
 void getGamePath()
@@ -513,6 +606,11 @@ bool processArgv(int argc, char ** argv, const char *versionString)
             if (i + 1 < argc)                            // all ok
                 CONF_TargetBuild = atoi(argv[i++ + 1]);
         }
+        else if(strcmp("-t",argv[i]) == 0)
+        {
+            if (i + 1 < argc)                            // all ok
+                threadCount = atoi(argv[i++ + 1]);
+        }
         else
         {
             result = false;
@@ -523,11 +621,12 @@ bool processArgv(int argc, char ** argv, const char *versionString)
     if(!result)
     {
         printf("Extract %s.\n",versionString);
-        printf("%s [-?][-s][-l][-d <path>]\n", argv[0]);
+        printf("%s [-?][-s][-l][-d <path>][-t <count>]\n", argv[0]);
         printf("   -s : (default) small size (data size optimization), ~500MB less vmap data.\n");
         printf("   -l : large size, ~500MB more vmap data. (might contain more details)\n");
         printf("   -d <path>: Path to the vector data source folder.\n");
         printf("   -b : target build (default %u)\n", CONF_TargetBuild);
+        printf("   -t <count>: number of threads processing map tiles (default: all cores)\n");
         printf("   -? : This message.\n");
     }
 
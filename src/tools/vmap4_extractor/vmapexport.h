@@ -21,8 +21,9 @@
 #define VMAPEXPORT_H
 
 #include "Define.h"
+#include <functional>
+#include <mutex>
 #include <string>
-#include <unordered_map>
 
 enum ModelFlags
 {
@@ -34,10 +35,14 @@ enum ModelFlags
 struct WMODoodadData;
 
 extern const char * szWorkDirWmo;
-extern std::unordered_map<std::string, WMODoodadData> WmoDoodads;
+extern std::mutex DirFileLock;  // held while a tile appends its records to dir_bin
 
+WMODoodadData& GetWmoDoodads(std::string const& wmoName);
 uint32 GenerateUniqueObjectId(uint32 clientId, uint16 clientDoodadId);
 
+// runs extract only for the first caller of a model name, later callers wait for and share its result
+bool ExtractModelOnce(std::string const& outputName, std::function<bool()> const& extract);
+
 bool FileExists(const char * file);
 void strToLower(char* str);
 
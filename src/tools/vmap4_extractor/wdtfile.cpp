@@ -99,14 +99,16 @@ bool WDTFile::init(uint32 mapId)
             // global wmo instance data
             if (size)
             {
+                std::lock_guard<std::mutex> lock(DirFileLock);
                 uint32 mapObjectCount = size / sizeof(ADT::MODF);
                 for (uint32 i = 0; i < mapObjectCount; ++i)
                 {
                     ADT::MODF mapObjDef;
                     _file.read(&mapObjDef, sizeof(ADT::MODF));                    
                     MapObject::Extract(mapObjDef, _wmoNames[mapObjDef.Id].c_str(), mapId, 65, 65, dirfile);
-                    Doodad::ExtractSet(WmoDoodads[_wmoNames[mapObjDef.Id]], mapObjDef, mapId, 65, 65, dirfile);
+                    Doodad::ExtractSet(GetWmoDoodads(_wmoNames[mapObjDef.Id]), mapObjDef, mapId, 65, 65, dirfile);
                 }
+                fflush(dirfile);
             }
         }
         _file.seek((int)nextpos);